@@ -40,6 +40,12 @@ UFlareResourceCatalog::UFlareResourceCatalog(const class FObjectInitializer& PCI
 	Resources.Sort(SortByResourceType);
 	ConsumerResources.Sort(SortByResourceType);
 	MaintenanceResources.Sort(SortByResourceType);
+
+	// Dense resource index, used to store per-resource data in flat arrays
+	for (int32 Index = 0; Index < Resources.Num(); Index++)
+	{
+		Resources[Index]->Data.Index = Index;
+	}
 }
 
 
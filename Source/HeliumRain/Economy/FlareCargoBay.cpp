@@ -7,6 +7,7 @@
 #include "../Data/FlareResourceCatalog.h"
 
 #include "../Game/FlareGame.h"
+#include "../Game/FlareSimulatedSector.h"
 #include "../Quests/FlareQuestManager.h"
 
 #include "../Spacecrafts/FlareSimulatedSpacecraft.h"
@@ -110,6 +111,8 @@ void UFlareCargoBay::Load(UFlareSimulatedSpacecraft* ParentSpacecraft, TArray<FF
 
 		CargoBay.Add(Cargo);
 	}
+
+	RebuildSummaries();
 }
 
 
@@ -153,32 +156,12 @@ TArray<FFlareCargoSave>* UFlareCargoBay::Save()
 
 bool UFlareCargoBay::HasResources(FFlareResourceDescription* Resource, int32 Quantity, UFlareCompany* Client)
 {
-	int32 PresentQuantity = 0;
-
 	if (Quantity == 0)
 	{
 		return true;
 	}
 
-	for (int CargoIndex = 0; CargoIndex < CargoBay.Num() ; CargoIndex++)
-	{
-		FFlareCargo* Cargo = &CargoBay[CargoIndex];
-
-		if(!CheckRestriction(Cargo, Client))
-		{
-			continue;
-		}
-
-		if (Cargo->Resource == Resource)
-		{
-			PresentQuantity += Cargo->Quantity;
-			if (PresentQuantity >= Quantity)
-			{
-				return true;
-			}
-		}
-	}
-	return false;
+	return GetSummary(Resource, Client).Quantity >= Quantity;
 }
 
 int32 UFlareCargoBay::TakeResources(FFlareResourceDescription* Resource, int32 Quantity, UFlareCompany* Client)
@@ -191,6 +174,8 @@ int32 UFlareCargoBay::TakeResources(FFlareResourceDescription* Resource, int32 Q
 		return 0;
 	}
 
+	InvalidateSectorResourceStats();
+
 	// First pass: take resource from the less full cargo
 	int32 MinQuantity = 0;
 	FFlareCargo* MinQuantityCargo = NULL;
@@ -218,6 +203,7 @@ int32 UFlareCargoBay::TakeResources(FFlareResourceDescription* Resource, int32 Q
 		int32 TakenQuantity = FMath::Min(MinQuantityCargo->Quantity, QuantityToTake);
 		if (TakenQuantity > 0)
 		{
+			UpdateSummary(*MinQuantityCargo, -1);
 			MinQuantityCargo->Quantity -= TakenQuantity;
 			QuantityToTake -= TakenQuantity;
 
@@ -225,6 +211,7 @@ int32 UFlareCargoBay::TakeResources(FFlareResourceDescription* Resource, int32 Q
 			{
 				MinQuantityCargo->Resource = NULL;
 			}
+			UpdateSummary(*MinQuantityCargo, 1);
 
 			if (QuantityToTake == 0)
 			{
@@ -247,6 +234,7 @@ int32 UFlareCargoBay::TakeResources(FFlareResourceDescription* Resource, int32 Q
 			int32 TakenQuantity = FMath::Min(Cargo.Quantity, QuantityToTake);
 			if (TakenQuantity > 0)
 			{
+				UpdateSummary(Cargo, -1);
 				Cargo.Quantity -= TakenQuantity;
 				QuantityToTake -= TakenQuantity;
 
@@ -254,6 +242,7 @@ int32 UFlareCargoBay::TakeResources(FFlareResourceDescription* Resource, int32 Q
 				{
 					Cargo.Resource = NULL;
 				}
+				UpdateSummary(Cargo, 1);
 
 				if (QuantityToTake == 0)
 				{
@@ -267,11 +256,15 @@ int32 UFlareCargoBay::TakeResources(FFlareResourceDescription* Resource, int32 Q
 
 void UFlareCargoBay::DumpCargo(FFlareCargo* Cargo)
 {
+	InvalidateSectorResourceStats();
+
+	UpdateSummary(*Cargo, -1);
 	Cargo->Quantity = 0;
 	if (Cargo->Lock == EFlareResourceLock::NoLock)
 	{
 		Cargo->Resource = NULL;
 	}
+	UpdateSummary(*Cargo, 1);
 }
 
 int32 UFlareCargoBay::GiveResources(FFlareResourceDescription* Resource, int32 Quantity, UFlareCompany* Client)
@@ -283,6 +276,8 @@ int32 UFlareCargoBay::GiveResources(FFlareResourceDescription* Resource, int32 Q
 		return Quantity;
 	}
 
+	InvalidateSectorResourceStats();
+
 	// First pass, fill already existing slots
 	for (int CargoIndex = 0 ; CargoIndex < CargoBay.Num() ; CargoIndex++)
 	{
@@ -299,7 +294,9 @@ int32 UFlareCargoBay::GiveResources(FFlareResourceDescription* Resource, int32 Q
 			int32 GivenQuantity = FMath::Min(AvailableCapacity, QuantityToGive);
 			if (GivenQuantity > 0)
 			{
+				UpdateSummary(Cargo, -1);
 				Cargo.Quantity += GivenQuantity;
+				UpdateSummary(Cargo, 1);
 				QuantityToGive -= GivenQuantity;
 
 				if (QuantityToGive == 0)
@@ -325,8 +322,10 @@ int32 UFlareCargoBay::GiveResources(FFlareResourceDescription* Resource, int32 Q
 			int32 GivenQuantity = FMath::Min(GetSlotCapacity(), QuantityToGive);
 			if (GivenQuantity > 0)
 			{
+				UpdateSummary(Cargo, -1);
 				Cargo.Quantity += GivenQuantity;
 				Cargo.Resource = Resource;
+				UpdateSummary(Cargo, 1);
 
 				QuantityToGive -= GivenQuantity;
 
@@ -394,23 +393,7 @@ int32 UFlareCargoBay::GetFreeCargoSpace() const
 
 int32 UFlareCargoBay::GetResourceQuantity(FFlareResourceDescription* Resource, UFlareCompany* Client) const
 {
-	int32 Quantity = 0;
-
-	for (int CargoIndex = 0; CargoIndex < CargoBay.Num() ; CargoIndex++)
-	{
-
-
-		const FFlareCargo& Cargo = CargoBay[CargoIndex];
-		if (Cargo.Resource == Resource)
-		{
-			if(!CheckRestriction(&Cargo, Client))
-			{
-				continue;
-			}
-
-			Quantity += Cargo.Quantity;
-		}
-	}
+	int32 Quantity = GetSummary(Resource, Client).Quantity;
 
 	if((Client && !Client->IsPlayerCompany())  && Parent->GetGame()->GetQuestManager() != nullptr)
 	{
@@ -422,38 +405,21 @@ int32 UFlareCargoBay::GetResourceQuantity(FFlareResourceDescription* Resource, U
 	{
 		return Quantity;
 	}
-
-
 }
 
 int32 UFlareCargoBay::GetFreeSpaceForResource(FFlareResourceDescription* Resource, UFlareCompany* Client, bool LockOnly) const
 {
-	int32 Quantity = 0;
+	FFlareCargoSummary Summary = GetSummary(Resource, Client);
+	int32 Quantity;
 
-	for (int CargoIndex = 0; CargoIndex < CargoBay.Num() ; CargoIndex++)
+	if (LockOnly)
 	{
-		const FFlareCargo& Cargo = CargoBay[CargoIndex];
-
-		if(!CheckRestriction(&Cargo, Client))
-		{
-			continue;
-		}
-
-		if(LockOnly && Cargo.Lock == EFlareResourceLock::NoLock)
-		{
-			continue;
-		}
-
-		if (Cargo.Resource == NULL)
-		{
-			Quantity += GetSlotCapacity();
-		}
-		else if (Cargo.Resource == Resource)
-		{
-			Quantity += GetSlotCapacity() - Cargo.Quantity;
-		}
+		Quantity = Summary.LockedSlotCount * GetSlotCapacity() - Summary.LockedQuantity;
+	}
+	else
+	{
+		Quantity = Summary.SlotCount * GetSlotCapacity() - Summary.Quantity;
 	}
-
 
 	if((!Client || !Client->IsPlayerCompany()) && Parent->GetGame()->GetQuestManager() != nullptr)
 	{
@@ -470,33 +436,8 @@ int32 UFlareCargoBay::GetFreeSpaceForResource(FFlareResourceDescription* Resourc
 
 int32 UFlareCargoBay::GetTotalCapacityForResource(FFlareResourceDescription* Resource, UFlareCompany* Client, bool LockOnly) const
 {
-	int32 Quantity = 0;
-
-	for (int CargoIndex = 0; CargoIndex < CargoBay.Num() ; CargoIndex++)
-	{
-		const FFlareCargo& Cargo = CargoBay[CargoIndex];
-
-		if(!CheckRestriction(&Cargo, Client))
-		{
-			continue;
-		}
-
-		if(LockOnly && Cargo.Lock == EFlareResourceLock::NoLock)
-		{
-			continue;
-		}
-
-		if(Cargo.Lock != EFlareResourceLock::NoLock)
-		{
-
-		}
-
-		if (Cargo.Resource == NULL || Cargo.Resource == Resource)
-		{
-			Quantity += GetSlotCapacity();
-		}
-	}
-	return Quantity;
+	FFlareCargoSummary Summary = GetSummary(Resource, Client);
+	return (LockOnly ? Summary.LockedSlotCount : Summary.SlotCount) * GetSlotCapacity();
 }
 
 
@@ -535,6 +476,8 @@ bool UFlareCargoBay::LockSlot(FFlareResourceDescription* Resource, EFlareResourc
 		return false;
 	}
 
+	InvalidateSectorResourceStats();
+
 	//Check double lock
 	for(FFlareCargo& Cargo : CargoBay)
 	{
@@ -550,8 +493,10 @@ bool UFlareCargoBay::LockSlot(FFlareResourceDescription* Resource, EFlareResourc
 	{
 		if (Cargo.Resource == Resource)
 		{
+			UpdateSummary(Cargo, -1);
 			Cargo.Lock = LockType;
 			Cargo.ManualLock = ManualLock;
+			UpdateSummary(Cargo, 1);
 			return true;
 		}
 	}
@@ -561,10 +506,12 @@ bool UFlareCargoBay::LockSlot(FFlareResourceDescription* Resource, EFlareResourc
 	{
 		if (Cargo.Resource == NULL)
 		{
+			UpdateSummary(Cargo, -1);
 			Cargo.Lock = LockType;
 			Cargo.ManualLock = ManualLock;
 			Cargo.Resource = Resource;
 			Cargo.Quantity = 0;
+			UpdateSummary(Cargo, 1);
 			return true;
 		}
 	}
@@ -578,14 +525,18 @@ void UFlareCargoBay::HideUnlockedSlots()
 	{
 		if(Cargo.Lock == EFlareResourceLock::NoLock)
 		{
+			UpdateSummary(Cargo, -1);
 			Cargo.Lock = EFlareResourceLock::Hidden;
 			Cargo.ManualLock = false;
+			UpdateSummary(Cargo, 1);
 		}
 	}
 }
 
 void UFlareCargoBay::UnlockAll(bool IgnoreManualLock)
 {
+	InvalidateSectorResourceStats();
+
 	for (int CargoIndex = 0; CargoIndex < CargoBay.Num() ; CargoIndex++)
 	{
 		FFlareCargo& Cargo = CargoBay[CargoIndex];
@@ -597,6 +548,7 @@ void UFlareCargoBay::UnlockAll(bool IgnoreManualLock)
 				continue;
 			}
 
+			UpdateSummary(Cargo, -1);
 			Cargo.Lock = EFlareResourceLock::NoLock;
 			Cargo.ManualLock = false;
 
@@ -604,6 +556,7 @@ void UFlareCargoBay::UnlockAll(bool IgnoreManualLock)
 			{
 				Cargo.Resource = NULL;
 			}
+			UpdateSummary(Cargo, 1);
 		}
 	}
 }
@@ -614,63 +567,107 @@ void UFlareCargoBay::SetSlotRestriction(int32 SlotIndex, EFlareResourceRestricti
 	{
 		FLOGV("Invalid index %d for set slot restriction (cargo bay size: %d)", SlotIndex, CargoBay.Num());
 	}
+	UpdateSummary(CargoBay[SlotIndex], -1);
 	CargoBay[SlotIndex].Restriction = RestrictionType;
+	UpdateSummary(CargoBay[SlotIndex], 1);
 }
 
-bool UFlareCargoBay::WantSell(FFlareResourceDescription* Resource, UFlareCompany* Client, bool RequireStock) const
+void UFlareCargoBay::InvalidateSectorResourceStats()
 {
-	for (int CargoIndex = 0; CargoIndex < CargoBay.Num() ; CargoIndex++)
+	if (Parent->GetCurrentSector())
 	{
-		const FFlareCargo& Cargo = CargoBay[CargoIndex];
-		if (Cargo.Resource != NULL && Cargo.Resource != Resource)
-		{
-			continue;
-		}
+		Parent->GetCurrentSector()->InvalidateResourceStats();
+	}
+}
+
+void UFlareCargoBay::UpdateSummary(const FFlareCargo& Cargo, int32 Sign)
+{
+	if (Cargo.Restriction == EFlareResourceRestriction::Nobody)
+	{
+		return;
+	}
 
-		if (!CheckRestriction(&Cargo, Client))
+	int32 SummaryIndex = Cargo.Resource ? Cargo.Resource->Index : Summaries[0].Num() - 1;
+	bool Locked = (Cargo.Lock != EFlareResourceLock::NoLock);
+	bool Sell = (Cargo.Lock == EFlareResourceLock::NoLock || Cargo.Lock == EFlareResourceLock::Output || Cargo.Lock == EFlareResourceLock::Trade);
+	bool Buy = (Cargo.Lock == EFlareResourceLock::NoLock || Cargo.Lock == EFlareResourceLock::Input || Cargo.Lock == EFlareResourceLock::Trade);
+
+	// Slots open to everybody are seen by the owner too
+	int32 FirstClient = (Cargo.Restriction == EFlareResourceRestriction::OwnerOnly) ? 1 : 0;
+	for (int32 ClientIndex = FirstClient; ClientIndex < 2; ClientIndex++)
+	{
+		FFlareCargoSummary& Summary = Summaries[ClientIndex][SummaryIndex];
+
+		Summary.Quantity += Sign * Cargo.Quantity;
+		Summary.SlotCount += Sign;
+
+		if (Locked)
 		{
-			continue;
+			Summary.LockedQuantity += Sign * Cargo.Quantity;
+			Summary.LockedSlotCount += Sign;
 		}
 
-		if (RequireStock && Cargo.Quantity == 0)
+		if (Sell)
 		{
-			continue;
+			Summary.SellSlotCount += Sign;
+			if (Cargo.Quantity > 0)
+			{
+				Summary.SellStockSlotCount += Sign;
+			}
 		}
 
-		if (Cargo.Lock == EFlareResourceLock::NoLock ||
-				Cargo.Lock == EFlareResourceLock::Output ||
-				Cargo.Lock == EFlareResourceLock::Trade)
+		if (Buy)
 		{
-			return true;
+			Summary.BuySlotCount += Sign;
 		}
 	}
-
-	return false;
 }
 
-bool UFlareCargoBay::WantBuy(FFlareResourceDescription* Resource, UFlareCompany* Client) const
+void UFlareCargoBay::RebuildSummaries()
 {
-	for (int CargoIndex = 0; CargoIndex < CargoBay.Num() ; CargoIndex++)
+	int32 SummaryCount = Game->GetResourceCatalog()->Resources.Num() + 1;
+
+	for (int32 ClientIndex = 0; ClientIndex < 2; ClientIndex++)
 	{
-		const FFlareCargo& Cargo = CargoBay[CargoIndex];
-		if(Cargo.Resource != NULL && Cargo.Resource != Resource)
-		{
-			continue;
-		}
+		Summaries[ClientIndex].Reset(SummaryCount);
+		Summaries[ClientIndex].SetNum(SummaryCount);
+	}
 
-		if(!CheckRestriction(&Cargo, Client))
-		{
-			continue;
-		}
+	for (const FFlareCargo& Cargo : CargoBay)
+	{
+		UpdateSummary(Cargo, 1);
+	}
+}
 
-		if(Cargo.Lock == EFlareResourceLock::NoLock ||
-				Cargo.Lock == EFlareResourceLock::Input||
-				Cargo.Lock == EFlareResourceLock::Trade)
-		{
-			return true;
-		}
+FFlareCargoSummary UFlareCargoBay::GetSummary(FFlareResourceDescription* Resource, UFlareCompany* Client) const
+{
+	const TArray<FFlareCargoSummary>& ClientSummaries = Summaries[(Client == Parent->GetCompany()) ? 1 : 0];
+	FFlareCargoSummary Summary = ClientSummaries.Last();
+
+	if (Resource)
+	{
+		const FFlareCargoSummary& ResourceSummary = ClientSummaries[Resource->Index];
+		Summary.Quantity += ResourceSummary.Quantity;
+		Summary.SlotCount += ResourceSummary.SlotCount;
+		Summary.LockedQuantity += ResourceSummary.LockedQuantity;
+		Summary.LockedSlotCount += ResourceSummary.LockedSlotCount;
+		Summary.SellSlotCount += ResourceSummary.SellSlotCount;
+		Summary.SellStockSlotCount += ResourceSummary.SellStockSlotCount;
+		Summary.BuySlotCount += ResourceSummary.BuySlotCount;
 	}
-	return false;
+
+	return Summary;
+}
+
+bool UFlareCargoBay::WantSell(FFlareResourceDescription* Resource, UFlareCompany* Client, bool RequireStock) const
+{
+	FFlareCargoSummary Summary = GetSummary(Resource, Client);
+	return (RequireStock ? Summary.SellStockSlotCount : Summary.SellSlotCount) > 0;
+}
+
+bool UFlareCargoBay::WantBuy(FFlareResourceDescription* Resource, UFlareCompany* Client) const
+{
+	return GetSummary(Resource, Client).BuySlotCount > 0;
 }
 
 bool UFlareCargoBay::CheckRestriction(const FFlareCargo* Cargo, UFlareCompany* Client) const
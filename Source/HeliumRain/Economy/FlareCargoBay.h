@@ -16,6 +16,33 @@ struct FSortableCargoInfo
 	int32           CargoInitialIndex;
 };
 
+/** Slots of a cargo bay that hold a resource, or that are empty, as seen by a client */
+struct FFlareCargoSummary
+{
+	int32           Quantity;
+	int32           SlotCount;
+	int32           LockedQuantity;
+	int32           LockedSlotCount;
+
+	/** Slots that can be sold from, and those that also have stock */
+	int32           SellSlotCount;
+	int32           SellStockSlotCount;
+
+	/** Slots that can be bought into */
+	int32           BuySlotCount;
+
+	FFlareCargoSummary()
+		: Quantity(0)
+		, SlotCount(0)
+		, LockedQuantity(0)
+		, LockedSlotCount(0)
+		, SellSlotCount(0)
+		, SellStockSlotCount(0)
+		, BuySlotCount(0)
+	{
+	}
+};
+
 
 UCLASS()
 class HELIUMRAIN_API UFlareCargoBay : public UObject
@@ -60,6 +87,18 @@ public:
 
 protected:
 
+	/** The cargo changed, the resource stats of the sector are outdated */
+	void InvalidateSectorResourceStats();
+
+	/** Add a slot to the summaries, or remove it with a negative sign. Called around every slot change */
+	void UpdateSummary(const FFlareCargo& Cargo, int32 Sign);
+
+	/** Fill the summaries from the slots */
+	void RebuildSummaries();
+
+	/** Get the summary of the slots a client can use for a resource : slots holding it and empty slots */
+	FFlareCargoSummary GetSummary(FFlareResourceDescription* Resource, UFlareCompany* Client) const;
+
 	/*----------------------------------------------------
 	   Protected data
 	----------------------------------------------------*/
@@ -75,6 +114,9 @@ protected:
 	int32								       CargoBaySlotCapacity;
 	AFlareGame*                                Game;
 
+	/** Slot summaries by resource index, the empty slots are last. Other companies use the first array, the owner the second */
+	TArray<FFlareCargoSummary>                 Summaries[2];
+
 
 public:
 
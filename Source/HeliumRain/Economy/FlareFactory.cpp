@@ -153,6 +153,7 @@ void UFlareFactory::Start()
 	}
 
 	FactoryData.Active = true;
+	InvalidateSectorResourceStats();
 }
 
 void UFlareFactory::StartShipBuilding(FFlareShipyardOrderSave& Order)
@@ -172,6 +173,7 @@ void UFlareFactory::StartShipBuilding(FFlareShipyardOrderSave& Order)
 void UFlareFactory::Pause()
 {
 	FactoryData.Active = false;
+	InvalidateSectorResourceStats();
 }
 
 void UFlareFactory::Stop()
@@ -183,11 +185,13 @@ void UFlareFactory::Stop()
 void UFlareFactory::SetInfiniteCycle(bool Mode)
 {
 	FactoryData.InfiniteCycle = Mode;
+	InvalidateSectorResourceStats();
 }
 
 void UFlareFactory::SetCycleCount(uint32 Count)
 {
 	FactoryData.CycleCount = Count;
+	InvalidateSectorResourceStats();
 }
 
 void UFlareFactory::SetOutputLimit(FFlareResourceDescription* Resource, uint32 MaxSlot)
@@ -445,6 +449,8 @@ void UFlareFactory::CancelProduction()
 		FactoryData.Active = false;
 		Parent->UpdateShipyardProduction();
 	}
+
+	InvalidateSectorResourceStats();
 }
 
 void UFlareFactory::DoProduction()
@@ -652,6 +658,14 @@ TArray<UFlareSimulatedSector*> UFlareFactory::GetTelescopeTargetList()
 	return Candidates;
 }
 
+void UFlareFactory::InvalidateSectorResourceStats()
+{
+	if (Parent->GetCurrentSector())
+	{
+		Parent->GetCurrentSector()->InvalidateResourceStats();
+	}
+}
+
 void UFlareFactory::NotifyNoMoreSector()
 {
 
@@ -83,6 +83,9 @@ public:
 
 protected:
 
+	/** The production state changed, the resource stats of the sector are outdated */
+	void InvalidateSectorResourceStats();
+
 	/*----------------------------------------------------
 	   Protected data
 	----------------------------------------------------*/
@@ -53,6 +53,9 @@ struct FFlareResourceDescription
 	/** Display sorting index */
 	UPROPERTY(EditAnywhere, Category = Content)
 	float DisplayIndex;
+
+	/** Dense index in the resource catalog, set when the catalog is loaded */
+	int32 Index = INDEX_NONE;
 };
 
 /** Spacecraft cargo data */
@@ -13,6 +13,7 @@ DECLARE_LOG_CATEGORY_EXTERN(LogFlare, Log, All);
 #define FLOGV(Format, ...)  UE_LOG(LogFlare, Display, TEXT(Format), __VA_ARGS__)
 
 DECLARE_STATS_GROUP(TEXT("HeliumRain"), STATGROUP_Flare, STATCAT_Advanced);
+DECLARE_STATS_GROUP(TEXT("HeliumRain Simulation"), STATGROUP_FlareSimulation, STATCAT_Advanced);
 
 
 /*----------------------------------------------------
@@ -1,6 +1,7 @@
 #include "FlareAITradeHelper.h"
 
 #include "../FlareGame.h"
+#include "../FlareGameTools.h"
 #include "../FlareCompany.h"
 #include "../FlareSectorHelper.h"
 #include "../FlareScenarioTools.h"
@@ -25,6 +26,8 @@ DECLARE_CYCLE_STAT(TEXT("AITradeHelper FindBestDealForShip"), STAT_AITradeHelper
 DECLARE_CYCLE_STAT(TEXT("AITradeHelper FindBestDealForShip Sectors"), STAT_AITradeHelper_FindBestDealForShip_Sectors, STATGROUP_Flare);
 DECLARE_CYCLE_STAT(TEXT("AITradeHelper FindBestDealForShip Loop"), STAT_AITradeHelper_FindBestDealForShip_Loop, STATGROUP_Flare);
 DECLARE_CYCLE_STAT(TEXT("AITradeHelper ApplyDeal"), STAT_AITradeHelper_ApplyDeal, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("AITradeHelper ComputeGlobalTrading"), STAT_AITradeHelper_ComputeGlobalTrading, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("AITradeHelper ComputeCompaniesResourceVariation"), STAT_AITradeHelper_ComputeCompaniesResourceVariation, STATGROUP_Flare);
 
 
 
@@ -347,8 +350,8 @@ SectorDeal AITradeHelper::FindBestDealForShipToSector(UFlareSimulatedSpacecraft*
 	for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
 	{
 		FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-		struct ResourceVariation const* VariationA = &SectorVariationA->ResourceVariations[Resource];
-		struct ResourceVariation const* VariationB = &SectorVariationB->ResourceVariations[Resource];
+		struct ResourceVariation const* VariationA = &SectorVariationA->ResourceVariations[Resource->Index];
+		struct ResourceVariation const* VariationB = &SectorVariationB->ResourceVariations[Resource->Index];
 
 		//FLOGV("- Check for %s", *Resource->Name.ToString());
 
@@ -718,7 +721,7 @@ SectorDeal AITradeHelper::FindBestDealForShip(UFlareSimulatedSpacecraft* Ship, T
 				int32 UsedIncomingCapacity = FMath::Min(SectorBestDeal.BuyQuantity, SectorVariationA->IncomingCapacity);
 
 				SectorVariationA->IncomingCapacity -= UsedIncomingCapacity;
-				struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[SectorBestDeal.Resource];
+				struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[SectorBestDeal.Resource->Index];
 				VariationA->OwnedStock -= UsedIncomingCapacity;
 			}
 			else
@@ -850,7 +853,7 @@ void AITradeHelper::ApplyDeal(UFlareSimulatedSpacecraft* Ship, SectorDeal const&
 				{
 					// Virtualy decrease the stock for other ships in sector A
 					SectorVariation* SectorVariationA = &(*WorldResourceVariation)[Deal.SectorA];
-					struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[Deal.Resource];
+					struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[Deal.Resource->Index];
 					VariationA->OwnedStock -= BroughtResource;
 
 
@@ -859,14 +862,14 @@ void AITradeHelper::ApplyDeal(UFlareSimulatedSpacecraft* Ship, SectorDeal const&
 					SectorVariationB->IncomingCapacity += BroughtResource;
 
 					// Virtualy decrease the capacity for other ships in sector B
-					struct ResourceVariation* VariationB = &SectorVariationB->ResourceVariations[Deal.Resource];
+					struct ResourceVariation* VariationB = &SectorVariationB->ResourceVariations[Deal.Resource->Index];
 					VariationB->OwnedCapacity -= BroughtResource;
 				}
 				else if (BroughtResource == 0)
 				{
 					// Failed to buy the promised resources, remove the deal from the list
 					SectorVariation* SectorVariationA = &(*WorldResourceVariation)[Deal.SectorA];
-					struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[Deal.Resource];
+					struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[Deal.Resource->Index];
 					VariationA->FactoryStock = 0;
 					VariationA->OwnedStock = 0;
 					VariationA->StorageStock = 0;
@@ -913,14 +916,14 @@ void AITradeHelper::ApplyDeal(UFlareSimulatedSpacecraft* Ship, SectorDeal const&
 		{
 			// Reserve the deal by virtualy decrease the stock for other ships
 			SectorVariation* SectorVariationA = &(*WorldResourceVariation)[Deal.SectorA];
-			struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[Deal.Resource];
+			struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[Deal.Resource->Index];
 			VariationA->OwnedStock -= Deal.BuyQuantity;
 			// Virtualy say some capacity arrive in sector B
 			SectorVariation* SectorVariationB = &(*WorldResourceVariation)[Deal.SectorB];
 			SectorVariationB->IncomingCapacity += Deal.BuyQuantity;
 
 			// Virtualy decrease the capacity for other ships in sector B
-			struct ResourceVariation* VariationB = &SectorVariationB->ResourceVariations[Deal.Resource];
+			struct ResourceVariation* VariationB = &SectorVariationB->ResourceVariations[Deal.Resource->Index];
 			VariationB->OwnedCapacity -= Deal.BuyQuantity;
 		}
 	}
@@ -986,6 +989,33 @@ void AITradeHelper::ApplyDeal(UFlareSimulatedSpacecraft* Ship, SectorDeal const&
 	}
 }
 
+void AITradeHelper::ComputeCompaniesResourceVariation(UFlareWorld* World, TArray<TArray<SectorVariation>>& OutVariations)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AITradeHelper_ComputeCompaniesResourceVariation);
+
+	const TArray<UFlareCompany*>& Companies = World->GetCompanies();
+	UFlareCompany* PlayerCompany = World->GetGame()->GetPC()->GetCompany();
+
+	OutVariations.Reset(World->GetSectors().Num());
+	OutVariations.SetNum(World->GetSectors().Num());
+
+	// Factories, cargo bays, prices and battle counters cache their state : a sector is only read by one worker
+	World->ForEachSector(0, [&](UFlareSimulatedSector* Sector, int32 SectorIndex, const FRandomStream& RandomStream)
+	{
+		TArray<SectorVariation>& SectorVariations = OutVariations[SectorIndex];
+		SectorVariations.SetNum(Companies.Num());
+
+		for (int32 CompanyIndex = 0; CompanyIndex < Companies.Num(); CompanyIndex++)
+		{
+			UFlareCompany* Company = Companies[CompanyIndex];
+			if (Company != PlayerCompany && Company->IsKnownSector(Sector))
+			{
+				SectorVariations[CompanyIndex] = ComputeSectorResourceVariation(Company, Sector, true);
+			}
+		}
+	});
+}
+
 SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Company, UFlareSimulatedSector* Sector, bool AllowUseNoTradeForMe)
 {
 	AFlareGame* Game = Company->GetGame();
@@ -1003,29 +1033,9 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 				}
 #endif
 
+	// One contiguous, zeroed entry per resource of the catalog
 	SectorVariation SectorVariation;
-	for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
-	{
-		FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-		struct ResourceVariation ResourceVariation;
-		ResourceVariation.OwnedFlow = 0;
-		ResourceVariation.FactoryFlow = 0;
-		ResourceVariation.OwnedStock = 0;
-		ResourceVariation.FactoryStock = 0;
-		ResourceVariation.StorageStock = 0;
-		ResourceVariation.ProviderCount = 0;
-		ResourceVariation.OwnedCapacity = 0;
-		ResourceVariation.FactoryCapacity = 0;
-		ResourceVariation.StorageCapacity = 0;
-		ResourceVariation.MaintenanceCapacity = 0;
-		ResourceVariation.IncomingResources = 0;
-		ResourceVariation.MinCapacity = 0;
-		ResourceVariation.ConsumerMaxStock = 0;
-		ResourceVariation.MaintenanceMaxStock = 0;
-		ResourceVariation.HighPriority = 0;
-
-		SectorVariation.ResourceVariations.Add(Resource, ResourceVariation);
-	}
+	SectorVariation.ResourceVariations.SetNumZeroed(Game->GetResourceCatalog()->Resources.Num());
 
 	int32 OwnedCustomerStation = 0;
 	int32 NotOwnedCustomerStation = 0;
@@ -1053,7 +1063,7 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 		for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
 		{
 			FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-			struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
+			struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource->Index];
 
 			int32 Stock = 0;
 			int32 Capacity = 0;
@@ -1154,7 +1164,7 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 			for (int32 ResourceIndex = 0; ResourceIndex < Factory->GetInputResourcesCount(); ResourceIndex++)
 			{
 				FFlareResourceDescription* Resource = Factory->GetInputResource(ResourceIndex);
-				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
+				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource->Index];
 
 				int64 ProductionDuration = Factory->GetProductionDuration();
 				if (ProductionDuration == 0)
@@ -1195,7 +1205,7 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 			for (int32 ResourceIndex = 0; ResourceIndex < Factory->GetOutputResourcesCount(); ResourceIndex++)
 			{
 				FFlareResourceDescription* Resource = Factory->GetOutputResource(ResourceIndex);
-				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
+				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource->Index];
 
 				int64 ProductionDuration = Factory->GetProductionDuration();
 				if (ProductionDuration == 0)
@@ -1242,7 +1252,7 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 			for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->ConsumerResources.Num(); ResourceIndex++)
 			{
 				FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->ConsumerResources[ResourceIndex]->Data;
-				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
+				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource->Index];
 
 				Variation->ConsumerMaxStock += Station->GetActiveCargoBay()->GetSlotCapacity();
 			}
@@ -1254,7 +1264,7 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 			for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->MaintenanceResources.Num(); ResourceIndex++)
 			{
 				FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->MaintenanceResources[ResourceIndex]->Data;
-				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
+				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource->Index];
 
 
 				Variation->MaintenanceMaxStock += Station->GetActiveCargoBay()->GetSlotCapacity();
@@ -1267,7 +1277,7 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 			for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
 			{
 				FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
+				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource->Index];
 
 				int32 ResourceQuantity = Station->GetActiveCargoBay()->GetResourceQuantity(Resource, ClientCompany);
 				int32 MaxCapacity = Station->GetActiveCargoBay()->GetFreeSpaceForResource(Resource, ClientCompany);
@@ -1305,7 +1315,7 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 		for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->ConsumerResources.Num(); ResourceIndex++)
 		{
 			FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->ConsumerResources[ResourceIndex]->Data;
-			struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
+			struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource->Index];
 
 
 			int32 Consumption = Sector->GetPeople()->GetRessourceConsumption(Resource, false);
@@ -1354,7 +1364,7 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 				{
 					continue;
 				}
-				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Cargo.Resource];
+				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Cargo.Resource->Index];
 
 				Variation->IncomingResources += Cargo.Quantity / (RemainingTravelDuration * 0.5);
 			}
@@ -1365,7 +1375,7 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 	for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->MaintenanceResources.Num(); ResourceIndex++)
 	{
 		FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->MaintenanceResources[ResourceIndex]->Data;
-		struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
+		struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource->Index];
 
 		for (int CompanyIndex = 0; CompanyIndex < Game->GetGameWorld()->GetCompanies().Num(); CompanyIndex++)
 		{
@@ -1435,6 +1445,18 @@ inline static bool NeedComparatorComparator(const AITradeNeed& n1, const AITrade
 	}
 }
 
+inline static bool NeedHeapComparator(const AITradeNeed& n1, const AITradeNeed& n2)
+{
+	if(n1.Round == n2.Round)
+	{
+		return NeedComparatorComparator(n1, n2);
+	}
+	else
+	{
+		return n1.Round < n2.Round;
+	}
+}
+
 
 // New trading
 void AITradeHelper::GenerateTradingNeeds(AITradeNeeds& Needs, AITradeNeeds& MaintenanceNeeds, AITradeNeeds& StorageNeeds, UFlareWorld* World)
@@ -1689,23 +1711,52 @@ void AITradeHelper::GenerateIdleShips(AITradeIdleShips& Ships, UFlareWorld* Worl
 
 void AITradeHelper::ComputeGlobalTrading(UFlareWorld* World, AITradeNeeds& Needs, AITradeSources& Sources, AITradeSources& MaintenanceSources, AITradeIdleShips& IdleShips, AICompaniesMoney& CompaniesMoney)
 {
-	while(Needs.List.Num() > 0)
-	{
-		Needs.List.Sort(&NeedComparatorComparator);
-
-		TArray<AITradeNeed> KeepList;
+	SCOPE_CYCLE_COUNTER(STAT_AITradeHelper_ComputeGlobalTrading);
 
-		for(AITradeNeed& Need : Needs.List)
+	// Former loop, kept to compare the costs
+	if (!UFlareGameTools::GlobalTradingHeap)
+	{
+		while(Needs.List.Num() > 0)
 		{
-			bool Keep = ProcessNeed(Need, Sources, MaintenanceSources, IdleShips, CompaniesMoney);
+			Needs.List.Sort(&NeedComparatorComparator);
+
+			TArray<AITradeNeed> KeepList;
 
-			if(Keep)
+			for(AITradeNeed& Need : Needs.List)
 			{
-				KeepList.Add(Need);
+				bool Keep = ProcessNeed(Need, Sources, MaintenanceSources, IdleShips, CompaniesMoney);
+
+				if(Keep)
+				{
+					KeepList.Add(Need);
+				}
 			}
+
+			Needs.List = KeepList;
 		}
+		return;
+	}
+
+	// Needs are processed by rounds : a need kept after processing goes back in the heap for the next round,
+	// so every need tries its closest sources before any need looks further away
+	for(AITradeNeed& Need : Needs.List)
+	{
+		Need.Round = 0;
+	}
+	Needs.List.Heapify(&NeedHeapComparator);
+
+	while(Needs.List.Num() > 0)
+	{
+		AITradeNeed Need;
+		Needs.List.HeapPop(Need, &NeedHeapComparator, false);
 
-		Needs.List = KeepList;
+		bool Keep = ProcessNeed(Need, Sources, MaintenanceSources, IdleShips, CompaniesMoney);
+
+		if(Keep)
+		{
+			Need.Round++;
+			Needs.List.HeapPush(Need, &NeedHeapComparator);
+		}
 	}
 }
 
@@ -3574,9 +3625,16 @@ void AITradeSources::Print()
 
 void AITradeSources::ConsumeSource(AITradeSource* Source)
 {
-	for(auto& SourcePerResource : SourcesPerResource)
+	if(Source->Consumed)
+	{
+		return;
+	}
+
+	// Only flag the lists the source is in, they will drop it on their next access
+	Source->Consumed = true;
+	for(int32 ListIndex = 0; ListIndex < Source->ListCount; ListIndex++)
 	{
-		SourcePerResource.Value.ConsumeSource(Source);
+		Source->Lists[ListIndex]->ConsumedCount++;
 	}
 
 #if DEBUG_NEW_AI_TRADING
@@ -3606,6 +3664,8 @@ void AITradeSources::GenerateCache()
 	for(AITradeSource& Source : Sources)
 	{
 		SourceCount++;
+		Source.Consumed = false;
+		Source.ListCount = 0;
 		SourcesPerResource[Source.Resource].Add(&Source);
 #if DEBUG_NEW_AI_TRADING
 		SourcesPtr.Add(&Source);
@@ -3664,32 +3724,12 @@ AITradeSourcesByResourceLocation& AITradeSourcesByResource::GetSourcesPerMoon(FN
 
 TArray<AITradeSource*>& AITradeSourcesByResource::GetSourcePerCompany(UFlareCompany* Company)
 {
-	return SourcesPerCompany[Company];
+	return SourcesPerCompany[Company].Get();
 }
 
 TArray<AITradeSource*>& AITradeSourcesByResource::GetSources()
 {
-	return Sources;
-}
-
-void AITradeSourcesByResource::ConsumeSource(AITradeSource* Source)
-{
-	for(auto& SourcePerSector : SourcesPerSector)
-	{
-		SourcePerSector.Value.ConsumeSource(Source);
-	}
-
-	for(auto& SourcePerSector : SourcesPerMoon)
-	{
-		SourcePerSector.Value.ConsumeSource(Source);
-	}
-
-	for(auto& SourcePerCompany : SourcesPerCompany)
-	{
-		SourcePerCompany.Value.Remove(Source);
-	}
-
-	Sources.Remove(Source);
+	return Sources.Get();
 }
 
 AITradeSourcesByResourceLocation::AITradeSourcesByResourceLocation(UFlareWorld* World)
@@ -3712,23 +3752,34 @@ void AITradeSourcesByResourceLocation::Add(AITradeSource* Source)
 
 TArray<AITradeSource*>& AITradeSourcesByResourceLocation::GetSourcePerCompany(UFlareCompany* Company)
 {
-	return SourcesPerCompany[Company];
+	return SourcesPerCompany[Company].Get();
 }
 
 TArray<AITradeSource*>& AITradeSourcesByResourceLocation::GetSources()
 {
-	return Sources;
+	return Sources.Get();
 }
 
-
-void AITradeSourcesByResourceLocation::ConsumeSource(AITradeSource* Source)
+TArray<AITradeSource*>& AITradeSourceList::Get()
 {
-	for(auto& SourcePerCompany : SourcesPerCompany)
+	if(ConsumedCount > 0)
 	{
-		SourcePerCompany.Value.Remove(Source);
+		// Same cost as the iteration that follows, and keeps the order used to break ties
+		List.RemoveAll([](AITradeSource* Source)
+		{
+			return Source->Consumed;
+		});
+		ConsumedCount = 0;
 	}
 
-	Sources.Remove(Source);
+	return List;
+}
+
+void AITradeSourceList::Add(AITradeSource* Source)
+{
+	check(Source->ListCount < AI_TRADE_SOURCE_MAX_LISTS);
+	Source->Lists[Source->ListCount++] = this;
+	List.Add(Source);
 }
 
 AITradeIdleShips::AITradeIdleShips(UFlareWorld* World)
@@ -44,11 +44,11 @@ struct ResourceVariation
 	int32 HighPriority;
 };
 
-/* Local list of resource flows */
+/* Local list of resource flows, indexed by FFlareResourceDescription::Index */
 struct SectorVariation
 {
 	int32 IncomingCapacity;
-	TMap<FFlareResourceDescription*, ResourceVariation> ResourceVariations;
+	TArray<ResourceVariation> ResourceVariations;
 };
 
 struct AITradeNeed
@@ -61,6 +61,7 @@ struct AITradeNeed
 	UFlareSimulatedSector* Sector;
 	UFlareSimulatedSpacecraft* Station;
 	size_t SourceFunctionIndex;
+	int32 Round; // Number of times the need was processed and kept
 	bool Maintenance;
 	bool HighPriority;
 
@@ -84,6 +85,11 @@ struct AITradeNeeds
 };
 
 
+struct AITradeSourceList;
+
+/* Maximum number of lists a source belong to : resource, resource company, sector, sector company, moon, moon company */
+#define AI_TRADE_SOURCE_MAX_LISTS 6
+
 struct AITradeSource
 {
 	UFlareSimulatedSpacecraft* Ship;
@@ -94,6 +100,13 @@ struct AITradeSource
 	int32 Quantity;
 	bool Stranded;
 	bool Traveling;
+
+	/* Set once the source is used, it is then removed from its lists on their next access */
+	bool Consumed;
+
+	/* Lists holding this source, so that consuming it only touches these */
+	AITradeSourceList* Lists[AI_TRADE_SOURCE_MAX_LISTS];
+	int32 ListCount;
 };
 
 inline bool operator==(const AITradeSource& lhs, const AITradeSource& rhs){
@@ -103,6 +116,21 @@ inline bool operator==(const AITradeSource& lhs, const AITradeSource& rhs){
 			&& lhs.Sector == rhs.Sector;
 }
 
+/* List of sources. Consumed sources are flagged in O(1) and compacted on the next access, keeping the list order */
+struct AITradeSourceList
+{
+	AITradeSourceList()
+		: ConsumedCount(0)
+	{}
+
+	TArray<AITradeSource*>& Get();
+
+	void Add(AITradeSource* Source);
+
+	TArray<AITradeSource*> List;
+	int32 ConsumedCount;
+};
+
 struct AITradeSourcesByResourceLocation
 {
 	AITradeSourcesByResourceLocation(UFlareWorld* World);
@@ -111,12 +139,10 @@ struct AITradeSourcesByResourceLocation
 
 	TArray<AITradeSource*>& GetSources();
 
-	void ConsumeSource(AITradeSource*);
-
 	void Add(AITradeSource* Source);
 
-	TMap<UFlareCompany*, TArray<AITradeSource*>> SourcesPerCompany;
-	TArray<AITradeSource*> Sources;
+	TMap<UFlareCompany*, AITradeSourceList> SourcesPerCompany;
+	AITradeSourceList Sources;
 };
 
 
@@ -132,14 +158,12 @@ struct AITradeSourcesByResource
 
 	TArray<AITradeSource*>& GetSources();
 
-	void ConsumeSource(AITradeSource*);
-
 	void Add(AITradeSource* Source);
 
 	TMap<UFlareSimulatedSector*, AITradeSourcesByResourceLocation> SourcesPerSector;
 	TMap<FName, AITradeSourcesByResourceLocation> SourcesPerMoon;
-	TMap<UFlareCompany*, TArray<AITradeSource*>> SourcesPerCompany;
-	TArray<AITradeSource*> Sources;
+	TMap<UFlareCompany*, AITradeSourceList> SourcesPerCompany;
+	AITradeSourceList Sources;
 };
 
 
@@ -247,6 +271,9 @@ struct AITradeHelper
 	/** Get the resource flow in this sector */
 	static SectorVariation ComputeSectorResourceVariation(UFlareCompany* Company, UFlareSimulatedSector* Sector, bool AllowUseNoTradeForMe);
 
+	/** Get the resource flow of each AI company in each of its known sectors, by sector and company world index. Sectors run on worker threads */
+	static void ComputeCompaniesResourceVariation(UFlareWorld* World, TArray<TArray<SectorVariation>>& OutVariations);
+
 	static void GenerateTradingNeeds(AITradeNeeds& Needs, AITradeNeeds& MaintenanceNeeds, AITradeNeeds& StorageNeeds, UFlareWorld* World);
 
 	static void GenerateTradingSources(AITradeSources& Sources, AITradeSources& MaintenanceSources, UFlareWorld* World);
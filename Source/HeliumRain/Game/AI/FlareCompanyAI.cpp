@@ -76,6 +76,7 @@ DECLARE_CYCLE_STAT(TEXT("FlareCompanyAI UpdateMilitaryMovement"), STAT_FlareComp
 
 UFlareCompanyAI::UFlareCompanyAI(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+	, HasPlan(false)
 {
 	AllBudgets.Add(EFlareBudget::Military);
 	AllBudgets.Add(EFlareBudget::Station);
@@ -93,6 +94,13 @@ void UFlareCompanyAI::Load(UFlareCompany* ParentCompany, const FFlareCompanyAISa
 	Behavior = NewObject<UFlareAIBehavior>(this, UFlareAIBehavior::StaticClass());
 }
 
+void UFlareCompanyAI::SetPlan(const TArray<WorldHelper::FlareResourceStats>& PlannedWorldStats, TMap<UFlareSimulatedSector*, SectorVariation>& PlannedResourceVariation)
+{
+	WorldStats = PlannedWorldStats;
+	WorldResourceVariation = MoveTemp(PlannedResourceVariation);
+	HasPlan = true;
+}
+
 FFlareCompanyAISave* UFlareCompanyAI::Save()
 {
 	return &AIData;
@@ -117,19 +125,28 @@ void UFlareCompanyAI::Simulate()
 		CheckBattleResolution();
 		UpdateDiplomacy();
 
-		WorldStats = WorldHelper::ComputeWorldResourceStats(Game, true);
 		Shipyards = FindShipyards();
 
-		// Compute input and output ressource equation (ex: 100 + 10/ day)
-		// TODO
-		WorldResourceVariation.Empty();
-		for (int32 SectorIndex = 0; SectorIndex < Company->GetKnownSectors().Num(); SectorIndex++)
+		// The world planned the analysis with the other companies
+		if (HasPlan)
 		{
-			UFlareSimulatedSector* Sector = Company->GetKnownSectors()[SectorIndex];
-			SectorVariation Variation = AITradeHelper::ComputeSectorResourceVariation(Company, Sector, true);
+			HasPlan = false;
+		}
+		else
+		{
+			WorldStats = Game->GetGameWorld()->GetResourceStats(true);
+
+			// Compute input and output ressource equation (ex: 100 + 10/ day)
+			// TODO
+			WorldResourceVariation.Empty();
+			for (int32 SectorIndex = 0; SectorIndex < Company->GetKnownSectors().Num(); SectorIndex++)
+			{
+				UFlareSimulatedSector* Sector = Company->GetKnownSectors()[SectorIndex];
+				SectorVariation Variation = AITradeHelper::ComputeSectorResourceVariation(Company, Sector, true);
 
-			WorldResourceVariation.Add(Sector, Variation);
-			//DumpSectorResourceVariation(Sector, &Variation);
+				WorldResourceVariation.Add(Sector, Variation);
+				//DumpSectorResourceVariation(Sector, &Variation);
+			}
 		}
 		Behavior->Simulate();
 
@@ -3112,7 +3129,7 @@ float UFlareCompanyAI::ComputeConstructionScoreForStation(UFlareSimulatedSector*
 		for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->ConsumerResources.Num(); ResourceIndex++)
 		{
 			FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->ConsumerResources[ResourceIndex]->Data;
-			const struct ResourceVariation* Variation = &ThisSectorVariation->ResourceVariations[Resource];
+			const struct ResourceVariation* Variation = &ThisSectorVariation->ResourceVariations[Resource->Index];
 
 
 			float Consumption = Sector->GetPeople()->GetRessourceConsumption(Resource, false);
@@ -3151,10 +3168,10 @@ float UFlareCompanyAI::ComputeConstructionScoreForStation(UFlareSimulatedSector*
 		for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->MaintenanceResources.Num(); ResourceIndex++)
 		{
 			FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->MaintenanceResources[ResourceIndex]->Data;
-			const struct ResourceVariation* Variation = &ThisSectorVariation->ResourceVariations[Resource];
+			const struct ResourceVariation* Variation = &ThisSectorVariation->ResourceVariations[Resource->Index];
 
 
-			int32 Consumption = WorldStats[Resource].Consumption / Company->GetKnownSectors().Num();
+			int32 Consumption = WorldStats[Resource->Index].Consumption / Company->GetKnownSectors().Num();
 			//FLOGV("%s comsumption = %d", *Resource->Name.ToString(), Consumption);
 
 			float ReserveStock =  Variation->MaintenanceMaxStock;
@@ -3190,10 +3207,10 @@ float UFlareCompanyAI::ComputeConstructionScoreForStation(UFlareSimulatedSector*
 		{
 			const FFlareFactoryResource* Resource = &FactoryDescription->CycleCost.InputResources[ResourceIndex];
 
-			float MaxVolume = FMath::Max(WorldStats[&Resource->Resource->Data].Production, WorldStats[&Resource->Resource->Data].Consumption);
+			float MaxVolume = FMath::Max(WorldStats[Resource->Resource->Data.Index].Production, WorldStats[Resource->Resource->Data.Index].Consumption);
 			if (MaxVolume > 0)
 			{
-				float UnderflowRatio = WorldStats[&Resource->Resource->Data].Balance / MaxVolume;
+				float UnderflowRatio = WorldStats[Resource->Resource->Data.Index].Balance / MaxVolume;
 				if (UnderflowRatio < 0)
 				{
 					float UnderflowMalus = FMath::Clamp((UnderflowRatio * 100)  / 20.f + 1.f, 0.f, 1.f);
@@ -3228,10 +3245,10 @@ float UFlareCompanyAI::ComputeConstructionScoreForStation(UFlareSimulatedSector*
 		{
 			const FFlareFactoryResource* Resource = &FactoryDescription->CycleCost.InputResources[ResourceIndex];
 
-			float MaxVolume = FMath::Max(WorldStats[&Resource->Resource->Data].Production, WorldStats[&Resource->Resource->Data].Consumption);
+			float MaxVolume = FMath::Max(WorldStats[Resource->Resource->Data.Index].Production, WorldStats[Resource->Resource->Data.Index].Consumption);
 			if (MaxVolume > 0)
 			{
-				float UnderflowRatio = WorldStats[&Resource->Resource->Data].Balance / MaxVolume;
+				float UnderflowRatio = WorldStats[Resource->Resource->Data.Index].Balance / MaxVolume;
 				if (UnderflowRatio < 0)
 				{
 					float UnderflowMalus = FMath::Clamp((UnderflowRatio * 100)  / 20.f + 1.f, 0.f, 1.f);
@@ -3268,10 +3285,10 @@ float UFlareCompanyAI::ComputeConstructionScoreForStation(UFlareSimulatedSector*
 			const FFlareFactoryResource* Resource = &FactoryDescription->CycleCost.InputResources[ResourceIndex];
 			GainPerCycle -= Sector->GetResourcePrice(&Resource->Resource->Data, EFlareResourcePriceContext::FactoryInput) * Resource->Quantity;
 
-			float MaxVolume = FMath::Max(WorldStats[&Resource->Resource->Data].Production, WorldStats[&Resource->Resource->Data].Consumption);
+			float MaxVolume = FMath::Max(WorldStats[Resource->Resource->Data.Index].Production, WorldStats[Resource->Resource->Data.Index].Consumption);
 			if (MaxVolume > 0)
 			{
-				float UnderflowRatio = WorldStats[&Resource->Resource->Data].Balance / MaxVolume;
+				float UnderflowRatio = WorldStats[Resource->Resource->Data.Index].Balance / MaxVolume;
 				if (UnderflowRatio < 0)
 				{
 					float UnderflowMalus = FMath::Clamp((UnderflowRatio * 100)  / 20.f + 1.f, 0.f, 1.f);
@@ -3311,10 +3328,10 @@ float UFlareCompanyAI::ComputeConstructionScoreForStation(UFlareSimulatedSector*
 
 			//FLOGV(" ResourceAffility for %s: %f", *Resource->Resource->Data.Identifier.ToString(), ResourceAffility);
 
-			float MaxVolume = FMath::Max(WorldStats[&Resource->Resource->Data].Production, WorldStats[&Resource->Resource->Data].Consumption);
+			float MaxVolume = FMath::Max(WorldStats[Resource->Resource->Data.Index].Production, WorldStats[Resource->Resource->Data.Index].Consumption);
 			if (MaxVolume > 0)
 			{
-				float OverflowRatio = WorldStats[&Resource->Resource->Data].Balance / MaxVolume;
+				float OverflowRatio = WorldStats[Resource->Resource->Data.Index].Balance / MaxVolume;
 				if (OverflowRatio > 0)
 				{
 					float OverflowMalus = FMath::Clamp(1.f - ((OverflowRatio - 0.1f) * 100)  / ResourceAffility, 0.f, 1.f);
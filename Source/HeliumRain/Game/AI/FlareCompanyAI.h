@@ -76,6 +76,9 @@ public:
 	/** Simulate a day */
 	virtual void Simulate();
 
+	/** Use the world analysis planned with the other companies for the next simulated day */
+	void SetPlan(const TArray<WorldHelper::FlareResourceStats>& PlannedWorldStats, TMap<UFlareSimulatedSector*, SectorVariation>& PlannedResourceVariation);
+
 	/** Try to purchase research */
 	virtual void PurchaseResearch();
 
@@ -233,9 +236,10 @@ protected:
 	UFlareAIBehavior*                      Behavior;
 	
 	// Cache
-	TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> WorldStats;
+	TArray<WorldHelper::FlareResourceStats>  WorldStats;
 	TArray<UFlareSimulatedSpacecraft*>       Shipyards;
 	TMap<UFlareSimulatedSector*, SectorVariation> WorldResourceVariation;
+	bool                                     HasPlan;
 
 	TArray<UFlareSimulatedSector*>            SectorWithBattle;
 
@@ -11,6 +11,9 @@
 #include "../Player/FlarePlayerController.h"
 
 
+DECLARE_CYCLE_STAT(TEXT("FlareBattle GetBestTarget"), STAT_FlareBattle_GetBestTarget, STATGROUP_Flare);
+
+
 struct BattleTargetPreferences
 {
         float IsLarge;
@@ -40,13 +43,19 @@ UFlareBattle::UFlareBattle(const FObjectInitializer& ObjectInitializer)
 {
 }
 
-void UFlareBattle::Load(UFlareSimulatedSector* BattleSector)
+void UFlareBattle::Load(UFlareSimulatedSector* BattleSector, int32 Seed, bool NewDeferEffects)
 {
     Game = Cast<UFlareWorld>(GetOuter())->GetGame();
     Sector = BattleSector;
     PlayerCompany = Game->GetPC()->GetCompany();
 	Catalog = Game->GetShipPartsCatalog();
+	RandomStream.Initialize(Seed);
+	DeferEffects = NewDeferEffects;
+	TurnCount = 0;
+	Events.Empty();
 
+	// The catalog is read here, on the game thread
+	Snapshot.Load(Sector, Catalog, Game->GetGameWorld()->GetCompanies().Num());
 }
 
 /*----------------------------------------------------
@@ -60,12 +69,23 @@ void UFlareBattle::Simulate()
 
     FLOGV("Simulate battle in %s", *Sector->GetSectorName().ToString());
 
-	CombatLog::AutomaticBattleStarted(Sector);
+	if (!DeferEffects)
+	{
+		CombatLog::AutomaticBattleStarted(Sector);
+	}
 
 	while (HasBattle())
     {
         BattleTurn++;
-		if(!SimulateTurn())
+		bool HasFight = SimulateTurn();
+
+		// The quests see the damages of each turn
+		if (!DeferEffects)
+		{
+			NotifyDamages();
+		}
+
+		if(!HasFight)
         {
             FLOG("Nobody can fight, end battle");
             break;
@@ -77,10 +97,89 @@ void UFlareBattle::Simulate()
         }
     }
 
-	CombatLog::AutomaticBattleEnded(Sector);
+    TurnCount = BattleTurn;
+
+	if (!DeferEffects)
+	{
+		CombatLog::AutomaticBattleEnded(Sector);
+	}
+
     FLOGV("Battle in %s finish after %d turns", *Sector->GetSectorName().ToString(), BattleTurn);
 }
 
+void UFlareBattle::ApplyDeferredEffects()
+{
+	if (!DeferEffects)
+	{
+		// Already applied during the battle
+		return;
+	}
+
+	CombatLog::AutomaticBattleStarted(Sector);
+
+	for (const FFlareBattleEvent& Event : Events)
+	{
+		ApplyEventEffects(Event);
+	}
+
+	if (TurnCount > 0)
+	{
+		NotifyDamages();
+	}
+
+	CombatLog::AutomaticBattleEnded(Sector);
+	Events.Empty();
+}
+
+void UFlareBattle::AddEvent(const FFlareBattleEvent& Event)
+{
+	if (DeferEffects)
+	{
+		Events.Add(Event);
+	}
+	else
+	{
+		ApplyEventEffects(Event);
+	}
+}
+
+void UFlareBattle::ApplyEventEffects(const FFlareBattleEvent& Event)
+{
+	if (Event.HarpoonCompany)
+	{
+		CombatLog::SpacecraftHarpooned(Event.Target, Event.HarpoonCompany);
+		return;
+	}
+
+	const FFlareComponentDamage& Damage = Event.ComponentDamage;
+	CombatLog::SpacecraftDamaged(Event.Target, Event.Energy, 0, FVector::ZeroVector, Damage.DamageType, Damage.DamageSource->GetCompany(), "SimulatedBattle");
+
+	if (Damage.EffectiveEnergy > 0)
+	{
+		Event.Target->GetDamageSystem()->ApplyDamageConsequences(Damage);
+
+		// Retaliation and hostility can change with the consequences
+		if (!DeferEffects)
+		{
+			Snapshot.SetAllDirty();
+		}
+	}
+}
+
+void UFlareBattle::NotifyDamages()
+{
+	for (UFlareSimulatedSpacecraft* Ship : Sector->GetSectorSpacecrafts())
+	{
+		Ship->GetDamageSystem()->NotifyDamage();
+	}
+
+	// The quests can change the contracts
+	if (!DeferEffects)
+	{
+		Snapshot.SetAllDirty();
+	}
+}
+
 bool UFlareBattle::HasBattle()
 {
     // Check if battle
@@ -130,37 +229,43 @@ bool UFlareBattle::SimulateTurn()
     }
 
     // List all fighting ships
-    TArray<UFlareSimulatedSpacecraft*> ShipToSimulate;
-    for (int32 ShipIndex = 0 ; ShipIndex < Sector->GetSectorShips().Num(); ShipIndex++)
+    TArray<int32> ShipToSimulate;
+    for (int32 ShipIndex = 0 ; ShipIndex < Snapshot.Spacecrafts.Num(); ShipIndex++)
     {
-        UFlareSimulatedSpacecraft* Ship = Sector->GetSectorShips()[ShipIndex];
+		int32 ShipFlags = Snapshot.GetFlags(ShipIndex);
 
-		if(Ship->IsReserve())
+		if(ShipFlags & EFlareBattleSpacecraft::Station)
+		{
+			// Not a ship
+			continue;
+		}
+
+		if(ShipFlags & EFlareBattleSpacecraft::Reserve)
 		{
 			// No in fight
 			continue;
 		}
 
-		if(!Ship->IsMilitary()  || Ship->GetDamageSystem()->IsDisarmed())
+		if(!(ShipFlags & EFlareBattleSpacecraft::Military) || (ShipFlags & EFlareBattleSpacecraft::Disarmed))
         {
             // No weapon
             continue;
         }
 
-        if(!FightingCompanies.Contains(Ship->GetCompany()))
+        if(!FightingCompanies.Contains(Snapshot.Spacecrafts[ShipIndex]->GetCompany()))
         {
             // Not in war
             continue;
         }
 
-        ShipToSimulate.Add(Ship);
+        ShipToSimulate.Add(ShipIndex);
     }
 
     // Play fighting ship inthem in random order
 
     while(ShipToSimulate.Num())
     {
-        int32 Index = FMath::RandRange(0, ShipToSimulate.Num() - 1);
+        int32 Index = RandomStream.RandRange(0, ShipToSimulate.Num() - 1);
         if(SimulateShipTurn(ShipToSimulate[Index]))
         {
             HasFight = true;
@@ -168,36 +273,30 @@ bool UFlareBattle::SimulateTurn()
         ShipToSimulate.RemoveAt(Index);
     }
 
-	for (UFlareSimulatedSpacecraft* Ship : Sector->GetSectorSpacecrafts())
-	{
-		Ship->GetDamageSystem()->NotifyDamage();
-	}
-
     return HasFight;
 }
 
-bool UFlareBattle::SimulateShipTurn(UFlareSimulatedSpacecraft* Ship)
+bool UFlareBattle::SimulateShipTurn(int32 ShipIndex)
 {
-    if(Ship->GetSize() == EFlarePartSize::S)
+    if(Snapshot.HasFlag(ShipIndex, EFlareBattleSpacecraft::Small))
     {
-        return SimulateSmallShipTurn(Ship);
+        return SimulateSmallShipTurn(ShipIndex);
     }
-    else if(Ship->GetSize() == EFlarePartSize::L)
+    else if(Snapshot.HasFlag(ShipIndex, EFlareBattleSpacecraft::Large))
     {
-        return SimulateLargeShipTurn(Ship);
+        return SimulateLargeShipTurn(ShipIndex);
     }
 
     return false;
 }
 
-bool UFlareBattle::SimulateSmallShipTurn(UFlareSimulatedSpacecraft* Ship)
+bool UFlareBattle::SimulateSmallShipTurn(int32 ShipIndex)
 {
     //  - Find a target
     //  - Find a weapon
     //  - Apply damage
 
-
-	UFlareSimulatedSpacecraft* Target = NULL;
+	UFlareSimulatedSpacecraft* Ship = Snapshot.Spacecrafts[ShipIndex];
 
     struct BattleTargetPreferences TargetPreferences;
     TargetPreferences.IsLarge = 1;
@@ -221,14 +320,13 @@ bool UFlareBattle::SimulateSmallShipTurn(UFlareSimulatedSpacecraft* Ship)
 	
 	float MinAmmoRatio = 1.f;
 
-	for (int32 ComponentIndex = 0; ComponentIndex < Ship->GetData().Components.Num(); ComponentIndex++)
+	int32 LastComponent = Snapshot.FirstComponents[ShipIndex] + Snapshot.ComponentCounts[ShipIndex];
+	for (int32 ComponentIndex = Snapshot.FirstComponents[ShipIndex]; ComponentIndex < LastComponent; ComponentIndex++)
 	{
-		FFlareSpacecraftComponentSave* ComponentData = &Ship->GetData().Components[ComponentIndex];
-		FFlareSpacecraftComponentDescription* ComponentDescription = Catalog->Get(ComponentData->ComponentIdentifier);
-
-		if (ComponentDescription->Type == EFlarePartType::Weapon)
+		if (Snapshot.ComponentTypes[ComponentIndex] == EFlarePartType::Weapon)
 		{
-			float AmmoRatio = float(ComponentDescription->WeaponCharacteristics.AmmoCapacity - ComponentData->Weapon.FiredAmmo) /  ComponentDescription->WeaponCharacteristics.AmmoCapacity;
+			int32 AmmoCapacity = Snapshot.ComponentDescriptions[ComponentIndex]->WeaponCharacteristics.AmmoCapacity;
+			float AmmoRatio = float(AmmoCapacity - Snapshot.ComponentData[ComponentIndex]->Weapon.FiredAmmo) / AmmoCapacity;
 			if(AmmoRatio < MinAmmoRatio)
 			{
 				MinAmmoRatio = AmmoRatio;
@@ -247,14 +345,15 @@ bool UFlareBattle::SimulateSmallShipTurn(UFlareSimulatedSpacecraft* Ship)
 		TargetPreferences.IsNotMilitary = 0.0;
 	}
 
-	Target = GetBestTarget(Ship, TargetPreferences);
+	int32 TargetIndex = GetBestTarget(ShipIndex, TargetPreferences);
 
-	if (!Target)
+	if (TargetIndex == INDEX_NONE)
     {
 		return false;
 	}
 
 	// Find best weapon
+	UFlareSimulatedSpacecraft* Target = Snapshot.Spacecrafts[TargetIndex];
 	int32 WeaponGroupIndex = Ship->GetWeaponsSystem()->FindBestWeaponGroup(Target);
 
 	if(WeaponGroupIndex == -1)
@@ -268,36 +367,34 @@ bool UFlareBattle::SimulateSmallShipTurn(UFlareSimulatedSpacecraft* Ship)
 		  *Ship->GetWeaponsSystem()->GetWeaponGroup(WeaponGroupIndex)->Description->Identifier.ToString())
 
 
-	return SimulateShipAttack(Ship, WeaponGroupIndex, Target);
+	return SimulateShipAttack(ShipIndex, WeaponGroupIndex, TargetIndex);
 }
 
-bool UFlareBattle::SimulateLargeShipTurn(UFlareSimulatedSpacecraft* Ship)
+bool UFlareBattle::SimulateLargeShipTurn(int32 ShipIndex)
 {
+	UFlareSimulatedSpacecraft* Ship = Snapshot.Spacecrafts[ShipIndex];
 	bool HasAttacked = false;
 
 	// Fire each turret individualy
-	for (int32 ComponentIndex = 0; ComponentIndex < Ship->GetData().Components.Num(); ComponentIndex++)
+	int32 LastComponent = Snapshot.FirstComponents[ShipIndex] + Snapshot.ComponentCounts[ShipIndex];
+	for (int32 ComponentIndex = Snapshot.FirstComponents[ShipIndex]; ComponentIndex < LastComponent; ComponentIndex++)
 	{
-		FFlareSpacecraftComponentSave* ComponentData = &Ship->GetData().Components[ComponentIndex];
-
-		FFlareSpacecraftComponentDescription* ComponentDescription = Catalog->Get(ComponentData->ComponentIdentifier);
+		FFlareSpacecraftComponentSave* ComponentData = Snapshot.ComponentData[ComponentIndex];
+		FFlareSpacecraftComponentDescription* ComponentDescription = Snapshot.ComponentDescriptions[ComponentIndex];
 
-		if(ComponentDescription->Type != EFlarePartType::Weapon || !ComponentDescription->WeaponCharacteristics.TurretCharacteristics.IsTurret)
+		if(Snapshot.ComponentTypes[ComponentIndex] != EFlarePartType::Weapon || !ComponentDescription->WeaponCharacteristics.TurretCharacteristics.IsTurret)
 		{
 			// Ignore if not a turret
 			continue;
 		}
 
-		if(Ship->GetDamageSystem()->GetUsableRatio(ComponentDescription, ComponentData) <= 0)
+		if(Snapshot.GetUsableRatio(ShipIndex, ComponentIndex) <= 0)
 		{
 			// Not usable
 			continue;
 		}
 
 
-		UFlareSimulatedSpacecraft* Target = NULL;
-
-
 		struct BattleTargetPreferences TargetPreferences;
 		TargetPreferences.IsLarge = 1;
 		TargetPreferences.IsSmall = 1;
@@ -334,20 +431,20 @@ bool UFlareBattle::SimulateLargeShipTurn(UFlareSimulatedSpacecraft* Ship)
 			TargetPreferences.IsNotMilitary = 0.0;
 		}
 
-		Target = GetBestTarget(Ship, TargetPreferences);
+		int32 TargetIndex = GetBestTarget(ShipIndex, TargetPreferences);
 
-		if (!Target)
+		if (TargetIndex == INDEX_NONE)
 		{
 			return false;
 		}
 
 		FLOGV("%s want to attack %s with %s",
 			  *Ship->GetImmatriculation().ToString(),
-			  *Target->GetImmatriculation().ToString(),
+			  *Snapshot.Spacecrafts[TargetIndex]->GetImmatriculation().ToString(),
 			  *ComponentData->ShipSlotIdentifier.ToString())
 
 
-		if (SimulateShipWeaponAttack(Ship, ComponentDescription, ComponentData, Target))
+		if (SimulateShipWeaponAttack(ShipIndex, ComponentDescription, ComponentData, TargetIndex))
 		{
 			HasAttacked = true;
 		}
@@ -355,111 +452,66 @@ bool UFlareBattle::SimulateLargeShipTurn(UFlareSimulatedSpacecraft* Ship)
 	return HasAttacked;
 }
 
-UFlareSimulatedSpacecraft* UFlareBattle::GetBestTarget(UFlareSimulatedSpacecraft* Ship, struct BattleTargetPreferences Preferences)
+int32 UFlareBattle::GetBestTarget(int32 ShipIndex, struct BattleTargetPreferences Preferences)
 {
-	UFlareSimulatedSpacecraft* BestTarget = NULL;
-	float BestScore = 0;
+	SCOPE_CYCLE_COUNTER(STAT_FlareBattle_GetBestTarget);
 
-	//FLOGV("GetBestTarget for %s", *Ship->GetImmatriculation().ToString());
+	UFlareCompany* ShipCompany = Snapshot.Spacecrafts[ShipIndex]->GetCompany();
+	int32 BestTarget = INDEX_NONE;
+	float BestScore = 0;
 
-	for (int32 SpacecraftIndex = 0 ; SpacecraftIndex < Sector->GetSectorSpacecrafts().Num(); SpacecraftIndex++)
+	for (int32 CandidateIndex = 0 ; CandidateIndex < Snapshot.Spacecrafts.Num(); CandidateIndex++)
 	{
-		UFlareSimulatedSpacecraft* ShipCandidate = Sector->GetSectorSpacecrafts()[SpacecraftIndex];
+		int32 CandidateFlags = Snapshot.GetFlags(CandidateIndex);
 
-		if(ShipCandidate->IsReserve())
+		if(CandidateFlags & EFlareBattleSpacecraft::Reserve)
 		{
 			// No in fight
 			continue;
 		}
 
-		if (!ShipCandidate->IsHostile(Ship->GetCompany()))
+		if (!Snapshot.IsHostile(CandidateIndex, ShipCompany))
 		{
 			// Ignore not hostile ships
 			continue;
 		}
 
-		if (!ShipCandidate->GetDamageSystem()->IsAlive())
+		if (!(CandidateFlags & EFlareBattleSpacecraft::Alive))
 		{
 			// Ignore destroyed ships
 			continue;
 		}
 
-		if (ShipCandidate->IsStation() && ShipCandidate->GetStationEfficiency() <= 0)
+		bool IsStation = (CandidateFlags & EFlareBattleSpacecraft::Station) != 0;
+		if (IsStation && !(CandidateFlags & EFlareBattleSpacecraft::StationEfficient))
 		{
 			// Ignore damaged stations
 			continue;
 		}
 
-		if (ShipCandidate->IsStation() && (!ShipCandidate->GetCompany()->IsPlayerCompany() || ShipCandidate->GetCompany()->GetRetaliation() <= 0))
+		if (IsStation && !(CandidateFlags & EFlareBattleSpacecraft::RetaliationTarget))
 		{
 			// Ignore company without retaliation
 			continue;
 		}
 
-		float Score;
-		float StateScore;
-		float DistanceScore;
-
-		StateScore = Preferences.TargetStateWeight;
-
-		if (ShipCandidate->GetSize() == EFlarePartSize::L)
-		{
-			StateScore *= Preferences.IsLarge;
-		}
-
-		if (ShipCandidate->GetSize() == EFlarePartSize::S)
-		{
-			StateScore *= Preferences.IsSmall;
-		}
-
-		if (ShipCandidate->IsStation())
-		{
-			StateScore *= Preferences.IsStation;
-		}
-		else
-		{
-			StateScore *= Preferences.IsNotStation;
-		}
-
-		if (ShipCandidate->IsMilitary())
-		{
-			StateScore *= Preferences.IsMilitary;
-		}
-		else
-		{
-			StateScore *= Preferences.IsNotMilitary;
-		}
-
-		if(ShipCandidate->IsMilitary()  && !ShipCandidate->GetDamageSystem()->IsDisarmed())
-		{
-			StateScore *= Preferences.IsDangerous;
-		}
-		else
-		{
-			StateScore *= Preferences.IsNotDangerous;
-		}
+		bool IsMilitary = (CandidateFlags & EFlareBattleSpacecraft::Military) != 0;
+		bool IsDisarmed = (CandidateFlags & EFlareBattleSpacecraft::Disarmed) != 0;
+		bool IsUncontrollable = (CandidateFlags & EFlareBattleSpacecraft::Uncontrollable) != 0;
 
-		if (ShipCandidate->GetDamageSystem()->IsStranded())
-		{
-			StateScore *= Preferences.IsStranded;
-		}
-		else
-		{
-			StateScore *= Preferences.IsNotStranded;
-		}
+		float StateScore = Preferences.TargetStateWeight;
+		StateScore *= (CandidateFlags & EFlareBattleSpacecraft::Large) ? Preferences.IsLarge : 1.f;
+		StateScore *= (CandidateFlags & EFlareBattleSpacecraft::Small) ? Preferences.IsSmall : 1.f;
+		StateScore *= IsStation ? Preferences.IsStation : Preferences.IsNotStation;
+		StateScore *= IsMilitary ? Preferences.IsMilitary : Preferences.IsNotMilitary;
+		StateScore *= (IsMilitary && !IsDisarmed) ? Preferences.IsDangerous : Preferences.IsNotDangerous;
+		StateScore *= (CandidateFlags & EFlareBattleSpacecraft::Stranded) ? Preferences.IsStranded : Preferences.IsNotStranded;
 
-		if (ShipCandidate->GetDamageSystem()->IsUncontrollable() && ShipCandidate->GetDamageSystem()->IsDisarmed())
+		if (IsUncontrollable && IsDisarmed)
 		{
-			if(ShipCandidate->IsMilitary())
+			if(IsMilitary)
 			{
-				if (ShipCandidate->GetSize() == EFlarePartSize::S)
-				{
-					StateScore *= Preferences.IsUncontrollableSmallMilitary;
-				}
-				else
-				{
-					StateScore *= Preferences.IsUncontrollableLargeMilitary;
-				}
+				StateScore *= (CandidateFlags & EFlareBattleSpacecraft::Small) ? Preferences.IsUncontrollableSmallMilitary : Preferences.IsUncontrollableLargeMilitary;
 			}
 			else
 			{
@@ -471,8 +523,9 @@ UFlareSimulatedSpacecraft* UFlareBattle::GetBestTarget(UFlareSimulatedSpacecraft
 			StateScore *= Preferences.IsNotUncontrollable;
 		}
 
-		if(ShipCandidate->IsHarpooned()) {
-			if(ShipCandidate->GetDamageSystem()->IsUncontrollable())
+		if(CandidateFlags & EFlareBattleSpacecraft::Harpooned)
+		{
+			if(IsUncontrollable)
 			{
 				// Never target harponned uncontrollable ships
 				continue;
@@ -480,15 +533,15 @@ UFlareSimulatedSpacecraft* UFlareBattle::GetBestTarget(UFlareSimulatedSpacecraft
 			StateScore *=  Preferences.IsHarpooned;
 		}
 
-		DistanceScore = FMath::FRand();
+		float DistanceScore = RandomStream.FRand();
 
-		Score = StateScore * (DistanceScore);
+		float Score = StateScore * (DistanceScore);
 
 		if (Score > 0)
 		{
-			if (BestTarget == NULL || Score > BestScore)
+			if (BestTarget == INDEX_NONE || Score > BestScore)
 			{
-				BestTarget = ShipCandidate;
+				BestTarget = CandidateIndex;
 				BestScore = Score;
 			}
 		}
@@ -498,15 +551,16 @@ UFlareSimulatedSpacecraft* UFlareBattle::GetBestTarget(UFlareSimulatedSpacecraft
 }
 
 
-bool UFlareBattle::SimulateShipAttack(UFlareSimulatedSpacecraft* Ship, int32 WeaponGroupIndex, UFlareSimulatedSpacecraft* Target)
+bool UFlareBattle::SimulateShipAttack(int32 ShipIndex, int32 WeaponGroupIndex, int32 TargetIndex)
 {
+	UFlareSimulatedSpacecraft* Ship = Snapshot.Spacecrafts[ShipIndex];
 	FFlareSimulatedWeaponGroup* WeaponGroup = Ship->GetWeaponsSystem()->GetWeaponGroup(WeaponGroupIndex);
 
 	bool HasAttacked = false;
 
 	// TODO configure Fire probability
 	float FireProbability = 0.8f;
-	if(FMath::FRand() < FireProbability)
+	if(RandomStream.FRand() < FireProbability)
 	{
 		// Fire with all weapon
 		for (int32 WeaponIndex = 0; WeaponIndex <  WeaponGroup->Weapons.Num(); WeaponIndex++)
@@ -516,7 +570,7 @@ bool UFlareBattle::SimulateShipAttack(UFlareSimulatedSpacecraft* Ship, int32 Wea
 				continue;
 			}
 
-			if (SimulateShipWeaponAttack(Ship, WeaponGroup->Description, WeaponGroup->Weapons[WeaponIndex], Target))
+			if (SimulateShipWeaponAttack(ShipIndex, WeaponGroup->Description, WeaponGroup->Weapons[WeaponIndex], TargetIndex))
 			{
 				HasAttacked = true;
 			}
@@ -531,8 +585,11 @@ bool UFlareBattle::SimulateShipAttack(UFlareSimulatedSpacecraft* Ship, int32 Wea
 	return HasAttacked;
 }
 
-bool UFlareBattle::SimulateShipWeaponAttack(UFlareSimulatedSpacecraft* Ship, FFlareSpacecraftComponentDescription* WeaponDescription, FFlareSpacecraftComponentSave* Weapon, UFlareSimulatedSpacecraft* Target)
+bool UFlareBattle::SimulateShipWeaponAttack(int32 ShipIndex, FFlareSpacecraftComponentDescription* WeaponDescription, FFlareSpacecraftComponentSave* Weapon, int32 TargetIndex)
 {
+	UFlareSimulatedSpacecraft* Ship = Snapshot.Spacecrafts[ShipIndex];
+	int32 TargetFlags = Snapshot.GetFlags(TargetIndex);
+
 	float UsageRatio = Ship->GetDamageSystem()->GetUsableRatio(WeaponDescription, Weapon);
 	int32 MaxAmmo = WeaponDescription->WeaponCharacteristics.AmmoCapacity;
 	int32 CurrentAmmo = MaxAmmo - Weapon->Weapon.FiredAmmo;
@@ -543,7 +600,7 @@ bool UFlareBattle::SimulateShipWeaponAttack(UFlareSimulatedSpacecraft* Ship, FFl
 	{
 		// Fire 5 s of ammo with a hit probability of 10% + precision * usage ratio
 		float FiringPeriod = 1.f / (WeaponDescription->WeaponCharacteristics.GunCharacteristics.AmmoRate / 60.f);
-		float DamageDelay = FMath::Square(1.f- UsageRatio) * 10 * FiringPeriod * FMath::FRandRange(0.f, 1.f);
+		float DamageDelay = FMath::Square(1.f- UsageRatio) * 10 * FiringPeriod * RandomStream.FRandRange(0.f, 1.f);
 		float Delay = DamageDelay + FiringPeriod;
 
 
@@ -553,17 +610,17 @@ bool UFlareBattle::SimulateShipWeaponAttack(UFlareSimulatedSpacecraft* Ship, FFl
 
 		float TargetCoef = 1.1;
 
-		if(Target->GetSize() == EFlarePartSize::S)
+		if(TargetFlags & EFlareBattleSpacecraft::Small)
 		{
 			TargetCoef *= 50;
 		}
 
-		if(Target->GetDamageSystem()->IsStranded())
+		if(TargetFlags & EFlareBattleSpacecraft::Stranded)
 		{
 			TargetCoef /= 2;
 		}
 
-		if(Target->GetDamageSystem()->IsUncontrollable())
+		if(TargetFlags & EFlareBattleSpacecraft::Uncontrollable)
 		{
 			TargetCoef /= 10;
 		}
@@ -578,28 +635,30 @@ bool UFlareBattle::SimulateShipWeaponAttack(UFlareSimulatedSpacecraft* Ship, FFl
 		FLOGV("Fire %d ammo with a hit probability of %f", AmmoToFire, Precision);
 		for (int32 BulletIndex = 0; BulletIndex <  AmmoToFire; BulletIndex++)
 		{
-			if(FMath::FRand() < Precision)
+			if(RandomStream.FRand() < Precision)
 			{
 				// Apply bullet damage
-				SimulateBulletDamage(WeaponDescription, Target, Ship);
+				SimulateBulletDamage(WeaponDescription, TargetIndex, Ship);
 			}
 		}
 
 		Weapon->Weapon.FiredAmmo += AmmoToFire;
 		Ship->GetDamageSystem()->SetAmmoDirty();
+		Snapshot.SetDirty(ShipIndex);
 	}
 	else if(WeaponDescription->WeaponCharacteristics.BombCharacteristics.IsBomb && CurrentAmmo > 0)
 	{
 		// Drop one bomb with a hit probabiliy of (1 + usable ratio + isUncontrollable)/3
 
-		if (FMath::FRand() < (1+UsageRatio+(Target->GetDamageSystem()->IsUncontrollable() ? 1.f:0.f)))
+		if (RandomStream.FRand() < (1+UsageRatio+((TargetFlags & EFlareBattleSpacecraft::Uncontrollable) ? 1.f:0.f)))
 		{
 			// Apply bullet damage
-			SimulateBombDamage(WeaponDescription, Target, Ship);
+			SimulateBombDamage(WeaponDescription, TargetIndex, Ship);
 		}
 
 		Weapon->Weapon.FiredAmmo++;
 		Ship->GetDamageSystem()->SetAmmoDirty();
+		Snapshot.SetDirty(ShipIndex);
 	}
 	else
 	{
@@ -610,35 +669,37 @@ bool UFlareBattle::SimulateShipWeaponAttack(UFlareSimulatedSpacecraft* Ship, FFl
 	return true;
 }
 
-void UFlareBattle::SimulateBulletDamage(FFlareSpacecraftComponentDescription* WeaponDescription, UFlareSimulatedSpacecraft* Target, UFlareSimulatedSpacecraft* DamageSource)
+void UFlareBattle::SimulateBulletDamage(FFlareSpacecraftComponentDescription* WeaponDescription, int32 TargetIndex, UFlareSimulatedSpacecraft* DamageSource)
 {
 	if(WeaponDescription->WeaponCharacteristics.DamageType == EFlareShellDamageType::ArmorPiercing)
 	{
-		ApplyDamage(Target, WeaponDescription->WeaponCharacteristics.GunCharacteristics.KineticEnergy, EFlareDamage::DAM_ArmorPiercing, DamageSource);
+		ApplyDamage(TargetIndex, WeaponDescription->WeaponCharacteristics.GunCharacteristics.KineticEnergy, EFlareDamage::DAM_ArmorPiercing, DamageSource);
 	}
 	else if(WeaponDescription->WeaponCharacteristics.DamageType == EFlareShellDamageType::HEAT)
 	{
-		ApplyDamage(Target, WeaponDescription->WeaponCharacteristics.ExplosionPower, EFlareDamage::DAM_HEAT, DamageSource);
+		ApplyDamage(TargetIndex, WeaponDescription->WeaponCharacteristics.ExplosionPower, EFlareDamage::DAM_HEAT, DamageSource);
 	}
 	else if(WeaponDescription->WeaponCharacteristics.DamageType == EFlareShellDamageType::HighExplosive)
 	{
 		// Generate fragments
-		float FragmentHitRatio = FMath::FRandRange(0.01f, 0.1f);
+		float FragmentHitRatio = RandomStream.FRandRange(0.01f, 0.1f);
 		int32 FragmentCount = WeaponDescription->WeaponCharacteristics.AmmoFragmentCount * FragmentHitRatio;
 
 
 		for(int FragmentIndex = 0; FragmentIndex < FragmentCount; FragmentIndex++)
 		{
-			float FragmentPowerEffet = FMath::FRandRange(0.f, 2.f);
-			ApplyDamage(Target, FragmentPowerEffet * WeaponDescription->WeaponCharacteristics.ExplosionPower, EFlareDamage::DAM_HighExplosive, DamageSource);
+			float FragmentPowerEffet = RandomStream.FRandRange(0.f, 2.f);
+			ApplyDamage(TargetIndex, FragmentPowerEffet * WeaponDescription->WeaponCharacteristics.ExplosionPower, EFlareDamage::DAM_HighExplosive, DamageSource);
 		}
 	}
 }
 
-void UFlareBattle::SimulateBombDamage(FFlareSpacecraftComponentDescription* WeaponDescription, UFlareSimulatedSpacecraft* Target, UFlareSimulatedSpacecraft* DamageSource)
+void UFlareBattle::SimulateBombDamage(FFlareSpacecraftComponentDescription* WeaponDescription, int32 TargetIndex, UFlareSimulatedSpacecraft* DamageSource)
 {
+	UFlareSimulatedSpacecraft* Target = Snapshot.Spacecrafts[TargetIndex];
+
 	// Apply damage
-	ApplyDamage(Target, WeaponDescription->WeaponCharacteristics.ExplosionPower,
+	ApplyDamage(TargetIndex, WeaponDescription->WeaponCharacteristics.ExplosionPower,
 		SpacecraftHelper::GetWeaponDamageType(WeaponDescription->WeaponCharacteristics.DamageType),
 		DamageSource);
 
@@ -648,54 +709,73 @@ void UFlareBattle::SimulateBombDamage(FFlareSpacecraftComponentDescription* Weap
 	 || (WeaponDescription->WeaponCharacteristics.DamageType == EFlareShellDamageType::HeavySalvage && Target->GetDescription()->Size == EFlarePartSize::L)))
 	{
 		FLOGV("UFlareBattle::SimulateBombDamage : salvaging %s for %s", *Target->GetImmatriculation().ToString(), *DamageSource->GetCompany()->GetCompanyName().ToString());
-		Target->SetHarpooned(DamageSource->GetCompany());
+
+		// Same as SetHarpooned, the harpoon is logged after the battle
+		if (Target->GetData().HarpoonCompany != DamageSource->GetCompany()->GetIdentifier())
+		{
+			Target->GetData().HarpoonCompany = DamageSource->GetCompany()->GetIdentifier();
+			Snapshot.SetDirty(TargetIndex);
+
+			FFlareBattleEvent Event;
+			Event.Target = Target;
+			Event.HarpoonCompany = DamageSource->GetCompany();
+			Event.Energy = 0;
+			AddEvent(Event);
+		}
 	}
 }
 
-void UFlareBattle::ApplyDamage(UFlareSimulatedSpacecraft* Target, float Energy, EFlareDamage::Type DamageType, UFlareSimulatedSpacecraft* DamageSource)
+void UFlareBattle::ApplyDamage(int32 TargetIndex, float Energy, EFlareDamage::Type DamageType, UFlareSimulatedSpacecraft* DamageSource)
 {
+	UFlareSimulatedSpacecraft* Target = Snapshot.Spacecrafts[TargetIndex];
 
 	// Find a component and apply damages
 
 	int32 ComponentIndex;
 	if(DamageType == EFlareDamage::DAM_HighExplosive)
 	{
-		ComponentIndex = FMath::RandRange(0,  Target->GetData().Components.Num()-1);
+		ComponentIndex = RandomStream.RandRange(0,  Snapshot.ComponentCounts[TargetIndex]-1);
 	}
 	else
 	{
-		ComponentIndex = GetBestTargetComponent(Target);
+		ComponentIndex = GetBestTargetComponent(TargetIndex);
 	}
 
+	ComponentIndex += Snapshot.FirstComponents[TargetIndex];
 
-	FFlareSpacecraftComponentSave* TargetComponent = &Target->GetData().Components[ComponentIndex];
-
-	FFlareSpacecraftComponentDescription* ComponentDescription = Catalog->Get(TargetComponent->ComponentIdentifier);
+	FFlareBattleEvent Event;
+	Event.Target = Target;
+	Event.HarpoonCompany = NULL;
+	Event.Energy = Energy;
+	Target->GetDamageSystem()->DamageComponent(Snapshot.ComponentDescriptions[ComponentIndex], Snapshot.ComponentData[ComponentIndex],
+		Energy, DamageType, DamageSource, Event.ComponentDamage);
+	AddEvent(Event);
 
-	CombatLog::SpacecraftDamaged(Target, Energy, 0, FVector::ZeroVector, DamageType, DamageSource->GetCompany(), "SimulatedBattle");
-	float DamageRatio = Target->GetDamageSystem()->ApplyDamage(ComponentDescription, TargetComponent, Energy, DamageType, DamageSource);
+	Snapshot.SetDirty(TargetIndex);
 }
 
 
-int32 UFlareBattle::GetBestTargetComponent(UFlareSimulatedSpacecraft* TargetSpacecraft)
+int32 UFlareBattle::GetBestTargetComponent(int32 TargetIndex)
 {
 	// Is armed, target the gun
 	// Else if not stranger target the orbital
 	// else target the rsc
 
-	float WeaponWeight = 1;
-	float PodWeight = 1;
-	float RCSWeight = 1;
-	float InternalWeight = 1;
+	int32 WeaponWeight = 1;
+	int32 PodWeight = 1;
+	int32 RCSWeight = 1;
+	int32 InternalWeight = 1;
 
-	if (!TargetSpacecraft->GetDamageSystem()->IsDisarmed())
+	int32 TargetFlags = Snapshot.GetFlags(TargetIndex);
+
+	if (!(TargetFlags & EFlareBattleSpacecraft::Disarmed))
 	{
 		WeaponWeight = 20;
 		PodWeight = 8;
 		RCSWeight = 1;
 		InternalWeight = 1;
 	}
-	else if (!TargetSpacecraft->GetDamageSystem()->IsStranded())
+	else if (!(TargetFlags & EFlareBattleSpacecraft::Stranded))
 	{
 		PodWeight = 8;
 		RCSWeight = 1;
@@ -707,66 +787,143 @@ int32 UFlareBattle::GetBestTargetComponent(UFlareSimulatedSpacecraft* TargetSpac
 		InternalWeight = 1;
 	}
 
-	TArray<int32> ComponentSelection;
+	// Weight of each component, picking in the weights is the same as picking in a list with each component repeated by its weight
+	int32 FirstComponent = Snapshot.FirstComponents[TargetIndex];
+	int32 ComponentCount = Snapshot.ComponentCounts[TargetIndex];
+	ComponentWeights.SetNumUninitialized(ComponentCount, false);
+	int32 TotalWeight = 0;
 
-	for (int32 ComponentIndex = 0; ComponentIndex < TargetSpacecraft->GetData().Components.Num(); ComponentIndex++)
+	for (int32 ComponentIndex = 0; ComponentIndex < ComponentCount; ComponentIndex++)
 	{
-		FFlareSpacecraftComponentSave* TargetComponent = &TargetSpacecraft->GetData().Components[ComponentIndex];
+		int32 SnapshotIndex = FirstComponent + ComponentIndex;
+		int32 Weight = 0;
 
-		FFlareSpacecraftComponentDescription* ComponentDescription = Catalog->Get(TargetComponent->ComponentIdentifier);
+		if (Snapshot.ComponentDescriptions[SnapshotIndex] && Snapshot.GetUsableRatio(TargetIndex, SnapshotIndex) > 0)
+		{
+			switch (Snapshot.ComponentTypes[SnapshotIndex])
+			{
+				case EFlarePartType::RCS:                Weight = RCSWeight;       break;
+				case EFlarePartType::OrbitalEngine:      Weight = PodWeight;       break;
+				case EFlarePartType::Weapon:             Weight = WeaponWeight;    break;
+				case EFlarePartType::InternalComponent:  Weight = InternalWeight;  break;
+				default:                                                           break;
+			}
+		}
+		else if (Snapshot.ComponentDescriptions[SnapshotIndex] && Snapshot.GetDamageRatio(TargetIndex, SnapshotIndex) > 0)
+		{
+			Weight = 1;
+		}
 
-		float UsageRatio = TargetSpacecraft->GetDamageSystem()->GetUsableRatio(ComponentDescription, TargetComponent);
-		float DamageRatio = TargetSpacecraft->GetDamageSystem()->GetDamageRatio(ComponentDescription, TargetComponent);
+		ComponentWeights[ComponentIndex] = Weight;
+		TotalWeight += Weight;
+	}
 
+	if(TotalWeight == 0)
+	{
+		return 0;
+	}
 
-		if (ComponentDescription && UsageRatio > 0)
+	int32 Selection = RandomStream.RandRange(0, TotalWeight - 1);
+	for (int32 ComponentIndex = 0; ComponentIndex < ComponentCount; ComponentIndex++)
+	{
+		Selection -= ComponentWeights[ComponentIndex];
+		if (Selection < 0)
 		{
-			if (ComponentDescription->Type == EFlarePartType::RCS)
-			{
-				for (int32 i = 0; i < RCSWeight; i++)
-				{
-					ComponentSelection.Add(ComponentIndex);
-				}
-			}
+			return ComponentIndex;
+		}
+	}
 
-			if (ComponentDescription->Type == EFlarePartType::OrbitalEngine)
-			{
-				for (int32 i = 0; i < PodWeight; i++)
-				{
-					ComponentSelection.Add(ComponentIndex);
-				}
-			}
+	return 0;
+}
 
-			if (ComponentDescription->Type == EFlarePartType::Weapon)
-			{
-				for (int32 i = 0; i < WeaponWeight; i++)
-				{
-					ComponentSelection.Add(ComponentIndex);
-				}
-			}
 
-			if (ComponentDescription->Type == EFlarePartType::InternalComponent)
-			{
-				for (int32 i = 0; i < InternalWeight; i++)
-				{
-					ComponentSelection.Add(ComponentIndex);
-				}
-			}
+/*----------------------------------------------------
+	Simulation state
+----------------------------------------------------*/
+
+void FFlareBattleSimulationState::Capture(const TArray<UFlareSimulatedSector*>& BattleSectors)
+{
+	Spacecrafts.Reset();
+	Components.Reset();
+	HarpoonCompanies.Reset();
+
+	for (UFlareSimulatedSector* Sector : BattleSectors)
+	{
+		for (UFlareSimulatedSpacecraft* Spacecraft : Sector->GetSectorSpacecrafts())
+		{
+			Spacecrafts.Add(Spacecraft);
+			Components.Add(Spacecraft->GetData().Components);
+			HarpoonCompanies.Add(Spacecraft->GetData().HarpoonCompany);
 		}
-		else if (ComponentDescription && DamageRatio > 0)
+	}
+}
+
+void FFlareBattleSimulationState::Restore(UFlareSpacecraftComponentsCatalog* Catalog) const
+{
+	for (int32 SpacecraftIndex = 0; SpacecraftIndex < Spacecrafts.Num(); SpacecraftIndex++)
+	{
+		UFlareSimulatedSpacecraft* Spacecraft = Spacecrafts[SpacecraftIndex];
+		Spacecraft->GetData().Components = Components[SpacecraftIndex];
+		Spacecraft->GetData().HarpoonCompany = HarpoonCompanies[SpacecraftIndex];
+
+		for (FFlareSpacecraftComponentSave& Component : Spacecraft->GetData().Components)
 		{
-			ComponentSelection.Add(ComponentIndex);
+			Spacecraft->GetDamageSystem()->SetDamageDirty(Catalog->Get(Component.ComponentIdentifier));
 		}
+		Spacecraft->GetDamageSystem()->SetAmmoDirty();
 	}
+}
 
-	if(ComponentSelection.Num() == 0)
+bool FFlareBattleSimulationState::Equals(const FFlareBattleSimulationState& Other) const
+{
+	if (Spacecrafts != Other.Spacecrafts || HarpoonCompanies != Other.HarpoonCompanies || Events.Num() != Other.Events.Num())
 	{
-		return 0;
+		return false;
 	}
 
-	int32 ComponentIndex = FMath::RandRange(0, ComponentSelection.Num() - 1);
-	return ComponentSelection[ComponentIndex];
-}
+	for (int32 SpacecraftIndex = 0; SpacecraftIndex < Spacecrafts.Num(); SpacecraftIndex++)
+	{
+		const TArray<FFlareSpacecraftComponentSave>& SpacecraftComponents = Components[SpacecraftIndex];
+		const TArray<FFlareSpacecraftComponentSave>& OtherComponents = Other.Components[SpacecraftIndex];
+
+		for (int32 ComponentIndex = 0; ComponentIndex < SpacecraftComponents.Num(); ComponentIndex++)
+		{
+			if (SpacecraftComponents[ComponentIndex].Damage != OtherComponents[ComponentIndex].Damage
+			 || SpacecraftComponents[ComponentIndex].Weapon.FiredAmmo != OtherComponents[ComponentIndex].Weapon.FiredAmmo)
+			{
+				return false;
+			}
+		}
+	}
+
+	for (int32 BattleIndex = 0; BattleIndex < Events.Num(); BattleIndex++)
+	{
+		const TArray<FFlareBattleEvent>& BattleEvents = Events[BattleIndex];
+		const TArray<FFlareBattleEvent>& OtherEvents = Other.Events[BattleIndex];
+
+		if (BattleEvents.Num() != OtherEvents.Num())
+		{
+			return false;
+		}
+
+		for (int32 EventIndex = 0; EventIndex < BattleEvents.Num(); EventIndex++)
+		{
+			const FFlareBattleEvent& Event = BattleEvents[EventIndex];
+			const FFlareBattleEvent& OtherEvent = OtherEvents[EventIndex];
 
+			if (Event.Target != OtherEvent.Target
+			 || Event.HarpoonCompany != OtherEvent.HarpoonCompany
+			 || Event.Energy != OtherEvent.Energy
+			 || Event.ComponentDamage.ComponentDescription != OtherEvent.ComponentDamage.ComponentDescription
+			 || Event.ComponentDamage.EffectiveEnergy != OtherEvent.ComponentDamage.EffectiveEnergy
+			 || Event.ComponentDamage.StateAfterDamage != OtherEvent.ComponentDamage.StateAfterDamage)
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
 
 #undef LOCTEXT_NAMESPACE
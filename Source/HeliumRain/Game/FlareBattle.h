@@ -2,11 +2,43 @@
 
 #include "Object.h"
 #include "FlareSimulatedSector.h"
+#include "FlareBattleSnapshot.h"
+#include "../Spacecrafts/Subsystems/FlareSimulatedSpacecraftDamageSystem.h"
 #include "FlareBattle.generated.h"
 
 class UFlareSpacecraftComponentsCatalog;
 
 
+/** Damage or harpoon done during a battle, whose effects outside the sector are applied after the battle */
+struct FFlareBattleEvent
+{
+	UFlareSimulatedSpacecraft* Target;
+
+	/** Set for a harpoon, else this is a damage */
+	UFlareCompany* HarpoonCompany;
+
+	float Energy;
+	FFlareComponentDamage ComponentDamage;
+};
+
+/** Spacecraft state written by the battles, and the events they recorded */
+struct FFlareBattleSimulationState
+{
+	TArray<UFlareSimulatedSpacecraft*> Spacecrafts;
+	TArray<TArray<FFlareSpacecraftComponentSave>> Components;
+	TArray<FName> HarpoonCompanies;
+	TArray<TArray<FFlareBattleEvent>> Events;
+
+	/** Copy the damages, ammo and harpoon state of the spacecrafts of these sectors */
+	void Capture(const TArray<UFlareSimulatedSector*>& BattleSectors);
+
+	/** Put back the captured state */
+	void Restore(UFlareSpacecraftComponentsCatalog* Catalog) const;
+
+	bool Equals(const FFlareBattleSimulationState& Other) const;
+};
+
+
 UCLASS()
 class HELIUMRAIN_API UFlareBattle : public UObject
 {
@@ -18,36 +50,52 @@ public:
 	  Save
 	----------------------------------------------------*/
 
-	/** Load the battle state */
-	virtual void Load(UFlareSimulatedSector* BattleSector);
+	/** Load the battle state, the battle draws from its own random stream.
+	 * Without DeferEffects, the effects outside the sector are applied as they happen, like in a serial simulation */
+	virtual void Load(UFlareSimulatedSector* BattleSector, int32 Seed, bool DeferEffects);
 
 	/*----------------------------------------------------
 		Gameplay
 	----------------------------------------------------*/
 
+	/** Fight in the sector. With DeferEffects, only touches the sector and can run on a worker thread : the log, quests and companies are updated by ApplyDeferredEffects */
 	void Simulate();
 
+	/** Write the combat log, apply the consequences of the damages and notify the destroyed spacecrafts */
+	void ApplyDeferredEffects();
+
+	/** Record a damage or harpoon, and apply its effects now if they are not deferred */
+	void AddEvent(const FFlareBattleEvent& Event);
+
+	/** Write the combat log and apply the consequences of an event */
+	void ApplyEventEffects(const FFlareBattleEvent& Event);
+
+	/** Notify the damages of the sector spacecrafts to the quests */
+	void NotifyDamages();
+
 	bool SimulateTurn();
 
-	bool SimulateShipTurn(UFlareSimulatedSpacecraft* Ship);
+	bool SimulateShipTurn(int32 ShipIndex);
 
-	bool SimulateSmallShipTurn(UFlareSimulatedSpacecraft* Ship);
+	bool SimulateSmallShipTurn(int32 ShipIndex);
 
-	bool SimulateLargeShipTurn(UFlareSimulatedSpacecraft* Ship);
+	bool SimulateLargeShipTurn(int32 ShipIndex);
 
-	UFlareSimulatedSpacecraft* GetBestTarget(UFlareSimulatedSpacecraft* Ship, struct BattleTargetPreferences Preferences);
+	/** Get the snapshot index of the best target for a ship, or INDEX_NONE */
+	int32 GetBestTarget(int32 ShipIndex, struct BattleTargetPreferences Preferences);
 
-	bool SimulateShipAttack(UFlareSimulatedSpacecraft* Ship, int32 WeaponGroupIndex, UFlareSimulatedSpacecraft* Target);
+	bool SimulateShipAttack(int32 ShipIndex, int32 WeaponGroupIndex, int32 TargetIndex);
 
-	bool SimulateShipWeaponAttack(UFlareSimulatedSpacecraft* Ship, FFlareSpacecraftComponentDescription* WeaponDescription, FFlareSpacecraftComponentSave* Weapon, UFlareSimulatedSpacecraft* Target);
+	bool SimulateShipWeaponAttack(int32 ShipIndex, FFlareSpacecraftComponentDescription* WeaponDescription, FFlareSpacecraftComponentSave* Weapon, int32 TargetIndex);
 
-	void SimulateBulletDamage(FFlareSpacecraftComponentDescription* WeaponDescription, UFlareSimulatedSpacecraft* Target, UFlareSimulatedSpacecraft* DamageSource);
+	void SimulateBulletDamage(FFlareSpacecraftComponentDescription* WeaponDescription, int32 TargetIndex, UFlareSimulatedSpacecraft* DamageSource);
 
-	void SimulateBombDamage(FFlareSpacecraftComponentDescription* WeaponDescription, UFlareSimulatedSpacecraft* Target, UFlareSimulatedSpacecraft* DamageSource);
+	void SimulateBombDamage(FFlareSpacecraftComponentDescription* WeaponDescription, int32 TargetIndex, UFlareSimulatedSpacecraft* DamageSource);
 
-	void ApplyDamage(UFlareSimulatedSpacecraft* Target, float Energy, EFlareDamage::Type DamageType, UFlareSimulatedSpacecraft* DamageSource);
+	void ApplyDamage(int32 TargetIndex, float Energy, EFlareDamage::Type DamageType, UFlareSimulatedSpacecraft* DamageSource);
 
-	int32 GetBestTargetComponent(UFlareSimulatedSpacecraft* TargetSpacecraft);
+	/** Get the index of the component to hit in the target components */
+	int32 GetBestTargetComponent(int32 TargetIndex);
 
 protected:
 
@@ -55,6 +103,14 @@ protected:
 	AFlareGame*                             Game;
 	UFlareCompany*                          PlayerCompany;
 	UFlareSpacecraftComponentsCatalog*      Catalog;
+	FRandomStream                           RandomStream;
+	bool                                    DeferEffects;
+
+	int32                                   TurnCount;
+	TArray<FFlareBattleEvent>               Events;
+
+	FFlareBattleSnapshot                    Snapshot;
+	TArray<int32>                           ComponentWeights;
 
 public:
 
@@ -67,5 +123,20 @@ public:
 		return Game;
 	}
 
+	inline UFlareSimulatedSector* GetSector() const
+	{
+		return Sector;
+	}
+
+	inline const TArray<FFlareBattleEvent>& GetEvents() const
+	{
+		return Events;
+	}
+
+	inline int32 GetTurnCount() const
+	{
+		return TurnCount;
+	}
+
         bool HasBattle();
 };
@@ -0,0 +1,133 @@
+
+#include "FlareBattleSnapshot.h"
+#include "../Flare.h"
+
+#include "FlareCompany.h"
+#include "FlareSimulatedSector.h"
+
+#include "../Data/FlareSpacecraftComponentsCatalog.h"
+#include "../Spacecrafts/FlareSimulatedSpacecraft.h"
+#include "../Spacecrafts/Subsystems/FlareSimulatedSpacecraftDamageSystem.h"
+
+
+DECLARE_CYCLE_STAT(TEXT("FlareBattleSnapshot Load"), STAT_FlareBattleSnapshot_Load, STATGROUP_Flare);
+
+
+/*----------------------------------------------------
+	Snapshot
+----------------------------------------------------*/
+
+void FFlareBattleSnapshot::Load(UFlareSimulatedSector* Sector, UFlareSpacecraftComponentsCatalog* Catalog, int32 NewCompanyCount)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareBattleSnapshot_Load);
+
+	const TArray<UFlareSimulatedSpacecraft*>& SectorSpacecrafts = Sector->GetSectorSpacecrafts();
+	int32 SpacecraftCount = SectorSpacecrafts.Num();
+
+	Spacecrafts = SectorSpacecrafts;
+	Flags.Reset(SpacecraftCount);
+	FirstComponents.Reset(SpacecraftCount);
+	ComponentCounts.Reset(SpacecraftCount);
+	Dirty.Init(true, SpacecraftCount);
+
+	CompanyCount = NewCompanyCount;
+	Hostility.Init(false, CompanyCount * SpacecraftCount);
+	HostilityKnown.Init(false, CompanyCount * SpacecraftCount);
+
+	ComponentDescriptions.Reset();
+	ComponentData.Reset();
+	ComponentTypes.Reset();
+	UsableRatios.Reset();
+	DamageRatios.Reset();
+
+	for (UFlareSimulatedSpacecraft* Spacecraft : Spacecrafts)
+	{
+		int32 SpacecraftFlags = 0;
+		SpacecraftFlags |= (Spacecraft->GetSize() == EFlarePartSize::S) ? EFlareBattleSpacecraft::Small : 0;
+		SpacecraftFlags |= (Spacecraft->GetSize() == EFlarePartSize::L) ? EFlareBattleSpacecraft::Large : 0;
+		SpacecraftFlags |= Spacecraft->IsStation() ? EFlareBattleSpacecraft::Station : 0;
+		SpacecraftFlags |= Spacecraft->IsMilitary() ? EFlareBattleSpacecraft::Military : 0;
+		SpacecraftFlags |= Spacecraft->IsReserve() ? EFlareBattleSpacecraft::Reserve : 0;
+
+		Flags.Add(SpacecraftFlags);
+		FirstComponents.Add(ComponentData.Num());
+		ComponentCounts.Add(Spacecraft->GetData().Components.Num());
+
+		for (FFlareSpacecraftComponentSave& Component : Spacecraft->GetData().Components)
+		{
+			FFlareSpacecraftComponentDescription* Description = Catalog->Get(Component.ComponentIdentifier);
+			ComponentDescriptions.Add(Description);
+			ComponentData.Add(&Component);
+			ComponentTypes.Add(Description ? Description->Type : EFlarePartType::None);
+		}
+	}
+
+	UsableRatios.SetNumZeroed(ComponentData.Num());
+	DamageRatios.SetNumZeroed(ComponentData.Num());
+}
+
+bool FFlareBattleSnapshot::IsHostile(int32 SpacecraftIndex, UFlareCompany* Company)
+{
+	int32 CompanyIndex = Company->GetWorldIndex();
+	if (CompanyIndex < 0 || CompanyIndex >= CompanyCount)
+	{
+		return Spacecrafts[SpacecraftIndex]->IsHostile(Company);
+	}
+
+	Update(SpacecraftIndex);
+
+	int32 Index = CompanyIndex * Spacecrafts.Num() + SpacecraftIndex;
+	if (!HostilityKnown[Index])
+	{
+		Hostility[Index] = Spacecrafts[SpacecraftIndex]->IsHostile(Company);
+		HostilityKnown[Index] = true;
+	}
+
+	return Hostility[Index];
+}
+
+void FFlareBattleSnapshot::Update(int32 SpacecraftIndex)
+{
+	if (!Dirty[SpacecraftIndex])
+	{
+		return;
+	}
+
+	UFlareSimulatedSpacecraft* Spacecraft = Spacecrafts[SpacecraftIndex];
+	UFlareSimulatedSpacecraftDamageSystem* DamageSystem = Spacecraft->GetDamageSystem();
+
+	// Dynamic state
+	int32 SpacecraftFlags = Flags[SpacecraftIndex] & ~(EFlareBattleSpacecraft::RetaliationTarget | EFlareBattleSpacecraft::Alive | EFlareBattleSpacecraft::Disarmed
+		| EFlareBattleSpacecraft::Stranded | EFlareBattleSpacecraft::Uncontrollable
+		| EFlareBattleSpacecraft::Harpooned | EFlareBattleSpacecraft::StationEfficient);
+	SpacecraftFlags |= DamageSystem->IsAlive() ? EFlareBattleSpacecraft::Alive : 0;
+	SpacecraftFlags |= DamageSystem->IsDisarmed() ? EFlareBattleSpacecraft::Disarmed : 0;
+	SpacecraftFlags |= DamageSystem->IsStranded() ? EFlareBattleSpacecraft::Stranded : 0;
+	SpacecraftFlags |= DamageSystem->IsUncontrollable() ? EFlareBattleSpacecraft::Uncontrollable : 0;
+	SpacecraftFlags |= Spacecraft->IsHarpooned() ? EFlareBattleSpacecraft::Harpooned : 0;
+	if (Spacecraft->GetCompany()->IsPlayerCompany() && Spacecraft->GetCompany()->GetRetaliation() > 0)
+	{
+		SpacecraftFlags |= EFlareBattleSpacecraft::RetaliationTarget;
+	}
+	if ((SpacecraftFlags & EFlareBattleSpacecraft::Station) && Spacecraft->GetStationEfficiency() > 0)
+	{
+		SpacecraftFlags |= EFlareBattleSpacecraft::StationEfficient;
+	}
+	Flags[SpacecraftIndex] = SpacecraftFlags;
+
+	// Components
+	int32 LastComponent = FirstComponents[SpacecraftIndex] + ComponentCounts[SpacecraftIndex];
+	for (int32 ComponentIndex = FirstComponents[SpacecraftIndex]; ComponentIndex < LastComponent; ComponentIndex++)
+	{
+		UsableRatios[ComponentIndex] = DamageSystem->GetUsableRatio(ComponentDescriptions[ComponentIndex], ComponentData[ComponentIndex]);
+		DamageRatios[ComponentIndex] = DamageSystem->GetDamageRatio(ComponentDescriptions[ComponentIndex], ComponentData[ComponentIndex]);
+	}
+
+	// The hostility of player ships depends on their state
+	for (int32 CompanyIndex = 0; CompanyIndex < CompanyCount; CompanyIndex++)
+	{
+		HostilityKnown[CompanyIndex * Spacecrafts.Num() + SpacecraftIndex] = false;
+	}
+
+	Dirty[SpacecraftIndex] = false;
+}
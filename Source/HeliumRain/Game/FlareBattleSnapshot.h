@@ -0,0 +1,117 @@
+#pragma once
+
+#include "Object.h"
+
+
+class UFlareCompany;
+class UFlareSimulatedSector;
+class UFlareSimulatedSpacecraft;
+class UFlareSpacecraftComponentsCatalog;
+struct FFlareSpacecraftComponentSave;
+struct FFlareSpacecraftComponentDescription;
+
+
+/** State flags of a spacecraft in a battle snapshot */
+namespace EFlareBattleSpacecraft
+{
+	enum Type
+	{
+		// Set once, when the battle starts
+		Small = 1,
+		Large = 2,
+		Station = 4,
+		Military = 8,
+		Reserve = 16,
+
+		// Updated when the spacecraft changes
+		RetaliationTarget = 32,
+		Alive = 64,
+		Disarmed = 128,
+		Stranded = 256,
+		Uncontrollable = 512,
+		Harpooned = 1024,
+		StationEfficient = 2048
+	};
+}
+
+
+/** Read cache of the spacecrafts and components of a sector fight, as flat arrays indexed by spacecraft and by component.
+ * Target and component selection read these arrays instead of the component catalog and the damage systems.
+ * Each hit is still applied to the spacecraft save on its own, and the spacecraft is then read back from its damage system. */
+struct FFlareBattleSnapshot
+{
+public:
+
+	/** Build the snapshot of the spacecrafts of a sector */
+	void Load(UFlareSimulatedSector* Sector, UFlareSpacecraftComponentsCatalog* Catalog, int32 CompanyCount);
+
+	/** Mark a spacecraft as changed, it will be read again on the next query */
+	inline void SetDirty(int32 SpacecraftIndex)
+	{
+		Dirty[SpacecraftIndex] = true;
+	}
+
+	/** Mark all spacecrafts as changed, when the effects of the battle can have changed the hostilities */
+	inline void SetAllDirty()
+	{
+		Dirty.Init(true, Spacecrafts.Num());
+	}
+
+	/** Get the flags of a spacecraft */
+	inline int32 GetFlags(int32 SpacecraftIndex)
+	{
+		Update(SpacecraftIndex);
+		return Flags[SpacecraftIndex];
+	}
+
+	inline bool HasFlag(int32 SpacecraftIndex, EFlareBattleSpacecraft::Type Flag)
+	{
+		return (GetFlags(SpacecraftIndex) & Flag) != 0;
+	}
+
+	/** Check if a spacecraft is hostile to a company, the result is kept until the spacecraft changes */
+	bool IsHostile(int32 SpacecraftIndex, UFlareCompany* Company);
+
+	/** Get the usable ratio of a component, up to date */
+	inline float GetUsableRatio(int32 SpacecraftIndex, int32 ComponentIndex)
+	{
+		Update(SpacecraftIndex);
+		return UsableRatios[ComponentIndex];
+	}
+
+	/** Get the damage ratio of a component, up to date */
+	inline float GetDamageRatio(int32 SpacecraftIndex, int32 ComponentIndex)
+	{
+		Update(SpacecraftIndex);
+		return DamageRatios[ComponentIndex];
+	}
+
+
+protected:
+
+	/** Read a dirty spacecraft back from its damage system */
+	void Update(int32 SpacecraftIndex);
+
+
+public:
+
+	// Spacecraft state, one item per sector spacecraft
+	TArray<UFlareSimulatedSpacecraft*>                  Spacecrafts;
+	TArray<int32>                                       Flags;
+	TArray<int32>                                       FirstComponents;
+	TArray<int32>                                       ComponentCounts;
+	TArray<bool>                                        Dirty;
+
+	// Hostility of each spacecraft to each company, by company world index
+	TBitArray<>                                         Hostility;
+	TBitArray<>                                         HostilityKnown;
+	int32                                               CompanyCount;
+
+	// Component state, one item per component of the sector spacecrafts
+	TArray<FFlareSpacecraftComponentDescription*>       ComponentDescriptions;
+	TArray<FFlareSpacecraftComponentSave*>              ComponentData;
+	TArray<uint8>                                       ComponentTypes;
+	TArray<float>                                       UsableRatios;
+	TArray<float>                                       DamageRatios;
+
+};
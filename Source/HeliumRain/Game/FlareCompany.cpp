@@ -31,6 +31,7 @@
 
 UFlareCompany::UFlareCompany(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+	, WorldIndex(INDEX_NONE)
 {
 }
 
@@ -279,7 +280,7 @@ EFlareHostility::Type UFlareCompany::GetWarState(const UFlareCompany* TargetComp
 	{
 		return EFlareHostility::Owned;
 	}
-	else if (GetHostility(TargetCompany) == EFlareHostility::Hostile || TargetCompany->GetHostility(this) == EFlareHostility::Hostile)
+	else if (Game->GetGameWorld()->IsAtWar(this, TargetCompany))
 	{
 		return EFlareHostility::Hostile;
 	}
@@ -320,6 +321,7 @@ void UFlareCompany::SetHostilityTo(UFlareCompany* TargetCompany, bool Hostile)
 		if (Hostile && !WasHostile)
 		{
 			CompanyData.HostileCompanies.AddUnique(TargetCompany->GetIdentifier());
+			Game->GetGameWorld()->UpdateHostilityMatrix();
 			
 			UFlareCompany* PlayerCompany = Game->GetPC()->GetCompany();
 			if (TargetCompany == PlayerCompany)
@@ -356,6 +358,7 @@ void UFlareCompany::SetHostilityTo(UFlareCompany* TargetCompany, bool Hostile)
 		else if(!Hostile && WasHostile)
 		{
 			CompanyData.HostileCompanies.Remove(TargetCompany->GetIdentifier());
+			Game->GetGameWorld()->UpdateHostilityMatrix();
 
 			UFlareCompany* PlayerCompany = Game->GetPC()->GetCompany();
 
@@ -512,6 +515,7 @@ UFlareFleet* UFlareCompany::LoadFleet(const FFlareFleetSave& FleetData)
 	Fleet = NewObject<UFlareFleet>(this, UFlareFleet::StaticClass());
 	Fleet->Load(FleetData);
 	CompanyFleets.AddUnique(Fleet);
+	GetGame()->GetGameWorld()->RegisterFleet(Fleet);
 
 	//FLOGV("UFlareWorld::LoadFleet : loaded fleet '%s'", *Fleet->GetFleetName().ToString());
 
@@ -521,6 +525,7 @@ UFlareFleet* UFlareCompany::LoadFleet(const FFlareFleetSave& FleetData)
 void UFlareCompany::RemoveFleet(UFlareFleet* Fleet)
 {
 	CompanyFleets.Remove(Fleet);
+	GetGame()->GetGameWorld()->UnregisterFleet(Fleet);
 }
 
 void UFlareCompany::MoveFleetUp(UFlareFleet* Fleet)
@@ -578,6 +583,7 @@ UFlareTradeRoute* UFlareCompany::LoadTradeRoute(const FFlareTradeRouteSave& Trad
 	TradeRoute = NewObject<UFlareTradeRoute>(this, UFlareTradeRoute::StaticClass());
 	TradeRoute->Load(TradeRouteData);
 	CompanyTradeRoutes.AddUnique(TradeRoute);
+	GetGame()->GetGameWorld()->RegisterTradeRoute(TradeRoute);
 
 	//FLOGV("UFlareCompany::LoadTradeRoute : loaded trade route '%s'", *TradeRoute->GetTradeRouteName().ToString());
 
@@ -587,6 +593,7 @@ UFlareTradeRoute* UFlareCompany::LoadTradeRoute(const FFlareTradeRouteSave& Trad
 void UFlareCompany::RemoveTradeRoute(UFlareTradeRoute* TradeRoute)
 {
 	CompanyTradeRoutes.Remove(TradeRoute);
+	GetGame()->GetGameWorld()->UnregisterTradeRoute(TradeRoute);
 }
 
 UFlareSimulatedSpacecraft* UFlareCompany::LoadSpacecraft(const FFlareSpacecraftSave& SpacecraftData)
@@ -638,6 +645,8 @@ UFlareSimulatedSpacecraft* UFlareCompany::LoadSpacecraft(const FFlareSpacecraftS
 				CompanySpacecrafts.AddUnique((Spacecraft));
 			}
 		}
+
+		GetGame()->GetGameWorld()->RegisterSpacecraft(Spacecraft);
 	}
 	else
 	{
@@ -666,6 +675,7 @@ void UFlareCompany::DestroySpacecraft(UFlareSimulatedSpacecraft* Spacecraft)
 	CompanyStations.Remove(Spacecraft);
 	CompanyChildStations.Remove(Spacecraft);
 	CompanyShips.Remove(Spacecraft);
+	GetGame()->GetGameWorld()->UnregisterSpacecraft(Spacecraft);
 	if (Spacecraft->GetCurrentFleet())
 	{
 		Spacecraft->GetCurrentFleet()->RemoveShip(Spacecraft, true);
@@ -680,6 +690,7 @@ void UFlareCompany::DestroySpacecraft(UFlareSimulatedSpacecraft* Spacecraft)
 	Spacecraft->SetDestroyed(true);
 
 	CompanyDestroyedSpacecrafts.Add(Spacecraft);
+	GetGame()->GetGameWorld()->RegisterSpacecraft(Spacecraft);
 }
 
 void UFlareCompany::DiscoverSector(UFlareSimulatedSector* Sector)
@@ -1650,25 +1661,11 @@ const struct CompanyValue UFlareCompany::GetCompanyValue(UFlareSimulatedSector*
 
 UFlareSimulatedSpacecraft* UFlareCompany::FindSpacecraft(FName ShipImmatriculation, bool Destroyed)
 {
-	if(!Destroyed )
-	{
-		for (UFlareSimulatedSpacecraft* Spacecraft : CompanySpacecrafts)
-		{
-			if (Spacecraft->GetImmatriculation() == ShipImmatriculation)
-			{
-				return Spacecraft;
-			}
-		}
-	}
-	else
+	UFlareSimulatedSpacecraft* Spacecraft = GetGame()->GetGameWorld()->FindRegisteredSpacecraft(ShipImmatriculation, Destroyed);
+
+	if (Spacecraft && Spacecraft->GetCompany() == this)
 	{
-		for (UFlareSimulatedSpacecraft* Spacecraft : CompanyDestroyedSpacecrafts)
-		{
-			if (Spacecraft->GetImmatriculation() == ShipImmatriculation)
-			{
-				return Spacecraft;
-			}
-		}
+		return Spacecraft;
 	}
 
 	return NULL;
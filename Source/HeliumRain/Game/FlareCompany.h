@@ -238,6 +238,7 @@ protected:
 	FSlateBrush                             CompanyEmblemBrush;
 
 	AFlareGame*                             Game;
+	int32                                   WorldIndex;
 	TArray<UFlareSimulatedSector*>          KnownSectors;
 	TArray<UFlareSimulatedSector*>          VisitedSectors;
 
@@ -271,6 +272,17 @@ public:
 		return CompanyData.Identifier;
 	}
 
+	/** Get the index of this company in the world company list */
+	inline int32 GetWorldIndex() const
+	{
+		return WorldIndex;
+	}
+
+	inline void SetWorldIndex(int32 Index)
+	{
+		WorldIndex = Index;
+	}
+
 	inline const FFlareCompanyDescription* GetDescription() const
 	{
 		return CompanyDescription;
@@ -438,6 +438,8 @@ void AFlareGame::Tick(float DeltaSeconds)
 
 	if (GetActiveSector() != NULL)
 	{
+		GetActiveSector()->Tick(DeltaSeconds);
+
 		for (int CompanyIndex = 0; CompanyIndex < GetGameWorld()->GetCompanies().Num(); CompanyIndex++)
 		{
 			GetGameWorld()->GetCompanies()[CompanyIndex]->TickAI();
@@ -462,48 +464,48 @@ void AFlareGame::ReadAllSaveSlots()
 	{
 		FFlareSaveSlotInfo SaveSlotInfo;
 		SaveSlotInfo.EmblemBrush.ImageSize = EmblemSize;
-		UFlareSaveGame* Save = AFlareGame::ReadSaveSlot(Index);
-		SaveSlotInfo.Save = Save;
-
-		if (Save)
-		{
-			SaveSlotInfo.UUID = Save->PlayerData.UUID;
-
-			// Basic setup
-			UFlareCustomizationCatalog* Catalog = GetCustomizationCatalog();
-			FLOGV("AFlareGame::ReadAllSaveSlots : found valid save data in slot %d", Index);
+		FString SaveFile = GetSaveFileName(Index);
 
-			// Count player ships
-			SaveSlotInfo.CompanyShipCount = 0;
+		// Read the summary, the full save is only loaded when the slot is picked
+		FFlareSaveSlotHeader Header;
+		SaveSlotInfo.Exists = SaveGameSystem->LoadHeader(SaveFile, Header);
 
-			// Find player company and count ships
-			FFlareCompanySave* PlayerCompany = NULL;
-            for (int32 CompanyIndex = 0; CompanyIndex < Save->WorldData.CompanyData.Num(); CompanyIndex++)
+		// Saves from older versions have no summary, create it once
+		if (!SaveSlotInfo.Exists)
+		{
+			UFlareSaveGame* Save = AFlareGame::ReadSaveSlot(Index);
+			if (Save)
 			{
-                const FFlareCompanySave& Company = Save->WorldData.CompanyData[CompanyIndex];
-				if (Company.Identifier == Save->PlayerData.CompanyIdentifier)
+				UFlareSaveGameSystem::BuildHeader(Save, Header);
+				SaveSlotInfo.Exists = true;
+
+				if (SaveGameSystem->DoesSaveGameExist(SaveFile))
 				{
-                    PlayerCompany = &(Save->WorldData.CompanyData[CompanyIndex]);
-					SaveSlotInfo.CompanyShipCount = Save->WorldData.CompanyData[CompanyIndex].ShipData.Num();
+					SaveGameSystem->SaveHeader(SaveFile, Header);
 				}
 			}
+		}
+
+		if (SaveSlotInfo.Exists)
+		{
+			SaveSlotInfo.UUID = Header.UUID;
+			SaveSlotInfo.CompanyShipCount = Header.CompanyShipCount;
+			FLOGV("AFlareGame::ReadAllSaveSlots : found valid save data in slot %d", Index);
 
 			// Company info
-			if (PlayerCompany)
+			if (Header.HasPlayerCompany)
 			{
-				const FFlareCompanyDescription* Desc = &Save->PlayerCompanyDescription;
-
 				// Money and general infos
-				SaveSlotInfo.CompanyValue = PlayerCompany->CompanyValue;
-				SaveSlotInfo.CompanyName = Desc->Name;
+				SaveSlotInfo.CompanyValue = Header.CompanyValue;
+				SaveSlotInfo.CompanyName = Header.CompanyName;
 
 				// Emblem material
 				SaveSlotInfo.Emblem = UMaterialInstanceDynamic::Create(BaseEmblemMaterial, GetWorld());
-				SaveSlotInfo.Emblem->SetTextureParameterValue("Emblem", GetCustomizationCatalog()->GetEmblem(Save->PlayerData.PlayerEmblemIndex));
-				SaveSlotInfo.Emblem->SetVectorParameterValue("BasePaintColor", Desc->CustomizationBasePaintColor);
-				SaveSlotInfo.Emblem->SetVectorParameterValue("PaintColor", Desc->CustomizationPaintColor);
-				SaveSlotInfo.Emblem->SetVectorParameterValue("OverlayColor", Desc->CustomizationOverlayColor);
-				SaveSlotInfo.Emblem->SetVectorParameterValue("GlowColor", Desc->CustomizationLightColor);
+				SaveSlotInfo.Emblem->SetTextureParameterValue("Emblem", GetCustomizationCatalog()->GetEmblem(Header.PlayerEmblemIndex));
+				SaveSlotInfo.Emblem->SetVectorParameterValue("BasePaintColor", Header.CustomizationBasePaintColor);
+				SaveSlotInfo.Emblem->SetVectorParameterValue("PaintColor", Header.CustomizationPaintColor);
+				SaveSlotInfo.Emblem->SetVectorParameterValue("OverlayColor", Header.CustomizationOverlayColor);
+				SaveSlotInfo.Emblem->SetVectorParameterValue("GlowColor", Header.CustomizationLightColor);
 
 				// Create the brush dynamically
 				SaveSlotInfo.EmblemBrush.SetResourceObject(SaveSlotInfo.Emblem);
@@ -511,7 +513,6 @@ void AFlareGame::ReadAllSaveSlots()
 		}
 		else
 		{
-			SaveSlotInfo.Save = NULL;
 			SaveSlotInfo.Emblem = NULL;
 			SaveSlotInfo.EmblemBrush = FSlateNoResource();
 			SaveSlotInfo.CompanyShipCount = 0;
@@ -544,7 +545,7 @@ void AFlareGame::SetCurrentSlot(int32 Index)
 bool AFlareGame::DoesSaveSlotExist(int32 Index) const
 {
 	int32 RealIndex = Index - 1;
-	return RealIndex < SaveSlots.Num() && SaveSlots[RealIndex].Save;
+	return RealIndex < SaveSlots.Num() && SaveSlots[RealIndex].Exists;
 }
 
 const FFlareSaveSlotInfo& AFlareGame::GetSaveSlotInfo(int32 Index)
@@ -1004,19 +1005,11 @@ bool AFlareGame::SaveGame(AFlarePlayerController* PC, bool Async, bool Force)
 	}
 
 	FLOGV("AFlareGame::SaveGame : saving to slot %d", CurrentSaveIndex);
-	UFlareSaveGame* Save = Cast<UFlareSaveGame>(UGameplayStatics::CreateSaveGameObject(UFlareSaveGame::StaticClass()));
+	UFlareSaveGame* Save = CreateSaveData(PC);
 	
 	// Save process
-	if (PC && Save) 
+	if (Save) 
 	{
-		// Save the player
-		PC->Save(Save->PlayerData, Save->PlayerCompanyDescription);
-		Save->WorldData = *World->Save();
-		Save->CurrentImmatriculationIndex = CurrentImmatriculationIndex;
-		Save->CurrentIdentifierIndex = CurrentIdentifierIndex;
-		Save->PlayerData.QuestData = *QuestManager->Save();
-		Save->AutoSave = AutoSave;
-
 		FLOGV("AFlareGame::SaveGame date=%lld", Save->WorldData.Date);
 		// Save
 		FString SaveName = "SaveSlot" + FString::FromInt(CurrentSaveIndex);
@@ -1045,6 +1038,26 @@ bool AFlareGame::SaveGame(AFlarePlayerController* PC, bool Async, bool Force)
 	}
 }
 
+UFlareSaveGame* AFlareGame::CreateSaveData(AFlarePlayerController* PC)
+{
+	UFlareSaveGame* Save = Cast<UFlareSaveGame>(UGameplayStatics::CreateSaveGameObject(UFlareSaveGame::StaticClass()));
+
+	if (PC && Save)
+	{
+		// Save the player
+		PC->Save(Save->PlayerData, Save->PlayerCompanyDescription);
+		Save->WorldData = *World->Save();
+		Save->CurrentImmatriculationIndex = CurrentImmatriculationIndex;
+		Save->CurrentIdentifierIndex = CurrentIdentifierIndex;
+		Save->PlayerData.QuestData = *QuestManager->Save();
+		Save->AutoSave = AutoSave;
+
+		return Save;
+	}
+
+	return NULL;
+}
+
 void AFlareGame::UnloadGame()
 {
 	FLOG("AFlareGame::UnloadGame");
@@ -1188,6 +1201,7 @@ void AFlareGame::OnLevelLoaded()
 		Planetarium->SkipNight(UFlareGameTools::SECONDS_IN_DAY);
 		ActiveSector->Load(ActivatingSector);
 		DebrisFieldSystem->Setup(this, ActivatingSector);
+		ActiveSector->LoadStaticObstacles();
 
 		GetPC()->OnSectorActivated(ActiveSector);
 	}
@@ -42,9 +42,10 @@ struct FFlareSaveSlotInfo
 {
 	GENERATED_USTRUCT_BODY()
 
-	UPROPERTY() UFlareSaveGame*            Save;
 	UPROPERTY() UMaterialInstanceDynamic*  Emblem;
 
+	bool                       Exists;
+
 	FSlateBrush                EmblemBrush;
 
 	int32                      CompanyShipCount;
@@ -91,7 +92,7 @@ public:
 		Save slots
 	----------------------------------------------------*/
 
-	/** Load metadata for all save slots */
+	/** Load metadata for all save slots, from the save summaries when they are available */
 	void ReadAllSaveSlots();
 
 	/** Get the number of save slots */
@@ -141,6 +142,9 @@ public:
 	/** Save the world to this save file */
 	virtual bool SaveGame(AFlarePlayerController* PC, bool Async, bool Force = false);
 
+	/** Build the save data of the current game */
+	UFlareSaveGame* CreateSaveData(AFlarePlayerController* PC);
+
 	/** Unload the game*/
 	virtual void UnloadGame();
 	
@@ -435,6 +439,11 @@ public:
 		return SkirmishManager;
 	}
 
+	inline UFlareSaveGameSystem* GetSaveGameSystem() const
+	{
+		return SaveGameSystem;
+	}
+
 	inline bool IsLoadedOrCreated() const
 	{
 		return LoadedOrCreated;
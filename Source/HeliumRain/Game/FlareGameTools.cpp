@@ -4,8 +4,12 @@
 
 #include "FlareGame.h"
 #include "FlareCompany.h"
+#include "FlareFleet.h"
+#include "FlareBattle.h"
 #include "FlarePlanetarium.h"
 #include "FlareSectorHelper.h"
+#include "FlareSaveGame.h"
+#include "Save/FlareSaveGameSystem.h"
 
 #include "../Data/FlareFactoryCatalogEntry.h"
 #include "../Data/FlareResourceCatalog.h"
@@ -24,6 +28,10 @@
 #define LOCTEXT_NAMESPACE "FlareGameTools"
 
 bool UFlareGameTools::FastFastForward = false;
+int32 UFlareGameTools::FastForwardBatchDays = 30;
+bool UFlareGameTools::ParallelSimulation = false;
+bool UFlareGameTools::TravelDurationTable = true;
+bool UFlareGameTools::GlobalTradingHeap = true;
 
 /*----------------------------------------------------
 	Constructor
@@ -375,29 +383,26 @@ void UFlareGameTools::PrintEconomyStatus()
 	FLOG("=============");
 	FLOG("");
 
-	TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> WorldStats;
-	WorldStats = WorldHelper::ComputeWorldResourceStats(GetGame(), true);
+	const TArray<WorldHelper::FlareResourceStats>& WorldStats = GetGame()->GetGameWorld()->GetResourceStats(true);
 
 
 	TArray<UFlareResourceCatalogEntry*> ResourceEntries = GetGame()->GetResourceCatalog()->Resources;
 	for(int ResourceIndex = 0; ResourceIndex < ResourceEntries.Num(); ResourceIndex++)
 	{
 		FFlareResourceDescription* Resource = &ResourceEntries[ResourceIndex]->Data;
+		const WorldHelper::FlareResourceStats& ResourceStats = WorldStats[Resource->Index];
 
-		if (WorldStats.Contains(Resource))
+		FLOGV("Resource '%s'", *Resource->Name.ToString());
+		FLOGV("- Stock: %d", ResourceStats.Stock);
+		FLOGV("- Production: %.2f", ResourceStats.Production);
+		FLOGV("- Consumption: %.2f", ResourceStats.Consumption);
+		if(ResourceStats.Balance < 0)
 		{
-			FLOGV("Resource '%s'", *Resource->Name.ToString());
-			FLOGV("- Stock: %d", WorldStats[Resource].Stock);
-			FLOGV("- Production: %.2f", WorldStats[Resource].Production);
-			FLOGV("- Consumption: %.2f", WorldStats[Resource].Consumption);
-			if(WorldStats[Resource].Balance < 0)
-			{
-				FLOGV("- " RED "Balance: %.2f" RESET, WorldStats[Resource].Balance);
-			}
-			else
-			{
-				FLOGV("- Balance: %.2f", WorldStats[Resource].Balance);
-			}
+			FLOGV("- " RED "Balance: %.2f" RESET, ResourceStats.Balance);
+		}
+		else
+		{
+			FLOGV("- Balance: %.2f", ResourceStats.Balance);
 		}
 	}
 
@@ -561,6 +566,455 @@ void UFlareGameTools::SetFastFastForward(bool FFF)
 	FastFastForward = FFF;
 }
 
+void UFlareGameTools::SetFastForwardBatchDays(int32 Days)
+{
+	FastForwardBatchDays = FMath::Max(Days, 1);
+}
+
+void UFlareGameTools::SetParallelSimulation(bool Parallel)
+{
+	ParallelSimulation = Parallel;
+}
+
+void UFlareGameTools::CheckParallelSimulation()
+{
+	if (!GetGameWorld())
+	{
+		FLOG("UFlareGameTools::CheckParallelSimulation failed: no loaded world");
+		return;
+	}
+
+	if (GetGameWorld()->CheckParallelSectorSimulation())
+	{
+		FLOG("UFlareGameTools::CheckParallelSimulation : parallel sector simulation matches the serial one");
+	}
+	else
+	{
+		FLOG("UFlareGameTools::CheckParallelSimulation : parallel sector simulation differs from the serial one");
+	}
+}
+
+void UFlareGameTools::CheckParallelBattles(int32 Seed)
+{
+	if (!GetGameWorld())
+	{
+		FLOG("UFlareGameTools::CheckParallelBattles failed: no loaded world");
+		return;
+	}
+
+	if (GetGameWorld()->CheckParallelBattleSimulation(Seed))
+	{
+		FLOG("UFlareGameTools::CheckParallelBattles : parallel battles match the serial ones");
+	}
+	else
+	{
+		FLOG("UFlareGameTools::CheckParallelBattles : parallel battles differ from the serial ones");
+	}
+}
+
+void UFlareGameTools::CheckParallelCompanyAI(int32 Iterations)
+{
+	if (!GetGameWorld())
+	{
+		FLOG("UFlareGameTools::CheckParallelCompanyAI failed: no loaded world");
+		return;
+	}
+
+	Iterations = FMath::Max(Iterations, 1);
+
+	double SerialTime = 0;
+	double ParallelTime = 0;
+	bool Match = GetGameWorld()->CheckParallelCompanyAIPlan(Iterations, SerialTime, ParallelTime);
+
+	FLOGV("UFlareGameTools::CheckParallelCompanyAI : %d AI companies, %d sectors, %d iterations, %d cores",
+		GetGameWorld()->GetCompanies().Num() - 1, GetGameWorld()->GetSectors().Num(), Iterations, FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+	FLOGV("UFlareGameTools::CheckParallelCompanyAI : serial plan %.3fms, parallel plan %.3fms, speedup %.2f",
+		1000 * SerialTime / Iterations, 1000 * ParallelTime / Iterations, (ParallelTime > 0) ? SerialTime / ParallelTime : 0.0);
+
+	if (Match)
+	{
+		FLOG("UFlareGameTools::CheckParallelCompanyAI : parallel plans match the serial ones");
+	}
+	else
+	{
+		FLOG("UFlareGameTools::CheckParallelCompanyAI : parallel plans differ from the serial ones");
+	}
+}
+
+void UFlareGameTools::BenchmarkBattle(FName SectorIdentifier, FName Company1ShortName, FName Company2ShortName, FName ShipClass, int32 ShipCount, int32 Seed)
+{
+	if (!GetGameWorld())
+	{
+		FLOG("UFlareGameTools::BenchmarkBattle failed: no loaded world");
+		return;
+	}
+
+	UFlareSimulatedSector* Sector = GetGameWorld()->FindSector(SectorIdentifier);
+	if (!Sector)
+	{
+		FLOGV("UFlareGameTools::BenchmarkBattle failed: no sector with identifier '%s'", *SectorIdentifier.ToString());
+		return;
+	}
+
+	if (GetActiveSector() && GetActiveSector()->GetSimulatedSector() == Sector)
+	{
+		FLOG("UFlareGameTools::BenchmarkBattle failed: the sector is active");
+		return;
+	}
+
+	UFlareCompany* Company1 = GetGameWorld()->FindCompanyByShortName(Company1ShortName);
+	UFlareCompany* Company2 = GetGameWorld()->FindCompanyByShortName(Company2ShortName);
+	if (!Company1 || !Company2 || Company1 == Company2)
+	{
+		FLOG("UFlareGameTools::BenchmarkBattle failed: two different companies are needed");
+		return;
+	}
+
+	// A war with the player changes reputation, AI behavior and quests
+	UFlareCompany* PlayerCompany = GetPC()->GetCompany();
+	if (Company1 == PlayerCompany || Company2 == PlayerCompany)
+	{
+		FLOG("UFlareGameTools::BenchmarkBattle failed: the player company can't fight");
+		return;
+	}
+
+	// Ships already in the sector fight too, their state is put back afterwards
+	FFlareBattleSimulationState InitialState;
+	InitialState.Capture({ Sector });
+
+	// Setup the fight
+	bool WasHostile1 = (Company1->GetHostility(Company2) == EFlareHostility::Hostile);
+	bool WasHostile2 = (Company2->GetHostility(Company1) == EFlareHostility::Hostile);
+	Company1->SetHostilityTo(Company2, true);
+	Company2->SetHostilityTo(Company1, true);
+
+	TArray<UFlareSimulatedSpacecraft*> Ships;
+	for (int32 ShipIndex = 0; ShipIndex < ShipCount; ShipIndex++)
+	{
+		Ships.Add(Sector->CreateSpacecraft(ShipClass, Company1, FVector::ZeroVector));
+		Ships.Add(Sector->CreateSpacecraft(ShipClass, Company2, FVector::ZeroVector));
+	}
+	Ships.Remove(NULL);
+
+	// Fight, without the effects outside the sector
+	UFlareBattle* Battle = NewObject<UFlareBattle>(GetGameWorld(), UFlareBattle::StaticClass());
+	double StartTime = FPlatformTime::Seconds();
+	Battle->Load(Sector, Seed, true);
+	double LoadTime = FPlatformTime::Seconds() - StartTime;
+	Battle->Simulate();
+	double BattleTime = FPlatformTime::Seconds() - StartTime - LoadTime;
+
+	FLOGV("UFlareGameTools::BenchmarkBattle : %d vs %d %s, %d turns in %.3fs (load %.3fs), %.1f turns/s, %d damages",
+		ShipCount, ShipCount, *ShipClass.ToString(), Battle->GetTurnCount(), BattleTime, LoadTime,
+		(BattleTime > 0) ? Battle->GetTurnCount() / BattleTime : 0.0, Battle->GetEvents().Num());
+
+	// Cleanup
+	for (UFlareSimulatedSpacecraft* Ship : Ships)
+	{
+		Ship->GetCompany()->DestroySpacecraft(Ship);
+	}
+	InitialState.Restore(GetGame()->GetShipPartsCatalog());
+	Company1->SetHostilityTo(Company2, WasHostile1);
+	Company2->SetHostilityTo(Company1, WasHostile2);
+}
+
+void UFlareGameTools::SetTravelDurationTable(bool UseTable)
+{
+	TravelDurationTable = UseTable;
+}
+
+void UFlareGameTools::SetGlobalTradingHeap(bool UseHeap)
+{
+	GlobalTradingHeap = UseHeap;
+}
+
+void UFlareGameTools::BenchmarkTravelDurations(int32 Iterations)
+{
+	if (!GetGameWorld())
+	{
+		FLOG("UFlareGameTools::BenchmarkTravelDurations failed: no loaded world");
+		return;
+	}
+
+	UFlareWorld* World = GetGameWorld();
+	const TArray<UFlareSimulatedSector*>& Sectors = World->GetSectors();
+	UFlareCompany* Company = GetPC()->GetCompany();
+	bool WasUsingTable = TravelDurationTable;
+	int64 Checksums[2] = {0, 0};
+	double Times[2] = {0, 0};
+
+	for (int32 Pass = 0; Pass < 2; Pass++)
+	{
+		TravelDurationTable = (Pass == 1);
+		double StartTime = FPlatformTime::Seconds();
+
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			for (UFlareSimulatedSector* OriginSector : Sectors)
+			{
+				for (UFlareSimulatedSector* DestinationSector : Sectors)
+				{
+					Checksums[Pass] += UFlareTravel::ComputeTravelDuration(World, OriginSector, DestinationSector, Company);
+				}
+			}
+		}
+
+		Times[Pass] = FPlatformTime::Seconds() - StartTime;
+	}
+
+	TravelDurationTable = WasUsingTable;
+
+	FLOGV("UFlareGameTools::BenchmarkTravelDurations : %d sectors, %d iterations, orbits %.3fs, table %.3fs%s",
+		Sectors.Num(), Iterations, Times[0], Times[1], (Checksums[0] == Checksums[1]) ? TEXT("") : TEXT(", DURATIONS DIFFER"));
+}
+
+void UFlareGameTools::BenchmarkSimulation(int32 SlotIndex, int32 DayCount, int32 Seed)
+{
+	FLOGV("UFlareGameTools::BenchmarkSimulation slot=%d days=%d seed=%d", SlotIndex, DayCount, Seed);
+
+	// Load the save from scratch, without activating any sector
+	if (GetGame()->IsLoadedOrCreated())
+	{
+		GetGame()->UnloadGame();
+	}
+	GetGame()->SetCurrentSlot(SlotIndex);
+	if (!GetGame()->LoadGame(GetPC()))
+	{
+		FLOGV("UFlareGameTools::BenchmarkSimulation failed: cannot load slot %d", SlotIndex);
+		return;
+	}
+
+	if (!GetPC()->GetPlayerShip())
+	{
+		if (!GetPC()->GetPlayerFleet() || GetPC()->GetPlayerFleet()->GetShips().Num() == 0)
+		{
+			FLOG("UFlareGameTools::BenchmarkSimulation failed: no player fleet");
+			return;
+		}
+		GetPC()->SetPlayerShip(GetPC()->GetPlayerFleet()->GetShips()[0]);
+	}
+
+	// Reproducible run
+	FMath::RandInit(Seed);
+	FMath::SRandInit(Seed);
+
+	UFlareWorld* World = GetGameWorld();
+	TArray<FFlareSimulationDayStats> DayStats;
+	for (int32 DayIndex = 0; DayIndex < DayCount; DayIndex++)
+	{
+		World->Simulate();
+		DayStats.Add(World->GetLastSimulationStats());
+	}
+
+	// CSV output
+	FString CsvContents = TEXT("Date");
+	for (int32 PhaseIndex = 0; PhaseIndex < EFlareSimulationPhase::Count; PhaseIndex++)
+	{
+		CsvContents += FString(TEXT(",")) + UFlareWorld::GetSimulationPhaseName((EFlareSimulationPhase::Type) PhaseIndex);
+	}
+	CsvContents += TEXT(",Total\n");
+
+	TArray<TSharedPtr<FJsonValue>> JsonDays;
+	for (const FFlareSimulationDayStats& Stats : DayStats)
+	{
+		TSharedPtr<FJsonObject> JsonDay = MakeShareable(new FJsonObject());
+		JsonDay->SetNumberField("Date", Stats.Date);
+
+		CsvContents += FString::Printf(TEXT("%lld"), Stats.Date);
+		for (int32 PhaseIndex = 0; PhaseIndex < EFlareSimulationPhase::Count; PhaseIndex++)
+		{
+			const FFlareSimulationPhaseStats& PhaseStats = Stats.Phases[PhaseIndex];
+			CsvContents += FString::Printf(TEXT(",%.6f"), PhaseStats.Time);
+
+			TSharedPtr<FJsonObject> JsonPhase = MakeShareable(new FJsonObject());
+			JsonPhase->SetNumberField("Time", PhaseStats.Time);
+			JsonPhase->SetNumberField("Objects", PhaseStats.ObjectCount);
+			JsonPhase->SetNumberField("MemoryGrowth", PhaseStats.MemoryGrowth);
+			JsonDay->SetObjectField(UFlareWorld::GetSimulationPhaseName((EFlareSimulationPhase::Type) PhaseIndex), JsonPhase);
+		}
+		CsvContents += FString::Printf(TEXT(",%.6f\n"), Stats.TotalTime);
+		JsonDay->SetNumberField("Total", Stats.TotalTime);
+
+		JsonDays.Add(MakeShareable(new FJsonValueObject(JsonDay)));
+	}
+
+	// JSON output
+	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	JsonObject->SetNumberField("Slot", SlotIndex);
+	JsonObject->SetNumberField("Seed", Seed);
+	JsonObject->SetNumberField("Sectors", World->GetSectors().Num());
+	JsonObject->SetBoolField("TravelDurationTable", TravelDurationTable);
+	JsonObject->SetBoolField("GlobalTradingHeap", GlobalTradingHeap);
+	JsonObject->SetBoolField("ParallelSimulation", ParallelSimulation);
+	JsonObject->SetArrayField("Days", JsonDays);
+
+	FString JsonContents;
+	TSharedRef< TJsonWriter<> > JsonWriter = TJsonWriterFactory<>::Create(&JsonContents);
+	FJsonSerializer::Serialize(JsonObject, JsonWriter);
+	JsonWriter->Close();
+
+	FString BaseName = FString::Printf(TEXT("%s/SimulationBenchmark/Slot%d-Seed%d-%s"),
+		*FPaths::ProfilingDir(), SlotIndex, Seed, *FDateTime::Now().ToString());
+	FFileHelper::SaveStringToFile(CsvContents, *(BaseName + TEXT(".csv")));
+	FFileHelper::SaveStringToFile(JsonContents, *(BaseName + TEXT(".json")));
+
+	double TotalTime = 0;
+	for (const FFlareSimulationDayStats& Stats : DayStats)
+	{
+		TotalTime += Stats.TotalTime;
+	}
+	FLOGV("UFlareGameTools::BenchmarkSimulation : %d days simulated in %.3fs, %d sectors, table=%d heap=%d parallel=%d, results in %s.csv",
+		DayStats.Num(), TotalTime, World->GetSectors().Num(), TravelDurationTable, GlobalTradingHeap, ParallelSimulation, *BaseName);
+
+	// Average day cost of each phase, to compare runs with different switches
+	for (int32 PhaseIndex = 0; PhaseIndex < EFlareSimulationPhase::Count && DayStats.Num(); PhaseIndex++)
+	{
+		double PhaseTime = 0;
+		for (const FFlareSimulationDayStats& Stats : DayStats)
+		{
+			PhaseTime += Stats.Phases[PhaseIndex].Time;
+		}
+		FLOGV("- %-16s avg %.6fs per day", UFlareWorld::GetSimulationPhaseName((EFlareSimulationPhase::Type) PhaseIndex), PhaseTime / DayStats.Num());
+	}
+}
+
+void UFlareGameTools::PrintSimulationStats()
+{
+	if (!GetGameWorld())
+	{
+		FLOG("UFlareGameTools::PrintSimulationStats failed: no loaded world");
+		return;
+	}
+
+	TArray<FFlareSimulationDayStats> History;
+	GetGameWorld()->GetSimulationStatsHistory(History);
+	if (History.Num() == 0)
+	{
+		FLOG("UFlareGameTools::PrintSimulationStats : no simulated day yet");
+		return;
+	}
+
+	FLOGV("Simulation stats for the last %d days", History.Num());
+	for (int32 PhaseIndex = 0; PhaseIndex < EFlareSimulationPhase::Count; PhaseIndex++)
+	{
+		double TotalTime = 0;
+		double MaxTime = 0;
+		int64 TotalObjects = 0;
+		int64 TotalMemoryGrowth = 0;
+
+		for (const FFlareSimulationDayStats& Stats : History)
+		{
+			const FFlareSimulationPhaseStats& PhaseStats = Stats.Phases[PhaseIndex];
+			TotalTime += PhaseStats.Time;
+			MaxTime = FMath::Max(MaxTime, PhaseStats.Time);
+			TotalObjects += PhaseStats.ObjectCount;
+			TotalMemoryGrowth += PhaseStats.MemoryGrowth;
+		}
+
+		FLOGV("- %-16s avg %.6fs max %.6fs, %lld objects, %lld bytes memory growth per day",
+			UFlareWorld::GetSimulationPhaseName((EFlareSimulationPhase::Type) PhaseIndex),
+			TotalTime / History.Num(),
+			MaxTime,
+			TotalObjects / History.Num(),
+			TotalMemoryGrowth / History.Num());
+	}
+
+	const FFlareSimulationDayStats& LastStats = History.Last();
+	FLOGV("Last day %lld simulated in %.6fs", LastStats.Date, LastStats.TotalTime);
+}
+
+void UFlareGameTools::BenchmarkSaveFormats(int32 Iterations)
+{
+	if (!GetGame()->IsLoadedOrCreated())
+	{
+		FLOG("UFlareGameTools::BenchmarkSaveFormats failed: no loaded world");
+		return;
+	}
+
+	UFlareSaveGameSystem* SaveGameSystem = GetGame()->GetSaveGameSystem();
+	UFlareSaveGame* Save = GetGame()->CreateSaveData(GetPC());
+	if (!Save)
+	{
+		FLOG("UFlareGameTools::BenchmarkSaveFormats failed: cannot build the save data");
+		return;
+	}
+
+	Iterations = FMath::Max(Iterations, 1);
+	FLOGV("UFlareGameTools::BenchmarkSaveFormats iterations=%d", Iterations);
+
+	// The process peak can't be reset, so the physical memory growth over each step is recorded along with the peak growth
+	FString CsvContents = TEXT("Format,Iteration,SaveTime,SaveMemory,SavePeakGrowth,LoadTime,LoadMemory,LoadPeakGrowth,FileSize\n");
+	bool UseBinaryFormat = UFlareSaveGameSystem::UseBinaryFormat;
+
+	for (int32 FormatIndex = 0; FormatIndex < 2; FormatIndex++)
+	{
+		bool Binary = (FormatIndex == 1);
+		const TCHAR* FormatName = Binary ? TEXT("Binary") : TEXT("Json");
+		FString SaveName = FString(TEXT("SaveBenchmark")) + FormatName;
+		FString FileName = Binary ? UFlareSaveGameSystem::GetBinarySaveGamePath(SaveName) : UFlareSaveGameSystem::GetSaveGamePath(SaveName, true);
+		UFlareSaveGameSystem::UseBinaryFormat = Binary;
+
+		double TotalSaveTime = 0;
+		double TotalLoadTime = 0;
+		int64 MaxSavePeakGrowth = 0;
+		int64 MaxLoadPeakGrowth = 0;
+		int64 FileSize = 0;
+
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			// Save
+			FPlatformMemoryStats MemoryBefore = FPlatformMemory::GetStats();
+			double StartTime = FPlatformTime::Seconds();
+			bool Saved = SaveGameSystem->SaveGame(SaveName, Save);
+			double SaveTime = FPlatformTime::Seconds() - StartTime;
+			FPlatformMemoryStats MemoryAfterSave = FPlatformMemory::GetStats();
+			FileSize = IFileManager::Get().FileSize(*FileName);
+
+			// Load
+			StartTime = FPlatformTime::Seconds();
+			UFlareSaveGame* Loaded = SaveGameSystem->LoadGame(SaveName);
+			double LoadTime = FPlatformTime::Seconds() - StartTime;
+			FPlatformMemoryStats MemoryAfterLoad = FPlatformMemory::GetStats();
+
+			if (!Saved || !Loaded)
+			{
+				FLOGV("UFlareGameTools::BenchmarkSaveFormats failed: %s save or load error", FormatName);
+				break;
+			}
+
+			TotalSaveTime += SaveTime;
+			TotalLoadTime += LoadTime;
+			MaxSavePeakGrowth = FMath::Max(MaxSavePeakGrowth, (int64) MemoryAfterSave.PeakUsedPhysical - (int64) MemoryBefore.PeakUsedPhysical);
+			MaxLoadPeakGrowth = FMath::Max(MaxLoadPeakGrowth, (int64) MemoryAfterLoad.PeakUsedPhysical - (int64) MemoryAfterSave.PeakUsedPhysical);
+
+			CsvContents += FString::Printf(TEXT("%s,%d,%.6f,%lld,%lld,%.6f,%lld,%lld,%lld\n"),
+				FormatName, Iteration,
+				SaveTime,
+				(int64) MemoryAfterSave.UsedPhysical - (int64) MemoryBefore.UsedPhysical,
+				(int64) MemoryAfterSave.PeakUsedPhysical - (int64) MemoryBefore.PeakUsedPhysical,
+				LoadTime,
+				(int64) MemoryAfterLoad.UsedPhysical - (int64) MemoryAfterSave.UsedPhysical,
+				(int64) MemoryAfterLoad.PeakUsedPhysical - (int64) MemoryAfterSave.PeakUsedPhysical,
+				FileSize);
+		}
+
+		FLOGV("- %-6s save avg %.3fs (peak growth %lld bytes), load avg %.3fs (peak growth %lld bytes), %lld bytes",
+			FormatName, TotalSaveTime / Iterations, MaxSavePeakGrowth, TotalLoadTime / Iterations, MaxLoadPeakGrowth, FileSize);
+		SaveGameSystem->DeleteGame(SaveName);
+	}
+
+	UFlareSaveGameSystem::UseBinaryFormat = UseBinaryFormat;
+
+	FString FileName = FString::Printf(TEXT("%s/SaveBenchmark/SaveFormats-%s.csv"), *FPaths::ProfilingDir(), *FDateTime::Now().ToString());
+	FFileHelper::SaveStringToFile(CsvContents, *FileName);
+	FLOGV("UFlareGameTools::BenchmarkSaveFormats : results in %s", *FileName);
+}
+
+void UFlareGameTools::SetBinarySaves(bool Binary)
+{
+	UFlareSaveGameSystem::UseBinaryFormat = Binary;
+}
+
 /*----------------------------------------------------
 	Company tools
 ----------------------------------------------------*/
@@ -1746,6 +2200,21 @@ void UFlareGameTools::CreateAsteroid(int32 ID, FName Name)
 	GetGame()->ActivateCurrentSector();
 }
 
+void UFlareGameTools::PrintShellPoolStats()
+{
+	if (!GetActiveSector())
+	{
+		FLOG("AFlareGame::PrintShellPoolStats failed: no active sector");
+		return;
+	}
+
+	const FFlareShellPoolStats& Stats = GetActiveSector()->GetShellPoolStats();
+	int32 Requests = Stats.Hits + Stats.Misses;
+
+	FLOGV("Shell pool: %d hits, %d misses (%.1f%% hit rate)", Stats.Hits, Stats.Misses, (Requests > 0 ? 100.f * Stats.Hits / Requests : 0.f));
+	FLOGV("Shell pool: %d pooled now, peak %d pooled, peak %d in flight", GetActiveSector()->GetPooledShellCount(), Stats.PeakPooledCount, Stats.PeakActiveCount);
+}
+
 void UFlareGameTools::CreateMeteoriteGroup(FName SectorIdentifier, float PowerRatio)
 {
 	if (!GetActiveSector())
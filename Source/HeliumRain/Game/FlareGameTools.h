@@ -95,6 +95,58 @@ public:
 	UFUNCTION(exec)
 	void SetFastFastForward(bool FFF);
 
+	/** Simulate up to this many days per automatic fast forward step, stopping on the first notification. 1 goes back to one day every half second */
+	UFUNCTION(exec)
+	void SetFastForwardBatchDays(int32 Days);
+
+	/** Run the independent per-sector steps of a day on worker threads. The battles then apply their effects after all are fought, and the AI companies plan from the same stocks */
+	UFUNCTION(exec)
+	void SetParallelSimulation(bool Parallel);
+
+	/** Check that the parallel per-sector steps of a day give the same result as the serial ones */
+	UFUNCTION(exec)
+	void CheckParallelSimulation();
+
+	/** Check that the battles of the day fought in parallel give the same result as the serial ones, for a fixed seed */
+	UFUNCTION(exec)
+	void CheckParallelBattles(int32 Seed);
+
+	/** Plan the company AIs serially and in parallel, print the timings and check the plans match */
+	UFUNCTION(exec)
+	void CheckParallelCompanyAI(int32 Iterations);
+
+	/** Fight an automatic battle between two fleets of ShipCount ships in a sector and print the simulated turns per second. The ships are removed and the sector ships repaired afterwards, the player company can't fight */
+	UFUNCTION(exec)
+	void BenchmarkBattle(FName SectorIdentifier, FName Company1ShortName, FName Company2ShortName, FName ShipClass, int32 ShipCount, int32 Seed);
+
+	/** Serve the travel durations from the world table instead of computing them from the orbits */
+	UFUNCTION(exec)
+	void SetTravelDurationTable(bool UseTable);
+
+	/** Process the AI trading needs from a heap, or re-sort them every round like the former loop, to compare the costs with BenchmarkSimulation */
+	UFUNCTION(exec)
+	void SetGlobalTradingHeap(bool UseHeap);
+
+	/** Time the travel durations between all sectors, from the table and from the orbits, and check they match */
+	UFUNCTION(exec)
+	void BenchmarkTravelDurations(int32 Iterations);
+
+	/** Load a save slot, simulate days with a fixed random seed and write the per-phase timings as CSV and JSON */
+	UFUNCTION(exec)
+	void BenchmarkSimulation(int32 SlotIndex, int32 DayCount, int32 Seed);
+
+	/** Print the per-phase profiling data of the last simulated days */
+	UFUNCTION(exec)
+	void PrintSimulationStats();
+
+	/** Save and load the current game in the JSON and binary formats, and write the timings, memory growth and file sizes as CSV */
+	UFUNCTION(exec)
+	void BenchmarkSaveFormats(int32 Iterations);
+
+	/** Write new saves in the binary format, or in the legacy JSON format */
+	UFUNCTION(exec)
+	void SetBinarySaves(bool Binary);
+
 	/*----------------------------------------------------
 		Company tools
 	----------------------------------------------------*/
@@ -276,6 +328,10 @@ public:
 	UFUNCTION(exec)
 	void CreateMeteoriteGroup(FName TargetSector, float PowerRatio);
 
+	/** Print the shell pool hits, misses and peak sizes of the active sector */
+	UFUNCTION(exec)
+	void PrintShellPoolStats();
+
 	/*----------------------------------------------------
 		Helper
 	----------------------------------------------------*/
@@ -325,4 +381,12 @@ public:
 
 	static bool FastFastForward;
 
+	static int32 FastForwardBatchDays;
+
+	static bool ParallelSimulation;
+
+	static bool TravelDurationTable;
+
+	static bool GlobalTradingHeap;
+
 };
@@ -0,0 +1,189 @@
+#pragma once
+
+#include "Object.h"
+
+
+/** Kinds of ships the player is hired to hunt in a company */
+namespace EFlareHuntContract
+{
+	enum Type
+	{
+		None = 0,
+		SmallCargo = 1,
+		LargeCargo = 2,
+		Military = 4
+	};
+}
+
+
+/** Military contract state of a company in a sector */
+namespace EFlareSectorContract
+{
+	enum Type
+	{
+		None = 0,
+		/** Station defense, sector defense or attack contract */
+		Sector = 1,
+		/** Hunt contract, with a target in the sector */
+		HuntTarget = 2,
+		/** One of the contracts applied earlier on the matrix date */
+		Sticky = 4
+	};
+}
+
+
+/** War states between companies, and the military contracts of the player, indexed by company and sector world indexes.
+ * Built by UFlareWorld when the war states, the quests or the date change, so that lookups are bit tests.
+ * A contract that ended stays sticky until the date changes, so that ships don't stop fighting as soon as a quest ends. */
+struct FFlareHostilityMatrix
+{
+public:
+
+	FFlareHostilityMatrix()
+		: CompanyCount(0)
+		, SectorCount(0)
+		, Date(-1)
+	{
+	}
+
+	/** Clear the matrix for these counts and date */
+	inline void Reset(int32 NewCompanyCount, int32 NewSectorCount, int64 NewDate)
+	{
+		CompanyCount = NewCompanyCount;
+		SectorCount = NewSectorCount;
+		Date = NewDate;
+		War.Init(false, CompanyCount * CompanyCount);
+		SectorContracts.Reset(CompanyCount * SectorCount);
+		SectorContracts.SetNumZeroed(CompanyCount * SectorCount);
+		HuntContracts.Reset(CompanyCount);
+		HuntContracts.SetNumZeroed(CompanyCount);
+		StickyHuntContracts.Reset(CompanyCount);
+		StickyHuntContracts.SetNumZeroed(CompanyCount);
+	}
+
+	/** Keep the contracts of the previous matrix sticky if it was built on the same date */
+	inline void KeepStickyContracts(const FFlareHostilityMatrix& Previous)
+	{
+		if (Previous.Date != Date || Previous.CompanyCount != CompanyCount || Previous.SectorCount != SectorCount)
+		{
+			return;
+		}
+
+		for (int32 Index = 0; Index < SectorContracts.Num(); Index++)
+		{
+			SectorContracts[Index] |= (Previous.SectorContracts[Index] & EFlareSectorContract::Sticky);
+		}
+
+		for (int32 Company = 0; Company < CompanyCount; Company++)
+		{
+			StickyHuntContracts[Company] |= Previous.StickyHuntContracts[Company];
+		}
+	}
+
+	inline bool IsValidCompany(int32 Company) const
+	{
+		return Company >= 0 && Company < CompanyCount;
+	}
+
+	inline bool IsValidSector(int32 Sector) const
+	{
+		return Sector >= 0 && Sector < SectorCount;
+	}
+
+	/** Set two companies at war, both ways */
+	inline void SetWar(int32 Company1, int32 Company2)
+	{
+		War[Company1 * CompanyCount + Company2] = true;
+		War[Company2 * CompanyCount + Company1] = true;
+	}
+
+	inline bool IsAtWar(int32 Company1, int32 Company2) const
+	{
+		return War[Company1 * CompanyCount + Company2];
+	}
+
+	/** Allow the player to fight a company in a sector */
+	inline void AddSectorContract(int32 Company, int32 Sector)
+	{
+		SectorContracts[Company * SectorCount + Sector] |= EFlareSectorContract::Sector | EFlareSectorContract::Sticky;
+	}
+
+	/** Set whether a sector holds a ship of a company the player is hired to hunt */
+	inline void SetHuntTarget(int32 Company, int32 Sector, bool HasTarget)
+	{
+		uint8& Contract = SectorContracts[Company * SectorCount + Sector];
+		if (HasTarget)
+		{
+			Contract |= EFlareSectorContract::HuntTarget | EFlareSectorContract::Sticky;
+		}
+		else
+		{
+			Contract &= ~EFlareSectorContract::HuntTarget;
+		}
+	}
+
+	/** Check if the player can fight a company in a sector, invalid indexes have no contract */
+	inline bool HasSectorContract(int32 Company, int32 Sector, bool IncludeSticky) const
+	{
+		if (!IsValidCompany(Company) || !IsValidSector(Sector))
+		{
+			return false;
+		}
+
+		int32 Mask = EFlareSectorContract::Sector | EFlareSectorContract::HuntTarget | (IncludeSticky ? EFlareSectorContract::Sticky : 0);
+		return (SectorContracts[Company * SectorCount + Sector] & Mask) != 0;
+	}
+
+	/** Allow the player to hunt some ships of a company, in any sector */
+	inline void AddHuntContract(int32 Company, EFlareHuntContract::Type Contract)
+	{
+		HuntContracts[Company] |= Contract;
+		StickyHuntContracts[Company] |= Contract;
+	}
+
+	inline uint8 GetHuntContracts(int32 Company) const
+	{
+		return HuntContracts[Company];
+	}
+
+	/** Check if the player is hired to hunt this kind of ships of a company, invalid indexes have no contract */
+	inline bool IsHuntTarget(int32 Company, EFlareHuntContract::Type Contract, bool IncludeSticky) const
+	{
+		if (!IsValidCompany(Company))
+		{
+			return false;
+		}
+
+		return ((IncludeSticky ? StickyHuntContracts[Company] : HuntContracts[Company]) & Contract) != 0;
+	}
+
+	/** Get the kind of hunt contract that targets a ship */
+	static inline EFlareHuntContract::Type GetHuntContractType(bool IsMilitary, bool IsLarge)
+	{
+		if (IsMilitary)
+		{
+			return EFlareHuntContract::Military;
+		}
+		else if (IsLarge)
+		{
+			return EFlareHuntContract::LargeCargo;
+		}
+		else
+		{
+			return EFlareHuntContract::SmallCargo;
+		}
+	}
+
+
+protected:
+
+	int32                              CompanyCount;
+	int32                              SectorCount;
+	int64                              Date;
+
+	TBitArray<>                        War;
+	TArray<uint8>                      SectorContracts;
+	TArray<uint8>                      HuntContracts;
+	TArray<uint8>                      StickyHuntContracts;
+
+};
@@ -121,7 +121,7 @@ void AFlarePlanetarium::Tick(float DeltaSeconds)
 				// Draw Player
 				const FFlareSectorOrbitParameters* PlayerOrbit = GetGame()->GetActiveSector()->GetSimulatedSector()->GetOrbitParameters();
 				
-				FFlareCelestialBody* CurrentParent = World->GetPlanerarium()->FindCelestialBody(PlayerOrbit->CelestialBodyIdentifier);
+				FFlareCelestialBody* CurrentParent = World->GetPlanerarium()->FindOrbitCelestialBody(PlayerOrbit);
 				if (CurrentParent)
 				{
 					FPreciseVector ParentLocation = CurrentParent->AbsoluteLocation;
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Object.h"
+
+
+/** Production, consumption and stock of a resource, in a sector or in the world */
+struct FFlareResourceStats
+{
+	float Production;
+	float Consumption;
+	float Balance;
+	int32 Stock;
+	int32 Capacity;
+
+	FFlareResourceStats()
+		: Production(0)
+		, Consumption(0)
+		, Balance(0)
+		, Stock(0)
+		, Capacity(0)
+	{
+	}
+};
+
+
+/** Resource stats indexed by FFlareResourceDescription::Index, with and without storage stations.
+ * Each variant is valid for the world date it was computed on, until invalidated. */
+struct FFlareResourceStatsCache
+{
+public:
+
+	FFlareResourceStatsCache()
+	{
+		Invalidate();
+	}
+
+	/** Forget both variants */
+	inline void Invalidate()
+	{
+		Dates[0] = -1;
+		Dates[1] = -1;
+	}
+
+	/** Get the stats computed on this date, or NULL */
+	inline const TArray<FFlareResourceStats>* Find(bool IncludeStorage, int64 Date) const
+	{
+		return (Dates[IncludeStorage] == Date) ? &Stats[IncludeStorage] : NULL;
+	}
+
+	/** Get cleared stats to fill, they are valid for this date once the call returns */
+	inline TArray<FFlareResourceStats>& Update(bool IncludeStorage, int64 Date, int32 ResourceCount)
+	{
+		TArray<FFlareResourceStats>& Result = Stats[IncludeStorage];
+		Result.Reset(ResourceCount);
+		Result.SetNum(ResourceCount);
+		Dates[IncludeStorage] = Date;
+		return Result;
+	}
+
+
+protected:
+
+	TArray<FFlareResourceStats>        Stats[2];
+	int64                              Dates[2];
+
+};
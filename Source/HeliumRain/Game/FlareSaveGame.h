@@ -116,6 +116,46 @@ struct FFlarePlayerSave
 	TArray<FName> UnlockedScannables;
 };
 
+/** Save summary, stored next to the save so that the slot menu doesn't need to load it */
+USTRUCT()
+struct FFlareSaveSlotHeader
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** Unique identifier of the game */
+	UPROPERTY(EditAnywhere, Category = Save)
+	FName UUID;
+
+	/** The player company was found in the save */
+	UPROPERTY(EditAnywhere, Category = Save)
+	bool HasPlayerCompany;
+
+	UPROPERTY(EditAnywhere, Category = Save)
+	FText CompanyName;
+
+	UPROPERTY(EditAnywhere, Category = Save)
+	int32 CompanyShipCount;
+
+	UPROPERTY(EditAnywhere, Category = Save)
+	int64 CompanyValue;
+
+	/** Emblem */
+	UPROPERTY(EditAnywhere, Category = Save)
+	int32 PlayerEmblemIndex;
+
+	UPROPERTY(EditAnywhere, Category = Save)
+	FLinearColor CustomizationBasePaintColor;
+
+	UPROPERTY(EditAnywhere, Category = Save)
+	FLinearColor CustomizationPaintColor;
+
+	UPROPERTY(EditAnywhere, Category = Save)
+	FLinearColor CustomizationOverlayColor;
+
+	UPROPERTY(EditAnywhere, Category = Save)
+	FLinearColor CustomizationLightColor;
+};
+
 
 UCLASS()
 class UFlareSaveGame : public USaveGame
@@ -7,12 +7,18 @@
 #include "FlareSimulatedSector.h"
 #include "FlareCollider.h"
 
+#include "Engine/StaticMeshActor.h"
+
 #include "../Player/FlarePlayerController.h"
 
 #include "../Spacecrafts/FlareShell.h"
 #include "../Spacecrafts/FlareSpacecraft.h"
 
 
+/** Shells spawned in the pool when the sector is loaded */
+#define SHELL_POOL_PREWARM_SIZE 128
+
+
 /*----------------------------------------------------
 	Constructor
 ----------------------------------------------------*/
@@ -22,6 +28,9 @@ UFlareSector::UFlareSector(const FObjectInitializer& ObjectInitializer)
 {
 	SectorRepartitionCache = false;
 	IsDestroyingSector = false;
+	FMemory::Memzero(ShellPoolStats);
+	SpatialIndexFrame = 0;
+	SpatialIndexDirty = true;
 }
 
 /*----------------------------------------------------
@@ -76,6 +85,10 @@ void UFlareSector::Load(UFlareSimulatedSector* Parent)
 	{
 		LoadBomb(ParentSector->GetData()->BombData[i]);
 	}
+
+	// Spawn shells ahead of the first shots
+	FMemory::Memzero(ShellPoolStats);
+	PrewarmShellPool(SHELL_POOL_PREWARM_SIZE);
 }
 
 void UFlareSector::Save()
@@ -137,6 +150,14 @@ void UFlareSector::DestroySector()
 		SectorShells[ShellIndex]->Destroy();
 	}
 
+	for (AFlareShell* Shell : ShellPool)
+	{
+		if (IsValid(Shell))
+		{
+			Shell->Destroy();
+		}
+	}
+
 	SectorSpacecrafts.Empty();
 	SectorShips.Empty();
 	SectorStations.Empty();
@@ -144,10 +165,22 @@ void UFlareSector::DestroySector()
 	SectorAsteroids.Empty();
 	SectorMeteorites.Empty();
 	SectorShells.Empty();
+	ShellPool.Empty();
+	ShellSystem.Reset();
+
+	SpatialIndex.Reset();
+	BombsByTarget.Reset();
+	StaticObstacles.Empty();
+	InvalidateSpatialIndex();
 
 	IsDestroyingSector = false;
 }
 
+void UFlareSector::Tick(float DeltaSeconds)
+{
+	ShellSystem.Tick(this, DeltaSeconds);
+}
+
 
 /*----------------------------------------------------
 	Gameplay
@@ -163,6 +196,7 @@ AFlareAsteroid* UFlareSector::LoadAsteroid(const FFlareAsteroidSave& AsteroidDat
     Asteroid->Load(AsteroidData);
 
 	SectorAsteroids.AddUnique(Asteroid);
+	InvalidateSpatialIndex();
     return Asteroid;
 }
 
@@ -176,6 +210,7 @@ AFlareMeteorite* UFlareSector::LoadMeteorite(FFlareMeteoriteSave& MeteoriteData)
 	Meteorite->Load(&MeteoriteData, this);
 
 	SectorMeteorites.AddUnique(Meteorite);
+	InvalidateSpatialIndex();
 	return Meteorite;
 }
 
@@ -216,6 +251,7 @@ AFlareSpacecraft* UFlareSector::LoadSpacecraft(UFlareSimulatedSpacecraft* Parent
 			SectorShips.Add(Spacecraft);
 		}
 		SectorSpacecrafts.Add(Spacecraft);
+		InvalidateSpatialIndex();
 
 		switch (ParentSpacecraft->GetData().SpawnMode)
 		{
@@ -422,6 +458,7 @@ AFlareBomb* UFlareSector::LoadBomb(const FFlareBombSave& BombData)
                 RootComponent->SetPhysicsAngularVelocityInDegrees(BombData.AngularVelocity, false);
 
 				SectorBombs.Add(Bomb);
+				InvalidateSpatialIndex();
             }
             else
             {
@@ -444,6 +481,7 @@ AFlareBomb* UFlareSector::LoadBomb(const FFlareBombSave& BombData)
 void UFlareSector::RegisterBomb(AFlareBomb* Bomb)
 {
 	SectorBombs.AddUnique(Bomb);
+	InvalidateSpatialIndex();
 }
 
 void UFlareSector::UnregisterBomb(AFlareBomb* Bomb)
@@ -451,6 +489,7 @@ void UFlareSector::UnregisterBomb(AFlareBomb* Bomb)
 	if (!IsDestroyingSector)
 	{
 		SectorBombs.Remove(Bomb);
+		InvalidateSpatialIndex();
 	}
 
 	for (AFlareSpacecraft* Spacecraft : SectorSpacecrafts)
@@ -462,6 +501,8 @@ void UFlareSector::UnregisterBomb(AFlareBomb* Bomb)
 void UFlareSector::RegisterShell(AFlareShell* Shell)
 {
 	SectorShells.AddUnique(Shell);
+	ShellSystem.Add(Shell);
+	ShellPoolStats.PeakActiveCount = FMath::Max(ShellPoolStats.PeakActiveCount, SectorShells.Num());
 }
 
 void UFlareSector::UnregisterShell(AFlareShell* Shell)
@@ -469,7 +510,66 @@ void UFlareSector::UnregisterShell(AFlareShell* Shell)
 	if (!IsDestroyingSector)
 	{
 		SectorShells.Remove(Shell);
+		ShellSystem.Remove(Shell);
+	}
+}
+
+AFlareShell* UFlareSector::AcquireShell(FVector Location, const FActorSpawnParameters& Params)
+{
+	AFlareShell* Shell = NULL;
+
+	while (!Shell && ShellPool.Num() > 0)
+	{
+		AFlareShell* Candidate = ShellPool.Pop(false);
+		if (IsValid(Candidate))
+		{
+			Shell = Candidate;
+		}
+	}
+
+	if (Shell)
+	{
+		ShellPoolStats.Hits++;
+		Shell->SetActorLocationAndRotation(Location, FRotator::ZeroRotator);
+		Shell->Instigator = Params.Instigator;
 	}
+	else
+	{
+		ShellPoolStats.Misses++;
+		Shell = GetGame()->GetWorld()->SpawnActor<AFlareShell>(AFlareShell::StaticClass(), Location, FRotator::ZeroRotator, Params);
+	}
+
+	Shell->SetPooled(false);
+	return Shell;
+}
+
+void UFlareSector::ReleaseShell(AFlareShell* Shell)
+{
+	UnregisterShell(Shell);
+	Shell->SetPooled(true);
+
+	if (!IsDestroyingSector)
+	{
+		ShellPool.Add(Shell);
+		ShellPoolStats.PeakPooledCount = FMath::Max(ShellPoolStats.PeakPooledCount, ShellPool.Num());
+	}
+}
+
+void UFlareSector::PrewarmShellPool(int32 Count)
+{
+	FActorSpawnParameters Params;
+	Params.bNoFail = true;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	ShellPool.Reserve(ShellPool.Num() + Count);
+	for (int32 Index = 0; Index < Count; Index++)
+	{
+		AFlareShell* Shell = GetGame()->GetWorld()->SpawnActor<AFlareShell>(AFlareShell::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator, Params);
+		Shell->SetPooled(true);
+		ShellPool.Add(Shell);
+	}
+
+	ShellPoolStats.PeakPooledCount = FMath::Max(ShellPoolStats.PeakPooledCount, ShellPool.Num());
 }
 
 void UFlareSector::SetPause(bool Pause)
@@ -498,54 +598,45 @@ void UFlareSector::SetPause(bool Pause)
 	{
 		SectorShells[i]->SetPause(Pause);
 	}
+
+	ShellSystem.SetPause(Pause);
 }
 
 
 AActor* UFlareSector::GetNearestBody(FVector Location, float* NearestDistance, bool IncludeSize, AActor* ActorToIgnore)
 {
+	const FFlareSectorSpatialIndex& Index = GetSpatialIndex();
+	int32 TypeMask = EFlareSpatialEntry::Spacecraft | EFlareSpatialEntry::Asteroid | EFlareSpatialEntry::Collider;
+
 	AActor* NearestCandidateActor = NULL;
 	float NearestCandidateActorDistance = 0;
 
-	for (int32 SpacecraftIndex = 0; SpacecraftIndex < SectorSpacecrafts.Num(); SpacecraftIndex++)
-	{
-		AFlareSpacecraft* SpacecraftCandidate = GetSpacecrafts()[SpacecraftIndex];
-		float Distance = FVector::Dist(SpacecraftCandidate->GetActorLocation(), Location) - SpacecraftCandidate->GetMeshScale();
-		if (SpacecraftCandidate != ActorToIgnore && (!NearestCandidateActor || NearestCandidateActorDistance > Distance))
-		{
-			NearestCandidateActor = SpacecraftCandidate;
-			NearestCandidateActorDistance = Distance;
-		}
-	}
+	// Search in growing spheres : a body found inside the sphere can't be beaten by one outside it
+	TArray<int32> Candidates;
+	float SearchRadius = 100000; // 1km
 
-	for (int32 AsteroidIndex = 0; AsteroidIndex < GetAsteroids().Num(); AsteroidIndex++)
+	while (true)
 	{
-		AFlareAsteroid* AsteroidCandidate = GetAsteroids()[AsteroidIndex];
+		Index.QueryRadius(Location, SearchRadius, TypeMask, Candidates, true);
 
-		FBox CandidateBox = AsteroidCandidate->GetComponentsBoundingBox();
-		float CandidateSize = FMath::Max(CandidateBox.GetExtent().Size(), 1.0f);
-
-		float Distance = FVector::Dist(AsteroidCandidate->GetActorLocation(), Location) - CandidateSize;
-		if (AsteroidCandidate != ActorToIgnore && (!NearestCandidateActor || NearestCandidateActorDistance > Distance))
+		for (int32 CandidateIndex : Candidates)
 		{
-			NearestCandidateActor = AsteroidCandidate;
-			NearestCandidateActorDistance = Distance;
-		}
-	}
+			const FFlareSpatialEntry& Candidate = Index.GetEntry(CandidateIndex);
 
-	TArray<AActor*> ColliderActorList;
-	UGameplayStatics::GetAllActorsOfClass(GetGame()->GetWorld(), AFlareCollider::StaticClass(), ColliderActorList);
-	for (int32 ColliderIndex = 0; ColliderIndex < ColliderActorList.Num(); ColliderIndex++)
-	{
-		AActor* ColliderCandidate = ColliderActorList[ColliderIndex];
-
-		float CandidateSize = Cast<UStaticMeshComponent>(ColliderCandidate->GetRootComponent())->Bounds.SphereRadius;
+			float Distance = FVector::Dist(Candidate.Actor->GetActorLocation(), Location) - Candidate.Radius;
+			if (Candidate.Actor != ActorToIgnore && (!NearestCandidateActor || NearestCandidateActorDistance > Distance))
+			{
+				NearestCandidateActor = Candidate.Actor;
+				NearestCandidateActorDistance = Distance;
+			}
+		}
 
-		float Distance = FVector::Dist(ColliderCandidate->GetActorLocation(), Location) - CandidateSize;
-		if (ColliderCandidate != ActorToIgnore && (!NearestCandidateActor || NearestCandidateActorDistance > Distance))
+		if ((NearestCandidateActor && NearestCandidateActorDistance <= SearchRadius) || Index.CoversAll(Location, SearchRadius))
 		{
-			NearestCandidateActor = ColliderCandidate;
-			NearestCandidateActorDistance = Distance;
+			break;
 		}
+
+		SearchRadius *= 2;
 	}
 
 	*NearestDistance = NearestCandidateActorDistance;
@@ -597,6 +688,146 @@ void UFlareSector::PlaceSpacecraft(AFlareSpacecraft* Spacecraft, FVector Locatio
 #endif
 
 	Spacecraft->SetActorLocation(Location);
+	InvalidateSpatialIndex();
+}
+
+const FFlareSectorSpatialIndex& UFlareSector::GetSpatialIndex()
+{
+	if (SpatialIndexDirty || SpatialIndexFrame != GFrameCounter)
+	{
+		UpdateSpatialIndex();
+	}
+
+	return SpatialIndex;
+}
+
+void UFlareSector::InvalidateSpatialIndex()
+{
+	SpatialIndexDirty = true;
+}
+
+void UFlareSector::LoadStaticObstacles()
+{
+	StaticObstacles.Empty();
+
+	auto AddObstacle = [&](AActor* Actor, EFlareSpatialEntry::Type Type, float Radius, float BoundsRadius)
+	{
+		FFlareSpatialEntry Obstacle;
+		Obstacle.Actor = Actor;
+		Obstacle.Type = Type;
+		Obstacle.Location = Actor->GetActorLocation();
+		Obstacle.Velocity = FVector::ZeroVector;
+		Obstacle.Radius = Radius;
+		Obstacle.BoundsRadius = BoundsRadius;
+		StaticObstacles.Add(Obstacle);
+	};
+
+	TArray<AActor*> ColliderActorList;
+	UGameplayStatics::GetAllActorsOfClass(GetGame()->GetWorld(), AFlareCollider::StaticClass(), ColliderActorList);
+	for (AActor* Collider : ColliderActorList)
+	{
+		const FBoxSphereBounds& Bounds = Cast<UStaticMeshComponent>(Collider->GetRootComponent())->Bounds;
+		AddObstacle(Collider, EFlareSpatialEntry::Collider, Bounds.SphereRadius, (Bounds.Origin - Collider->GetActorLocation()).Size() + Bounds.SphereRadius);
+	}
+
+	// Other colliding meshes, like debris, only matter to projectiles
+	// The sphere around the actor location that contains the bounding box still contains it once the actor has rotated
+	TArray<AActor*> ObstacleActorList;
+	UGameplayStatics::GetAllActorsOfClass(GetGame()->GetWorld(), AStaticMeshActor::StaticClass(), ObstacleActorList);
+	for (AActor* Obstacle : ObstacleActorList)
+	{
+		FBox Box = Obstacle->GetComponentsBoundingBox();
+		AddObstacle(Obstacle, EFlareSpatialEntry::Obstacle, Box.GetExtent().Size(), (Box.GetCenter() - Obstacle->GetActorLocation()).Size() + Box.GetExtent().Size());
+	}
+
+	FLOGV("UFlareSector::LoadStaticObstacles : %d obstacles", StaticObstacles.Num());
+	InvalidateSpatialIndex();
+}
+
+int32 UFlareSector::GetIncomingBombCount(AFlareSpacecraft* Target)
+{
+	GetSpatialIndex();
+
+	TArray<AFlareBomb*> Bombs;
+	BombsByTarget.MultiFind(Target, Bombs);
+
+	int32 Count = 0;
+	for (AFlareBomb* Bomb : Bombs)
+	{
+		if (Bomb->GetTargetSpacecraft() == Target && Bomb->IsActive())
+		{
+			Count++;
+		}
+	}
+
+	return Count;
+}
+
+void UFlareSector::UpdateSpatialIndex()
+{
+	SpatialIndex.Reset();
+	BombsByTarget.Reset();
+
+	// Sphere around the actor location that contains the whole bounding box
+	auto GetBoundsRadius = [](AActor* Actor, const FBox& Box)
+	{
+		return (Box.GetCenter() - Actor->GetActorLocation()).Size() + Box.GetExtent().Size();
+	};
+
+	// Entries are added in the order the helpers used to scan the lists
+	for (AFlareSpacecraft* Spacecraft : SectorSpacecrafts)
+	{
+		FBox Box = Spacecraft->GetComponentsBoundingBox();
+		SpatialIndex.Add(Spacecraft, EFlareSpatialEntry::Spacecraft, Spacecraft->GetActorLocation(),
+			Spacecraft->Airframe->GetPhysicsLinearVelocity(), Spacecraft->GetMeshScale(), GetBoundsRadius(Spacecraft, Box));
+	}
+
+	for (AFlareAsteroid* Asteroid : SectorAsteroids)
+	{
+		FBox Box = Asteroid->GetComponentsBoundingBox();
+		SpatialIndex.Add(Asteroid, EFlareSpatialEntry::Asteroid, Asteroid->GetActorLocation(),
+			Asteroid->GetAsteroidComponent()->GetPhysicsLinearVelocity(), FMath::Max(Box.GetExtent().Size(), 1.0f), GetBoundsRadius(Asteroid, Box));
+	}
+
+	for (AFlareMeteorite* Meteorite : SectorMeteorites)
+	{
+		FBox Box = Meteorite->GetComponentsBoundingBox();
+		SpatialIndex.Add(Meteorite, EFlareSpatialEntry::Meteorite, Meteorite->GetActorLocation(),
+			Meteorite->GetMeteoriteComponent()->GetPhysicsLinearVelocity(), FMath::Max(Box.GetExtent().Size(), 1.0f), GetBoundsRadius(Meteorite, Box));
+	}
+
+	for (AFlareBomb* Bomb : SectorBombs)
+	{
+		FBox Box = Bomb->GetComponentsBoundingBox();
+		UPrimitiveComponent* RootComponent = Cast<UPrimitiveComponent>(Bomb->GetRootComponent());
+		SpatialIndex.Add(Bomb, EFlareSpatialEntry::Bomb, Bomb->GetActorLocation(),
+			RootComponent->GetPhysicsLinearVelocity(), FMath::Max(Box.GetExtent().Size(), 1.0f), GetBoundsRadius(Bomb, Box));
+
+		if (Bomb->GetTargetSpacecraft())
+		{
+			BombsByTarget.Add(Bomb->GetTargetSpacecraft(), Bomb);
+		}
+	}
+
+	// Colliders and debris keep their size, only their location and velocity change
+	for (const FFlareSpatialEntry& Obstacle : StaticObstacles)
+	{
+		if (IsValid(Obstacle.Actor) && Obstacle.Actor->GetActorEnableCollision())
+		{
+			FVector Velocity = FVector::ZeroVector;
+			if (Obstacle.Type == EFlareSpatialEntry::Obstacle)
+			{
+				UPrimitiveComponent* RootComponent = Cast<UPrimitiveComponent>(Obstacle.Actor->GetRootComponent());
+				Velocity = (RootComponent ? RootComponent->GetPhysicsLinearVelocity() : FVector::ZeroVector);
+			}
+
+			SpatialIndex.Add(Obstacle.Actor, Obstacle.Type, Obstacle.Actor->GetActorLocation(), Velocity, Obstacle.Radius, Obstacle.BoundsRadius);
+		}
+	}
+
+	SpatialIndex.Build(GetGame()->GetWorld()->GetDeltaSeconds());
+	SpatialIndexFrame = GFrameCounter;
+	SpatialIndexDirty = false;
 }
 
 /*----------------------------------------------------
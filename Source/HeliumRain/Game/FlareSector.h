@@ -6,12 +6,32 @@
 #include "FlareAsteroid.h"
 #include "../Quests/FlareMeteorite.h"
 #include "FlareSimulatedSector.h"
+#include "FlareSectorSpatialIndex.h"
+#include "../Spacecrafts/FlareShellSystem.h"
 #include "FlareSector.generated.h"
 
 class UFlareSimulatedSector;
 class AFlareGame;
 class AFlareAsteroid;
 
+
+/** Shell pool usage, to size the pool for large battles */
+struct FFlareShellPoolStats
+{
+	/** Shells taken from the pool */
+	int32 Hits;
+
+	/** Shells spawned because the pool was empty */
+	int32 Misses;
+
+	/** Most shells in flight at the same time */
+	int32 PeakActiveCount;
+
+	/** Most shells waiting in the pool at the same time */
+	int32 PeakPooledCount;
+};
+
+
 UCLASS()
 class HELIUMRAIN_API UFlareSector : public UObject
 {
@@ -32,6 +52,9 @@ public:
 	/** Destroy the sector */
 	virtual void DestroySector();
 
+	/** Advance the shells in flight */
+	void Tick(float DeltaSeconds);
+
 
 	/*----------------------------------------------------
 		Gameplay
@@ -53,14 +76,38 @@ public:
 
 	void UnregisterShell(AFlareShell* Shell);
 
+	/** Get a shell from the pool, or spawn one if the pool is empty. The shell must then be initialized */
+	AFlareShell* AcquireShell(FVector Location, const FActorSpawnParameters& Params);
+
+	/** Stop a shell and keep it in the pool for a later shot */
+	void ReleaseShell(AFlareShell* Shell);
+
+	/** Spawn stopped shells into the pool */
+	void PrewarmShellPool(int32 Count);
+
 	virtual void SetPause(bool Pause);
 
 	AActor* GetNearestBody(FVector Location, float* NearestDistance, bool IncludeSize = true, AActor* ActorToIgnore = NULL);
 
 	void PlaceSpacecraft(AFlareSpacecraft* Spacecraft, FVector Location);
 
+	/** Get the spatial index of the sector actors, rebuilt on the first query of each frame */
+	const FFlareSectorSpatialIndex& GetSpatialIndex();
+
+	/** Force the spatial index to be rebuilt on the next query, after actors were added, removed or moved */
+	void InvalidateSpatialIndex();
+
+	/** Collect the level colliders and debris once the sector is set up, the spatial index only refreshes their location */
+	void LoadStaticObstacles();
+
+	/** Count the active bombs targeting a spacecraft */
+	int32 GetIncomingBombCount(AFlareSpacecraft* Target);
+
 protected:
 
+	/** Build the spatial index from the current actor lists */
+	void UpdateSpatialIndex();
+
 	/*----------------------------------------------------
 		Protected data
 	----------------------------------------------------*/
@@ -87,12 +134,25 @@ protected:
 	UPROPERTY()
 	TArray<AFlareShell*>           SectorShells;
 
+	/** Stopped shells, ready to be fired again */
+	UPROPERTY()
+	TArray<AFlareShell*>           ShellPool;
+	FFlareShellPoolStats           ShellPoolStats;
+	FFlareShellSystem              ShellSystem;
+
 	int64						   LocalTime;
 	bool						   SectorRepartitionCache;
 	bool                           IsDestroyingSector;
 	FVector                        SectorCenter;
 	float                          SectorRadius;
 
+	// Spatial index
+	FFlareSectorSpatialIndex       SpatialIndex;
+	TMultiMap<AFlareSpacecraft*, AFlareBomb*> BombsByTarget;
+	TArray<FFlareSpatialEntry>     StaticObstacles;
+	uint64                         SpatialIndexFrame;
+	bool                           SpatialIndexDirty;
+
 
 public:
 
@@ -161,6 +221,21 @@ public:
 		return SectorBombs;
 	}
 
+	inline const FFlareShellPoolStats& GetShellPoolStats() const
+	{
+		return ShellPoolStats;
+	}
+
+	inline int32 GetPooledShellCount() const
+	{
+		return ShellPool.Num();
+	}
+
+	inline FFlareShellSystem& GetShellSystem()
+	{
+		return ShellSystem;
+	}
+
 	inline int64 GetLocalTime()
 	{
 		return LocalTime;
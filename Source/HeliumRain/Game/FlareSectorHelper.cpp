@@ -18,6 +18,7 @@
 
 DECLARE_CYCLE_STAT(TEXT("FlareSectorHelper RepairFleets"), STAT_FlareSectorHelper_RepairFleets, STATGROUP_Flare);
 DECLARE_CYCLE_STAT(TEXT("FlareSectorHelper RefillFleets"), STAT_FlareSectorHelper_RefillFleets, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareSectorHelper ComputeSectorResourceStats"), STAT_FlareSectorHelper_ComputeSectorResourceStats, STATGROUP_Flare);
 
 
 UFlareSimulatedSpacecraft*  SectorHelper::FindTradeStation(FlareTradeRequest Request)
@@ -935,23 +936,13 @@ int32 SectorHelper::GetCompanyArmyCombatPoints(UFlareSimulatedSector* Sector, UF
 }
 
 
-TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::ComputeSectorResourceStats(UFlareSimulatedSector* Sector, bool IncludeStorage)
+void SectorHelper::ComputeSectorResourceStats(UFlareSimulatedSector* Sector, bool IncludeStorage, TArray<WorldHelper::FlareResourceStats>& OutStats)
 {
-	TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> WorldStats;
+	SCOPE_CYCLE_COUNTER(STAT_FlareSectorHelper_ComputeSectorResourceStats);
 
 	// Init
-	for(int32 ResourceIndex = 0; ResourceIndex < Sector->GetGame()->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
-	{
-		FFlareResourceDescription* Resource = &Sector->GetGame()->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-		WorldHelper::FlareResourceStats ResourceStats;
-		ResourceStats.Production = 0;
-		ResourceStats.Consumption = 0;
-		ResourceStats.Balance = 0;
-		ResourceStats.Stock = 0;
-		ResourceStats.Capacity = 0;
-
-		WorldStats.Add(Resource, ResourceStats);
-	}
+	OutStats.Reset(Sector->GetGame()->GetResourceCatalog()->Resources.Num());
+	OutStats.SetNum(Sector->GetGame()->GetResourceCatalog()->Resources.Num());
 
 	for (int SpacecraftIndex = 0; SpacecraftIndex < Sector->GetSectorSpacecrafts().Num(); SpacecraftIndex++)
 	{
@@ -973,7 +964,7 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::
 				continue;
 			}
 
-			WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Cargo.Resource];
+			WorldHelper::FlareResourceStats *ResourceStats = &OutStats[Cargo.Resource->Index];
 
 			FFlareResourceUsage Usage = Spacecraft->GetResourceUseType(Cargo.Resource);
 
@@ -1001,7 +992,7 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::
 					for(const FFlareFactoryResource& FactoryResource : ProductionData->InputResources)
 					{
 						const FFlareResourceDescription* Resource = &FactoryResource.Resource->Data;
-						WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Resource];
+						WorldHelper::FlareResourceStats *ResourceStats = &OutStats[Resource->Index];
 
 						int64 ProductionDuration = ProductionData->ProductionTime;
 
@@ -1033,7 +1024,7 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::
 			for (int32 ResourceIndex = 0; ResourceIndex < Factory->GetInputResourcesCount(); ResourceIndex++)
 			{
 				FFlareResourceDescription* Resource = Factory->GetInputResource(ResourceIndex);
-				WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Resource];
+				WorldHelper::FlareResourceStats *ResourceStats = &OutStats[Resource->Index];
 
 				int64 ProductionDuration = Factory->GetProductionDuration();
 
@@ -1055,7 +1046,7 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::
 			for (int32 ResourceIndex = 0; ResourceIndex < Factory->GetOutputResourcesCount(); ResourceIndex++)
 			{
 				FFlareResourceDescription* Resource = Factory->GetOutputResource(ResourceIndex);
-				WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Resource];
+				WorldHelper::FlareResourceStats *ResourceStats = &OutStats[Resource->Index];
 
 				int64 ProductionDuration = Factory->GetProductionDuration();
 				if (ProductionDuration == 0)
@@ -1071,7 +1062,7 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::
 
 	// FS
 	FFlareResourceDescription* FleetSupply = Sector->GetGame()->GetScenarioTools()->FleetSupply;
-	WorldHelper::FlareResourceStats *FSResourceStats = &WorldStats[FleetSupply];
+	WorldHelper::FlareResourceStats *FSResourceStats = &OutStats[FleetSupply->Index];
 	FFlareFloatBuffer* Stats = &Sector->GetData()->FleetSupplyConsumptionStats;
 	float MeanConsumption = Stats->GetMean(0, Stats->MaxSize-1);
 	FSResourceStats->Consumption += MeanConsumption;
@@ -1082,7 +1073,7 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::
 	for (int32 ResourceIndex = 0; ResourceIndex < Sector->GetGame()->GetResourceCatalog()->ConsumerResources.Num(); ResourceIndex++)
 	{
 		FFlareResourceDescription* Resource = &Sector->GetGame()->GetResourceCatalog()->ConsumerResources[ResourceIndex]->Data;
-		WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Resource];
+		WorldHelper::FlareResourceStats *ResourceStats = &OutStats[Resource->Index];
 
 		ResourceStats->Consumption += Sector->GetPeople()->GetRessourceConsumption(Resource, false);
 	}
@@ -1091,7 +1082,7 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::
 	for(int32 ResourceIndex = 0; ResourceIndex < Sector->GetGame()->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
 	{
 		FFlareResourceDescription* Resource = &Sector->GetGame()->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-		WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Resource];
+		WorldHelper::FlareResourceStats *ResourceStats = &OutStats[Resource->Index];
 
 		ResourceStats->Balance = ResourceStats->Production - ResourceStats->Consumption;
 
@@ -1102,7 +1093,4 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::
 			  ResourceStats->Balance,
 			  ResourceStats->Stock);*/
 	}
-
-	return WorldStats;
-
 }
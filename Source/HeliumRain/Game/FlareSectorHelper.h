@@ -52,7 +52,8 @@ struct SectorHelper
 
 	static int32 GetCompanyArmyCombatPoints(UFlareSimulatedSector* Sector, UFlareCompany* Company, bool ReduceByDamage);
 
-	static TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> ComputeSectorResourceStats(UFlareSimulatedSector* Sector, bool IncludeStorage);
+	/** Compute the resource stats of a sector, by resource index. Use UFlareSimulatedSector::GetResourceStats for the cached result */
+	static void ComputeSectorResourceStats(UFlareSimulatedSector* Sector, bool IncludeStorage, TArray<WorldHelper::FlareResourceStats>& OutStats);
 
 	static int64 GetSellResourcePrice(UFlareSimulatedSector* Sector, FFlareResourceDescription* Resource, FFlareResourceUsage Usage);
 
@@ -0,0 +1,256 @@
+
+#include "FlareSectorSpatialIndex.h"
+#include "../Flare.h"
+
+
+DECLARE_CYCLE_STAT(TEXT("FlareSectorSpatialIndex Build"), STAT_FlareSectorSpatialIndex_Build, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareSectorSpatialIndex QueryRadius"), STAT_FlareSectorSpatialIndex_QueryRadius, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareSectorSpatialIndex QuerySegment"), STAT_FlareSectorSpatialIndex_QuerySegment, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareSectorSpatialIndex QueryCone"), STAT_FlareSectorSpatialIndex_QueryCone, STATGROUP_Flare);
+
+/** Size of a grid cell, in cm */
+#define SPATIAL_INDEX_CELL_SIZE 100000.f
+
+/** Above this many cells, a query scans the entries instead of the grid */
+#define SPATIAL_INDEX_MAX_QUERY_CELLS 4096
+
+
+/*----------------------------------------------------
+	Constructor
+----------------------------------------------------*/
+
+FFlareSectorSpatialIndex::FFlareSectorSpatialIndex()
+{
+	Reset();
+}
+
+
+/*----------------------------------------------------
+	Build
+----------------------------------------------------*/
+
+void FFlareSectorSpatialIndex::Reset()
+{
+	Entries.Reset();
+	Cells.Reset();
+	Bounds = FBox(ForceInit);
+	MaxRadius = 0;
+	MaxBoundsRadius = 0;
+	MaxSpeed = 0;
+	Slack = 0;
+}
+
+void FFlareSectorSpatialIndex::Add(AActor* Actor, EFlareSpatialEntry::Type Type, FVector Location, FVector Velocity, float Radius, float BoundsRadius)
+{
+	FFlareSpatialEntry Entry;
+	Entry.Actor = Actor;
+	Entry.Type = Type;
+	Entry.Location = Location;
+	Entry.Velocity = Velocity;
+	Entry.Radius = Radius;
+	Entry.BoundsRadius = BoundsRadius;
+	Entries.Add(Entry);
+}
+
+void FFlareSectorSpatialIndex::Build(float DeltaSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareSectorSpatialIndex_Build);
+
+	Cells.Reset();
+	Bounds = FBox(ForceInit);
+	MaxRadius = 0;
+	MaxBoundsRadius = 0;
+	MaxSpeed = 0;
+
+	for (int32 Index = 0; Index < Entries.Num(); Index++)
+	{
+		const FFlareSpatialEntry& Entry = Entries[Index];
+
+		Cells.FindOrAdd(GetCell(Entry.Location)).Add(Index);
+		Bounds += Entry.Location;
+		MaxRadius = FMath::Max(MaxRadius, Entry.Radius);
+		MaxBoundsRadius = FMath::Max(MaxBoundsRadius, Entry.BoundsRadius);
+		MaxSpeed = FMath::Max(MaxSpeed, Entry.Velocity.Size());
+	}
+
+	// Twice the frame travel, to also cover the small corrections done on hits
+	Slack = 2 * MaxSpeed * DeltaSeconds;
+}
+
+
+/*----------------------------------------------------
+	Queries
+----------------------------------------------------*/
+
+void FFlareSectorSpatialIndex::QueryType(int32 TypeMask, TArray<int32>& OutEntries) const
+{
+	OutEntries.Reset();
+
+	for (int32 Index = 0; Index < Entries.Num(); Index++)
+	{
+		if (Entries[Index].Type & TypeMask)
+		{
+			OutEntries.Add(Index);
+		}
+	}
+}
+
+void FFlareSectorSpatialIndex::QueryRadius(FVector Center, float Radius, int32 TypeMask, TArray<int32>& OutEntries, bool IncludeSize) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareSectorSpatialIndex_QueryRadius);
+
+	OutEntries.Reset();
+	if (Radius < 0)
+	{
+		return;
+	}
+
+	float SearchRadius = Radius + Slack + (IncludeSize ? MaxRadius : 0);
+	FilterEntries(Center, SearchRadius, OutEntries, [&](const FFlareSpatialEntry& Entry)
+	{
+		float EntryRadius = Radius + Slack + (IncludeSize ? Entry.Radius : 0);
+		return (Entry.Type & TypeMask) && FVector::DistSquared(Entry.Location, Center) <= FMath::Square(EntryRadius);
+	});
+}
+
+void FFlareSectorSpatialIndex::QuerySegment(FVector Start, FVector End, int32 TypeMask, TArray<int32>& OutEntries) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareSectorSpatialIndex_QuerySegment);
+
+	OutEntries.Reset();
+
+	FVector Center = (Start + End) / 2;
+	float SearchRadius = (End - Start).Size() / 2 + Slack + MaxBoundsRadius;
+	FilterEntries(Center, SearchRadius, OutEntries, [&](const FFlareSpatialEntry& Entry)
+	{
+		float EntryRadius = Entry.BoundsRadius + Slack;
+		return (Entry.Type & TypeMask) && FMath::PointDistToSegmentSquared(Entry.Location, Start, End) <= FMath::Square(EntryRadius);
+	});
+}
+
+void FFlareSectorSpatialIndex::QueryCone(FVector Origin, FVector Axis, float MinAlignement, int32 TypeMask, TArray<int32>& OutEntries) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareSectorSpatialIndex_QueryCone);
+
+	OutEntries.Reset();
+
+	FVector ConeAxis = Axis.GetSafeNormal();
+	float ConeAngle = FMath::Acos(FMath::Clamp(MinAlignement, -1.f, 1.f));
+
+	for (int32 Index = 0; Index < Entries.Num(); Index++)
+	{
+		const FFlareSpatialEntry& Entry = Entries[Index];
+		if ((Entry.Type & TypeMask) == 0)
+		{
+			continue;
+		}
+
+		FVector Offset = Entry.Location - Origin;
+		float Distance = Offset.Size();
+
+		// Entries near the origin can be in any direction by the end of the frame
+		if (Distance <= Slack)
+		{
+			OutEntries.Add(Index);
+			continue;
+		}
+
+		// Without an axis, the alignement is zero
+		if (ConeAxis.IsZero())
+		{
+			if (MinAlignement < 0)
+			{
+				OutEntries.Add(Index);
+			}
+			continue;
+		}
+
+		// Widen the cone by the angle the entry can move during the frame
+		float MaxAngle = ConeAngle + FMath::Asin(Slack / Distance);
+		if (MaxAngle >= PI || FVector::DotProduct(Offset / Distance, ConeAxis) >= FMath::Cos(MaxAngle))
+		{
+			OutEntries.Add(Index);
+		}
+	}
+}
+
+bool FFlareSectorSpatialIndex::CoversAll(FVector Center, float Radius) const
+{
+	if (!Bounds.IsValid)
+	{
+		return true;
+	}
+
+	float FarthestDistance = (Bounds.GetCenter() - Center).Size() + Bounds.GetExtent().Size();
+	return FarthestDistance <= Radius + Slack;
+}
+
+
+/*----------------------------------------------------
+	Internal
+----------------------------------------------------*/
+
+FIntVector FFlareSectorSpatialIndex::GetCell(FVector Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt(Location.X / SPATIAL_INDEX_CELL_SIZE),
+		FMath::FloorToInt(Location.Y / SPATIAL_INDEX_CELL_SIZE),
+		FMath::FloorToInt(Location.Z / SPATIAL_INDEX_CELL_SIZE));
+}
+
+void FFlareSectorSpatialIndex::FilterEntries(FVector Center, float SearchRadius, TArray<int32>& OutEntries, TFunctionRef<bool(const FFlareSpatialEntry&)> Filter) const
+{
+	OutEntries.Reset();
+	if (Entries.Num() == 0)
+	{
+		return;
+	}
+
+	// Clip the search box to the entries
+	FBox SearchBox = FBox(Center - FVector(SearchRadius), Center + FVector(SearchRadius)).Overlap(Bounds);
+	if (!SearchBox.IsValid)
+	{
+		return;
+	}
+
+	FIntVector MinCell = GetCell(SearchBox.Min);
+	FIntVector MaxCell = GetCell(SearchBox.Max);
+	int64 CellCount = int64(MaxCell.X - MinCell.X + 1) * int64(MaxCell.Y - MinCell.Y + 1) * int64(MaxCell.Z - MinCell.Z + 1);
+
+	// Wide query, the entries are scanned in order
+	if (CellCount > FMath::Min(Cells.Num(), SPATIAL_INDEX_MAX_QUERY_CELLS))
+	{
+		for (int32 Index = 0; Index < Entries.Num(); Index++)
+		{
+			if (Filter(Entries[Index]))
+			{
+				OutEntries.Add(Index);
+			}
+		}
+		return;
+	}
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+			{
+				const TArray<int32>* Cell = Cells.Find(FIntVector(X, Y, Z));
+				if (Cell)
+				{
+					for (int32 Index : *Cell)
+					{
+						if (Filter(Entries[Index]))
+						{
+							OutEntries.Add(Index);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// Give the entries in the order they were added
+	OutEntries.Sort();
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "Object.h"
+
+
+class AActor;
+
+/** Kinds of actors stored in the sector spatial index, combined as a mask in queries */
+namespace EFlareSpatialEntry
+{
+	enum Type
+	{
+		Spacecraft = 1 << 0,
+		Asteroid   = 1 << 1,
+		Meteorite  = 1 << 2,
+		Bomb       = 1 << 3,
+		Collider   = 1 << 4,
+		Obstacle   = 1 << 5,
+		All        = 0x3F
+	};
+}
+
+/** Snapshot of an actor, taken when the index is built */
+struct FFlareSpatialEntry
+{
+	AActor*                   Actor;
+	EFlareSpatialEntry::Type  Type;
+	FVector                   Location;
+	FVector                   Velocity;
+
+	/** Gameplay size of the actor */
+	float                     Radius;
+
+	/** Sphere around Location that contains all the collision of the actor */
+	float                     BoundsRadius;
+};
+
+
+/** Uniform grid over the actors of the active sector.
+ * The index is a snapshot : queries are widened by the distance an actor can travel during the frame,
+ * so they return every entry that may match, in the order the entries were added. Callers run the exact test on the live actor. */
+struct FFlareSectorSpatialIndex
+{
+public:
+
+	FFlareSectorSpatialIndex();
+
+	/** Remove all entries */
+	void Reset();
+
+	/** Add an entry, Build must be called after the last one */
+	void Add(AActor* Actor, EFlareSpatialEntry::Type Type, FVector Location, FVector Velocity, float Radius, float BoundsRadius);
+
+	/** Fill the grid, DeltaSeconds is the duration the snapshot has to stay valid */
+	void Build(float DeltaSeconds);
+
+	/** Get all entries of some types */
+	void QueryType(int32 TypeMask, TArray<int32>& OutEntries) const;
+
+	/** Get entries whose location is within Radius of Center, or whose bounding sphere touches it if IncludeSize is set */
+	void QueryRadius(FVector Center, float Radius, int32 TypeMask, TArray<int32>& OutEntries, bool IncludeSize = false) const;
+
+	/** Get entries whose collision may cross the segment from Start to End */
+	void QuerySegment(FVector Start, FVector End, int32 TypeMask, TArray<int32>& OutEntries) const;
+
+	/** Get entries whose direction from Origin has a dot product with the normalized Axis above MinAlignement */
+	void QueryCone(FVector Origin, FVector Axis, float MinAlignement, int32 TypeMask, TArray<int32>& OutEntries) const;
+
+	/** Check if a radius query around Center returns every entry, to stop an expanding search */
+	bool CoversAll(FVector Center, float Radius) const;
+
+
+protected:
+
+	/*----------------------------------------------------
+		Internal
+	----------------------------------------------------*/
+
+	FIntVector GetCell(FVector Location) const;
+
+	/** Get the entries located within SearchRadius of Center that pass Filter, in the order they were added */
+	void FilterEntries(FVector Center, float SearchRadius, TArray<int32>& OutEntries, TFunctionRef<bool(const FFlareSpatialEntry&)> Filter) const;
+
+
+	/*----------------------------------------------------
+		Data
+	----------------------------------------------------*/
+
+	TArray<FFlareSpatialEntry>         Entries;
+	TMap<FIntVector, TArray<int32>>    Cells;
+	FBox                               Bounds;
+	float                              MaxRadius;
+	float                              MaxBoundsRadius;
+	float                              MaxSpeed;
+	float                              Slack;
+
+
+public:
+
+	/*----------------------------------------------------
+		Getters
+	----------------------------------------------------*/
+
+	inline int32 GetEntryCount() const
+	{
+		return Entries.Num();
+	}
+
+	inline const FFlareSpatialEntry& GetEntry(int32 Index) const
+	{
+		return Entries[Index];
+	}
+
+	/** Fastest entry of the snapshot, in cm/s */
+	inline float GetMaxSpeed() const
+	{
+		return MaxSpeed;
+	}
+
+	/** Margin added to every query, in cm */
+	inline float GetSlack() const
+	{
+		return Slack;
+	}
+
+};
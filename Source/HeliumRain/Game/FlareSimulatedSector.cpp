@@ -28,6 +28,7 @@
 DECLARE_CYCLE_STAT(TEXT("FlareSector SimulatePriceVariation"), STAT_FlareSector_SimulatePriceVariation, STATGROUP_Flare);
 DECLARE_CYCLE_STAT(TEXT("FlareSector GetSectorFriendlyness"), STAT_FlareSector_GetSectorFriendlyness, STATGROUP_Flare);
 DECLARE_CYCLE_STAT(TEXT("FlareSector GetSectorBattleState"), STAT_FlareSector_GetSectorBattleState, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareSector UpdateBattleCounters"), STAT_FlareSector_UpdateBattleCounters, STATGROUP_Flare);
 
 #define FLEET_SUPPLY_CONSUMPTION_STATS 50
 
@@ -42,6 +43,8 @@ UFlareSimulatedSector::UFlareSimulatedSector(const FObjectInitializer& ObjectIni
 	: Super(ObjectInitializer)
 {
 	PersistentStationIndex = 0;
+	WorldIndex = INDEX_NONE;
+	BattleCountersDirty = true;
 }
 
 void UFlareSimulatedSector::Load(const FFlareSectorDescription* Description, const FFlareSectorSave& Data, const FFlareSectorOrbitParameters& OrbitParameters)
@@ -66,10 +69,13 @@ void UFlareSimulatedSector::Load(const FFlareSectorDescription* Description, con
 	SectorSpacecrafts.Empty();
 	SectorFleets.Empty();
 
-	FFlareCelestialBody* Body = Game->GetGameWorld()->GetPlanerarium()->FindCelestialBody(SectorOrbitParameters.CelestialBodyIdentifier);
+	UFlareSimulatedPlanetarium* Planetarium = Game->GetGameWorld()->GetPlanerarium();
+	SectorOrbitParameters.CelestialBodyIndex = Planetarium->FindCelestialBodyIndex(SectorOrbitParameters.CelestialBodyIdentifier);
+
+	FFlareCelestialBody* Body = Planetarium->GetCelestialBody(SectorOrbitParameters.CelestialBodyIndex);
 	if (Body)
 	{
-		LightRatio = Game->GetGameWorld()->GetPlanerarium()->GetLightRatio(Body, SectorOrbitParameters.Altitude);
+		LightRatio = Planetarium->GetLightRatio(Body, SectorOrbitParameters.Altitude);
 	}
 	else
 	{
@@ -424,6 +430,9 @@ UFlareSimulatedSpacecraft* UFlareSimulatedSector::CreateSpacecraft(FFlareSpacecr
 	}
 
 	Spacecraft->SetCurrentSector(this);
+	InvalidateResourceStats();
+	InvalidateBattleState();
+	Game->GetGameWorld()->UpdateHuntTargets(this, Company);
 
 	FLOGV("UFlareSimulatedSector::CreateShip : Created ship '%s' at %s", *Spacecraft->GetImmatriculation().ToString(), *TargetPosition.ToString());
 
@@ -477,6 +486,10 @@ void UFlareSimulatedSector::AddFleet(UFlareFleet* Fleet)
 		SectorShips.AddUnique(Fleet->GetShips()[ShipIndex]);
 		SectorSpacecrafts.AddUnique(Fleet->GetShips()[ShipIndex]);
 	}
+
+	InvalidateResourceStats();
+	InvalidateBattleState();
+	Game->GetGameWorld()->UpdateHuntTargets(this, Fleet->GetFleetCompany());
 }
 
 void UFlareSimulatedSector::DisbandFleet(UFlareFleet* Fleet)
@@ -514,7 +527,11 @@ int UFlareSimulatedSector::RemoveSpacecraft(UFlareSimulatedSpacecraft* Spacecraf
 	SectorStations.Remove(Spacecraft);
 	SectorChildStations.Remove(Spacecraft);
 	SectorShips.Remove(Spacecraft);
-	return SectorSpacecrafts.Remove(Spacecraft);
+	int RemovedCount = SectorSpacecrafts.Remove(Spacecraft);
+	InvalidateResourceStats();
+	InvalidateBattleState();
+	Game->GetGameWorld()->UpdateHuntTargets(this, Spacecraft->GetCompany());
+	return RemovedCount;
 }
 
 
@@ -1208,6 +1225,78 @@ EFlareSectorFriendlyness::Type UFlareSimulatedSector::GetSectorFriendlyness(UFla
 	}
 }
 
+void UFlareSimulatedSector::UpdateBattleCounters()
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareSector_UpdateBattleCounters);
+
+	BattleCounters.Reset(Game->GetGameWorld()->GetCompanies().Num());
+	BattleCounters.SetNum(Game->GetGameWorld()->GetCompanies().Num());
+
+	for (UFlareSimulatedSpacecraft* Spacecraft : GetSectorShips())
+	{
+		if (!Spacecraft->GetDamageSystem()->IsAlive() || !BattleCounters.IsValidIndex(Spacecraft->GetCompany()->GetWorldIndex()))
+		{
+			continue;
+		}
+
+		FFlareSectorBattleCounters& Counters = BattleCounters[Spacecraft->GetCompany()->GetWorldIndex()];
+		Counters.ShipCount++;
+
+		if (!Spacecraft->GetDamageSystem()->IsDisarmed())
+		{
+			Counters.ArmedShipCount++;
+			if (!Spacecraft->IsReserve())
+			{
+				Counters.ActiveArmedShipCount++;
+			}
+		}
+
+		if (Spacecraft->GetDamageSystem()->IsStranded())
+		{
+			Counters.StrandedShipCount++;
+		}
+
+		if (!Spacecraft->GetDamageSystem()->IsUncontrollable())
+		{
+			Counters.ControllableShipCount++;
+		}
+	}
+
+	for (UFlareSimulatedSpacecraft* Spacecraft : GetSectorStations())
+	{
+		if (!Spacecraft->GetDamageSystem()->IsAlive() || !BattleCounters.IsValidIndex(Spacecraft->GetCompany()->GetWorldIndex()))
+		{
+			continue;
+		}
+
+		FFlareSectorBattleCounters& Counters = BattleCounters[Spacecraft->GetCompany()->GetWorldIndex()];
+		Counters.StationCount++;
+
+		if (Spacecraft->IsBeingCaptured())
+		{
+			Counters.StationInCaptureCount++;
+		}
+	}
+
+	// Look at bombs if this is an active sector
+	if (Game->GetActiveSector() && Game->GetActiveSector()->GetSimulatedSector() == this)
+	{
+		for (const AFlareBomb* Bomb : Game->GetActiveSector()->GetBombs())
+		{
+			if (Bomb->IsActive() && Bomb->GetFiringSpacecraft())
+			{
+				int32 CompanyIndex = Bomb->GetFiringSpacecraft()->GetParent()->GetCompany()->GetWorldIndex();
+				if (BattleCounters.IsValidIndex(CompanyIndex))
+				{
+					BattleCounters[CompanyIndex].MissileCount++;
+				}
+			}
+		}
+	}
+
+	BattleCountersDirty = false;
+}
+
 FFlareSectorBattleState UFlareSimulatedSector::GetSectorBattleState(UFlareCompany* Company)
 {
 	SCOPE_CYCLE_COUNTER(STAT_FlareSector_GetSectorBattleState);
@@ -1220,6 +1309,13 @@ FFlareSectorBattleState UFlareSimulatedSector::GetSectorBattleState(UFlareCompan
 		return BattleState;
 	}
 
+	// Missiles and ships outside the active sector change without notice
+	bool IsActiveSector = Game->GetActiveSector() && Game->GetActiveSector()->GetSimulatedSector() == this;
+	if (BattleCountersDirty || IsActiveSector || BattleCounters.Num() != Game->GetGameWorld()->GetCompanies().Num())
+	{
+		UpdateBattleCounters();
+	}
+
 	// Hostiles
 	int HostileSpacecraftCount = 0;
 	int DangerousHostileSpacecraftCount = 0;
@@ -1238,100 +1334,83 @@ FFlareSectorBattleState UFlareSimulatedSector::GetSectorBattleState(UFlareCompan
 	int FriendlyStationInCaptureCount = 0;
 	int FriendlyControllableShipCount = 0;
 
-	// Look at every spacecraft
-	for (int SpacecraftIndex = 0 ; SpacecraftIndex < GetSectorShips().Num(); SpacecraftIndex++)
+	UFlareWorld* World = Game->GetGameWorld();
+	UFlareCompany* PlayerCompany = Game->GetPC()->GetCompany();
+	const FFlareHostilityMatrix& HostilityMatrix = World->GetHostilityMatrix();
+
+	for (int32 CompanyIndex = 0; CompanyIndex < BattleCounters.Num(); CompanyIndex++)
 	{
-		UFlareSimulatedSpacecraft* Spacecraft = GetSectorShips()[SpacecraftIndex];
-		UFlareCompany* OtherCompany = Spacecraft->GetCompany();
+		const FFlareSectorBattleCounters& Counters = BattleCounters[CompanyIndex];
+		UFlareCompany* OtherCompany = World->GetCompanies()[CompanyIndex];
 
-		if (!Spacecraft->GetDamageSystem()->IsAlive())
+		if (Counters.IsEmpty())
 		{
 			continue;
 		}
-
-		if (OtherCompany == Company)
+		else if (OtherCompany == Company)
 		{
-			FriendlySpacecraftCount++;
-			if (!Spacecraft->GetDamageSystem()->IsDisarmed())
-			{
-				DangerousFriendlySpacecraftCount++;
-				if(!Spacecraft->IsReserve())
-				{
-					DangerousFriendlyActiveSpacecraftCount++;
-				}
-			}
-
-			if (Spacecraft->GetDamageSystem()->IsStranded())
-			{
-				CrippledFriendlySpacecraftCount++;
-			}
-
-			if(!Spacecraft->GetDamageSystem()->IsUncontrollable())
-			{
-				FriendlyControllableShipCount++;
-			}
-
-		}
-		else if (Spacecraft->IsHostile(Company))
-		{
-			HostileSpacecraftCount++;
-			if (!Spacecraft->GetDamageSystem()->IsDisarmed())
-			{
-				DangerousHostileSpacecraftCount++;
-				if(!Spacecraft->IsReserve())
-				{
-					DangerousHostileActiveSpacecraftCount++;
-				}
-			}
+			FriendlySpacecraftCount += Counters.ShipCount + Counters.StationCount;
+			DangerousFriendlySpacecraftCount += Counters.ArmedShipCount;
+			DangerousFriendlyActiveSpacecraftCount += Counters.ActiveArmedShipCount;
+			CrippledFriendlySpacecraftCount += Counters.StrandedShipCount + Counters.StationCount;
+			FriendlyControllableShipCount += Counters.ControllableShipCount;
+			FriendlyStationCount += Counters.StationCount;
+			FriendlyStationInCaptureCount += Counters.StationInCaptureCount;
+			DangerousFriendlyActiveMissileCount += Counters.MissileCount;
 		}
-	}
-
-	// Look at every station
-	for (int SpacecraftIndex = 0 ; SpacecraftIndex < GetSectorStations().Num(); SpacecraftIndex++)
-	{
-		UFlareSimulatedSpacecraft* Spacecraft = GetSectorStations()[SpacecraftIndex];
-		UFlareCompany* OtherCompany = Spacecraft->GetCompany();
-
-		if (!Spacecraft->GetDamageSystem()->IsAlive())
+		else if (World->IsAtWar(OtherCompany, Company))
 		{
-			continue;
+			HostileSpacecraftCount += Counters.ShipCount + Counters.StationCount;
+			DangerousHostileSpacecraftCount += Counters.ArmedShipCount;
+			DangerousHostileActiveSpacecraftCount += Counters.ActiveArmedShipCount;
+			DangerousHostileActiveMissileCount += Counters.MissileCount;
 		}
-
-		if (OtherCompany == Company)
+		else if (Company == PlayerCompany || OtherCompany == PlayerCompany)
 		{
-			FriendlySpacecraftCount++;
-			CrippledFriendlySpacecraftCount++;
+			// Military contracts of the player make some spacecrafts hostile without a war
+			UFlareCompany* ContractCompany = (Company == PlayerCompany) ? OtherCompany : Company;
+			int32 ContractCompanyIndex = ContractCompany->GetWorldIndex();
 
-			FriendlyStationCount++;
+			bool HasContract = !HostilityMatrix.IsValidCompany(ContractCompanyIndex)
+				|| HostilityMatrix.GetHuntContracts(ContractCompanyIndex) != EFlareHuntContract::None
+				|| HostilityMatrix.HasSectorContract(ContractCompanyIndex, WorldIndex, false);
 
-			if (Spacecraft->IsBeingCaptured())
+			if (HasContract)
 			{
-				FriendlyStationInCaptureCount++;
-			}
-		}
-		else if (Spacecraft->IsHostile(Company))
-		{
-			HostileSpacecraftCount++;
-		}
-	}
-
-	// Look at bombs if this is an active sector
-	if (Game->GetActiveSector() && Game->GetActiveSector()->GetSimulatedSector() == this)
-	{
-		for (const AFlareBomb* Bomb : Game->GetActiveSector()->GetBombs())
-		{
-			if (Bomb->IsActive() && Bomb->GetFiringSpacecraft())
-			{
-				UFlareSimulatedSpacecraft* FiringSpacecraft = Bomb->GetFiringSpacecraft()->GetParent();
-				UFlareCompany* OtherCompany = FiringSpacecraft->GetCompany();
+				for (UFlareSimulatedSpacecraft* Spacecraft : GetSectorShips())
+				{
+					if (Spacecraft->GetCompany() == OtherCompany && Spacecraft->GetDamageSystem()->IsAlive() && Spacecraft->IsHostile(Company))
+					{
+						HostileSpacecraftCount++;
+						if (!Spacecraft->GetDamageSystem()->IsDisarmed())
+						{
+							DangerousHostileSpacecraftCount++;
+							if (!Spacecraft->IsReserve())
+							{
+								DangerousHostileActiveSpacecraftCount++;
+							}
+						}
+					}
+				}
 
-				if (OtherCompany == Company)
+				for (UFlareSimulatedSpacecraft* Spacecraft : GetSectorStations())
 				{
-					DangerousFriendlyActiveMissileCount++;
+					if (Spacecraft->GetCompany() == OtherCompany && Spacecraft->GetDamageSystem()->IsAlive() && Spacecraft->IsHostile(Company))
+					{
+						HostileSpacecraftCount++;
+					}
 				}
-				else if (Bomb->IsHostile(Company))
+
+				if (Counters.MissileCount > 0)
 				{
-					DangerousHostileActiveMissileCount++;
+					for (const AFlareBomb* Bomb : Game->GetActiveSector()->GetBombs())
+					{
+						if (Bomb->IsActive() && Bomb->GetFiringSpacecraft()
+						 && Bomb->GetFiringSpacecraft()->GetParent()->GetCompany() == OtherCompany && Bomb->IsHostile(Company))
+						{
+							DangerousHostileActiveMissileCount++;
+						}
+					}
 				}
 			}
 		}
@@ -1558,13 +1637,13 @@ void UFlareSimulatedSector::SetPreciseResourcePrice(FFlareResourceDescription* R
 }
 
 
-static bool ReserveShipComparator (UFlareSimulatedSpacecraft& Ship1, UFlareSimulatedSpacecraft& Ship2)
+static bool ReserveShipComparator (UFlareSimulatedSpacecraft& Ship1, UFlareSimulatedSpacecraft& Ship2, const FRandomStream& RandomStream, const FFlareReserveShipsInputs& Inputs)
 {
 	bool SELECT_SHIP1 = true;
 	bool SELECT_SHIP2 = false;
 
-	UFlareSimulatedSpacecraft* PlayerShip = Ship1.GetGame()->GetPC()->GetPlayerShip();
-	UFlareFleet* PlayerFleet = Ship1.GetGame()->GetPC()->GetPlayerFleet();
+	UFlareSimulatedSpacecraft* PlayerShip = Inputs.PlayerShip;
+	UFlareFleet* PlayerFleet = Inputs.PlayerFleet;
 
 	// Player ship is always the first in list
 	if (&Ship1 == PlayerShip)
@@ -1620,7 +1699,7 @@ static bool ReserveShipComparator (UFlareSimulatedSpacecraft& Ship1, UFlareSimul
 		return Ship1.GetActiveCargoBay()->GetUsedCargoSpace() > Ship2.GetActiveCargoBay()->GetUsedCargoSpace();
 	}
 
-	return FMath::RandBool();
+	return (RandomStream.RandRange(0, 1) == 1);
 }
 
 void UFlareSimulatedSector::ProcessMeteorites()
@@ -1722,20 +1801,27 @@ void UFlareSimulatedSector::ProcessMeteorites()
 	}
 }
 
-void UFlareSimulatedSector::GenerateMeteorites()
+void UFlareSimulatedSector::PickMeteoriteTargets(const FRandomStream& RandomStream, TArray<UFlareSimulatedSpacecraft*>& TargetStations)
 {
 	for(UFlareSimulatedSpacecraft* Station : SectorStations)
 	{
 		float Probability = 0.0003;
-		if(FMath::FRand() >  Probability)
+		if(RandomStream.FRand() >  Probability)
 		{
 			continue;
 		}
 
+		TargetStations.Add(Station);
+	}
+}
+
+void UFlareSimulatedSector::GenerateMeteorites(TArray<UFlareSimulatedSpacecraft*> const& TargetStations)
+{
+	for(UFlareSimulatedSpacecraft* Station : TargetStations)
+	{
 		float PowerRatio = 1 + FMath::Log2(0.002f * GetGame()->GetGameWorld()->GetDate());
 		GenerateMeteoriteGroup(Station, PowerRatio);
 	}
-
 }
 
 void UFlareSimulatedSector::GenerateMeteoriteGroup(UFlareSimulatedSpacecraft* TargetStation, float PowerRatio)
@@ -1927,12 +2013,37 @@ void UFlareSimulatedSector::OnFleetSupplyConsumed(int32 Quantity)
 	SectorData.DailyFleetSupplyConsumption += Quantity;
 }
 
+const TArray<FFlareResourceStats>& UFlareSimulatedSector::GetResourceStats(bool IncludeStorage)
+{
+	int64 Date = Game->GetGameWorld()->GetDate();
+
+	const TArray<FFlareResourceStats>* Stats = ResourceStatsCache.Find(IncludeStorage, Date);
+	if (Stats)
+	{
+		return *Stats;
+	}
+
+	int32 ResourceCount = Game->GetResourceCatalog()->Resources.Num();
+	TArray<FFlareResourceStats>& NewStats = ResourceStatsCache.Update(IncludeStorage, Date, ResourceCount);
+	SectorHelper::ComputeSectorResourceStats(this, IncludeStorage, NewStats);
+	return NewStats;
+}
+
+void UFlareSimulatedSector::InvalidateResourceStats()
+{
+	ResourceStatsCache.Invalidate();
+
+	if (Game && Game->GetGameWorld())
+	{
+		Game->GetGameWorld()->InvalidateWorldResourceStats();
+	}
+}
+
 static const int32 MIN_SPAWN = 1;
 
-void UFlareSimulatedSector::UpdateReserveShips()
+void UFlareSimulatedSector::UpdateReserveShips(const FRandomStream& RandomStream, const FFlareReserveShipsInputs& Inputs, bool PlayerInBattle)
 {
-	UFlareGameUserSettings* MyGameSettings = Cast<UFlareGameUserSettings>(GEngine->GetGameUserSettings());
-	int32 MaxShipsInSector = MyGameSettings->MaxShipsInSector;
+	int32 MaxShipsInSector = Inputs.MaxShipsInSector;
 	int32 TotalShipCount = GetSectorShips().Num();
 	int32 TotalCargoShipCount = 0;
 	int32 TotalMilitaryShipCount = 0;
@@ -2006,7 +2117,7 @@ void UFlareSimulatedSector::UpdateReserveShips()
 		}
 	}
 
-	float MilitaryProportion = (GetSectorBattleState(Game->GetPC()->GetCompany()).InBattle ? 0.75f : 0.25);
+	float MilitaryProportion = (PlayerInBattle ? 0.75f : 0.25);
 	float CargoProportion = 1.f-MilitaryProportion;
 
 	for (int32 CompanyIndex = 0; CompanyIndex < GetGame()->GetGameWorld()->GetCompanies().Num(); CompanyIndex++)
@@ -2021,7 +2132,10 @@ void UFlareSimulatedSector::UpdateReserveShips()
 			AllowedShipCount += MIN_SPAWN;
 			//FLOGV("Allow %d/%d cargo for %s", AllowedShipCount, CargoCompanyShipCount, *Company->GetCompanyName().ToString());
 
-			CargoShipListByCompanies[CompanyIndex].Sort(&ReserveShipComparator);
+			CargoShipListByCompanies[CompanyIndex].Sort([&RandomStream, &Inputs](UFlareSimulatedSpacecraft& Ship1, UFlareSimulatedSpacecraft& Ship2)
+			{
+				return ReserveShipComparator(Ship1, Ship2, RandomStream, Inputs);
+			});
 			for (int32 ShipIndex = AllowedShipCount; ShipIndex < CargoCompanyShipCount; ShipIndex++)
 			{
 				UFlareSimulatedSpacecraft* Ship = CargoShipListByCompanies[CompanyIndex][ShipIndex];
@@ -2037,7 +2151,10 @@ void UFlareSimulatedSector::UpdateReserveShips()
 			AllowedShipCount += MIN_SPAWN;
 			//FLOGV("Allow %d/%d military for %s", AllowedShipCount, MilitaryCompanyShipCount, *Company->GetCompanyName().ToString());
 
-			MilitaryShipListByCompanies[CompanyIndex].Sort(&ReserveShipComparator);
+			MilitaryShipListByCompanies[CompanyIndex].Sort([&RandomStream, &Inputs](UFlareSimulatedSpacecraft& Ship1, UFlareSimulatedSpacecraft& Ship2)
+			{
+				return ReserveShipComparator(Ship1, Ship2, RandomStream, Inputs);
+			});
 			for (int32 ShipIndex = AllowedShipCount; ShipIndex < MilitaryCompanyShipCount; ShipIndex++)
 			{
 				UFlareSimulatedSpacecraft* Ship = MilitaryShipListByCompanies[CompanyIndex][ShipIndex];
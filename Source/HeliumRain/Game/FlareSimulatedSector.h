@@ -7,6 +7,7 @@
 #include "../Spacecrafts/FlareBomb.h"
 #include "../Economy/FlarePeople.h"
 #include "../Player/FlareSoundManager.h"
+#include "FlareResourceStats.h"
 #include "FlareSimulatedSector.generated.h"
 
 class UFlareSimulatedSpacecraft;
@@ -119,6 +120,45 @@ struct FFlareSectorBattleState
 	}
 };
 
+/** Spacecraft of a company in a sector, counted for the battle state */
+struct FFlareSectorBattleCounters
+{
+	/** Alive ships */
+	int32 ShipCount;
+
+	/** Alive ships that can fight, and those not in reserve */
+	int32 ArmedShipCount;
+	int32 ActiveArmedShipCount;
+
+	int32 StrandedShipCount;
+	int32 ControllableShipCount;
+
+	/** Alive stations, and those being captured */
+	int32 StationCount;
+	int32 StationInCaptureCount;
+
+	/** Active missiles, in the active sector */
+	int32 MissileCount;
+
+	FFlareSectorBattleCounters()
+	{
+		FMemory::Memzero(*this);
+	}
+
+	inline bool IsEmpty() const
+	{
+		return ShipCount == 0 && StationCount == 0 && MissileCount == 0;
+	}
+};
+
+/** Player and settings state read when choosing the reserve ships, captured on the game thread */
+struct FFlareReserveShipsInputs
+{
+	int32 MaxShipsInSector;
+	UFlareSimulatedSpacecraft* PlayerShip;
+	UFlareFleet* PlayerFleet;
+};
+
 /** Debris field settings */
 USTRUCT()
 struct FFlareDebrisFieldInfo
@@ -255,6 +295,16 @@ struct FFlareSectorOrbitParameters
 	/** Orbit phase */
 	UPROPERTY(EditAnywhere, Category = Save)
 	double Phase;
+
+	/** Parent celestial body index in the planetarium, set when the sector is loaded */
+	int32 CelestialBodyIndex;
+
+	FFlareSectorOrbitParameters()
+		: Altitude(0)
+		, Phase(0)
+		, CelestialBodyIndex(INDEX_NONE)
+	{
+	}
 };
 
 /** Sector resources prices*/
@@ -450,7 +500,12 @@ public:
 	FText GetSectorBalanceText(bool ActiveOnly);
 
 	void ProcessMeteorites();
-	void GenerateMeteorites();
+
+	/** Roll the daily meteorite chance of each station. Only touches this sector, can run on a worker thread */
+	void PickMeteoriteTargets(const FRandomStream& RandomStream, TArray<UFlareSimulatedSpacecraft*>& TargetStations);
+
+	/** Create the meteorite groups picked by PickMeteoriteTargets */
+	void GenerateMeteorites(TArray<UFlareSimulatedSpacecraft*> const& TargetStations);
 	void GenerateMeteoriteGroup(UFlareSimulatedSpacecraft* TargetStation, float PowerRatio);
 
 	TMap<FFlareResourceDescription*, int32> DistributeResources(TMap<FFlareResourceDescription*, int32> Resources, UFlareSimulatedSpacecraft* Source, UFlareCompany* TargetCompany, bool DryRun);
@@ -474,6 +529,7 @@ protected:
 	UFlarePeople*							People;
 
 	int32                                   PersistentStationIndex;
+	int32                                   WorldIndex;
 	float									LightRatio;
 
 	AFlareGame*                             Game;
@@ -484,6 +540,12 @@ protected:
 	TMap<FFlareResourceDescription*, float> ResourcePrices;
 	TMap<FFlareResourceDescription*, FFlareFloatBuffer> LastResourcePrices;
 
+	FFlareResourceStatsCache                ResourceStatsCache;
+
+	/** Battle counters by company world index, counted again when invalidated */
+	TArray<FFlareSectorBattleCounters>      BattleCounters;
+	bool                                    BattleCountersDirty;
+
 public:
 
     /*----------------------------------------------------
@@ -515,6 +577,17 @@ public:
         return SectorData.Identifier;
     }
 
+	/** Get the index of this sector in the world sector list, travel sectors have none */
+	inline int32 GetWorldIndex() const
+	{
+		return WorldIndex;
+	}
+
+	inline void SetWorldIndex(int32 Index)
+	{
+		WorldIndex = Index;
+	}
+
 	/** Get the description of this sector */
 	FText GetSectorDescription() const;
 
@@ -581,7 +654,17 @@ public:
 
 	void OnFleetSupplyConsumed(int32 Quantity);
 
-	void UpdateReserveShips();
+	/** Get the resource stats of the sector by resource index, computed at most once per day until the sector changes */
+	const TArray<FFlareResourceStats>& GetResourceStats(bool IncludeStorage);
+
+	/** The cargo, factories or spacecrafts of the sector changed */
+	void InvalidateResourceStats();
+
+	/** Count the spacecrafts of each company for the battle state */
+	void UpdateBattleCounters();
+
+	/** Choose the ships kept in reserve. Only touches this sector, can run on a worker thread : the inputs and the player battle state are computed by the caller */
+	void UpdateReserveShips(const FRandomStream& RandomStream, const FFlareReserveShipsInputs& Inputs, bool PlayerInBattle);
 
 	static float GetDefaultResourcePrice(FFlareResourceDescription* Resource);
 
@@ -603,6 +686,12 @@ public:
 	/** Get the current battle status of a company */
 	FFlareSectorBattleState GetSectorBattleState(UFlareCompany* Company);
 
+	/** The damage, reserve state, capture state or list of the spacecrafts changed */
+	inline void InvalidateBattleState()
+	{
+		BattleCountersDirty = true;
+	}
+
 	/** Get the current battle status text */
 	FText GetSectorBattleStateText(UFlareCompany* Company);
 
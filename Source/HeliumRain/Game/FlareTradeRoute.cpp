@@ -1005,6 +1005,12 @@ void UFlareTradeRoute::SkipCurrentOperation()
 	}
 }
 
+void UFlareTradeRoute::SetPaused(bool Paused)
+{
+	TradeRouteData.IsPaused = Paused;
+	Game->GetGameWorld()->InvalidateIncomingEvents();
+}
+
 void UFlareTradeRoute::ResetStats()
 {
 	TradeRouteData.StatsDays = 0;
@@ -227,10 +227,8 @@ public:
         TradeRouteData.Name = NewName;
     }
 
-	void SetPaused(bool Paused)
-	{
-		TradeRouteData.IsPaused = Paused;
-	}
+	/** Pause or resume the trade route, its fleets travels show up in the incoming events */
+	void SetPaused(bool Paused);
 
 	void ResetStats();
 
@@ -143,13 +143,14 @@ void UFlareTravel::UpdateTravelParameters()
 	if (OriginSector->GetOrbitParameters()->CelestialBodyIdentifier == DestinationSector->GetOrbitParameters()->CelestialBodyIdentifier)
 	{
 		OrbitParameters.CelestialBodyIdentifier = OriginSector->GetOrbitParameters()->CelestialBodyIdentifier;
+		OrbitParameters.CelestialBodyIndex = OriginSector->GetOrbitParameters()->CelestialBodyIndex;
 
 		OrbitParameters.Altitude = FMath::Lerp(OriginSector->GetOrbitParameters()->Altitude, DestinationSector->GetOrbitParameters()->Altitude, TravelRatio);
 	}
 	else
 	{
-		FFlareCelestialBody* OriginBody = GetGame()->GetGameWorld()->GetPlanerarium()->FindCelestialBody(OriginSector->GetOrbitParameters()->CelestialBodyIdentifier);
-		FFlareCelestialBody* DestinationBody = GetGame()->GetGameWorld()->GetPlanerarium()->FindCelestialBody(DestinationSector->GetOrbitParameters()->CelestialBodyIdentifier);
+		FFlareCelestialBody* OriginBody = GetGame()->GetGameWorld()->GetPlanerarium()->FindOrbitCelestialBody(OriginSector->GetOrbitParameters());
+		FFlareCelestialBody* DestinationBody = GetGame()->GetGameWorld()->GetPlanerarium()->FindOrbitCelestialBody(DestinationSector->GetOrbitParameters());
 
 		double OriginBaseAltitude;
 		double OriginLocalAltitude;
@@ -198,6 +199,7 @@ void UFlareTravel::UpdateTravelParameters()
 		if(TravelRatio < 0.5)
 		{
 			OrbitParameters.CelestialBodyIdentifier = OriginSector->GetOrbitParameters()->CelestialBodyIdentifier;
+			OrbitParameters.CelestialBodyIndex = OriginSector->GetOrbitParameters()->CelestialBodyIndex;
 
 			double CurrentAltitude = FMath::Lerp(OriginStartAltitude, LimitAltitude, TravelRatio*2);
 			OrbitParameters.Altitude = FMath::Abs(CurrentAltitude - OriginBaseAltitude);
@@ -205,6 +207,7 @@ void UFlareTravel::UpdateTravelParameters()
 		else
 		{
 			OrbitParameters.CelestialBodyIdentifier = DestinationSector->GetOrbitParameters()->CelestialBodyIdentifier;
+			OrbitParameters.CelestialBodyIndex = DestinationSector->GetOrbitParameters()->CelestialBodyIndex;
 
 			double CurrentAltitude = FMath::Lerp(OriginStartAltitude, LimitAltitude, TravelRatio*2);
 			OrbitParameters.Altitude = FMath::Abs(CurrentAltitude - DestinationBaseAltitude);
@@ -388,6 +391,25 @@ void UFlareTravel::GenerateTravelDuration()
 }
 
 int64 UFlareTravel::ComputeTravelDuration(UFlareWorld* World, UFlareSimulatedSector* OriginSector, UFlareSimulatedSector* DestinationSector, UFlareCompany* Company)
+{
+	if (OriginSector == DestinationSector)
+	{
+		return 0;
+	}
+
+	bool FastTravel = (Company && Company->IsTechnologyUnlocked("fast-travel"));
+
+	// Travel sectors are not in the table
+	const FFlareTravelDurationTable& Table = World->GetTravelDurationTable();
+	if (UFlareGameTools::TravelDurationTable && Table.IsValidSector(OriginSector->GetWorldIndex()) && Table.IsValidSector(DestinationSector->GetWorldIndex()))
+	{
+		return Table.Get(OriginSector->GetWorldIndex(), DestinationSector->GetWorldIndex(), FastTravel);
+	}
+
+	return ComputeTravelDurationNoCache(World, OriginSector, DestinationSector, FastTravel);
+}
+
+int64 UFlareTravel::ComputeTravelDurationNoCache(UFlareWorld* World, UFlareSimulatedSector* OriginSector, UFlareSimulatedSector* DestinationSector, bool FastTravel)
 {
 	int64 TravelDuration = 0;
 
@@ -415,19 +437,19 @@ int64 UFlareTravel::ComputeTravelDuration(UFlareWorld* World, UFlareSimulatedSec
 	if (OriginCelestialBodyIdentifier == DestinationCelestialBodyIdentifier && OriginAltitude == DestinationAltitude)
 	{
 		// Phase change travel
-		FFlareCelestialBody* CelestialBody = World->GetPlanerarium()->FindCelestialBody(OriginCelestialBodyIdentifier);
+		FFlareCelestialBody* CelestialBody = World->GetPlanerarium()->FindOrbitCelestialBody(OriginSector->GetOrbitParameters());
 		TravelDuration = ComputePhaseTravelDuration(World, CelestialBody, OriginAltitude, OriginPhase, DestinationPhase) / UFlareGameTools::SECONDS_IN_DAY;
 	}
 	else
 	{
 		// Altitude change travel
-		FFlareCelestialBody* OriginCelestialBody = World->GetPlanerarium()->FindCelestialBody(OriginCelestialBodyIdentifier);
-		FFlareCelestialBody* DestinationCelestialBody = World->GetPlanerarium()->FindCelestialBody(DestinationCelestialBodyIdentifier);
+		FFlareCelestialBody* OriginCelestialBody = World->GetPlanerarium()->FindOrbitCelestialBody(OriginSector->GetOrbitParameters());
+		FFlareCelestialBody* DestinationCelestialBody = World->GetPlanerarium()->FindOrbitCelestialBody(DestinationSector->GetOrbitParameters());
 
 		TravelDuration = (UFlareGameTools::SECONDS_IN_DAY/2 + ComputeAltitudeTravelDuration(World, OriginCelestialBody, OriginAltitude, DestinationCelestialBody, DestinationAltitude)) / UFlareGameTools::SECONDS_IN_DAY;
 	}
 
-	if(Company && Company->IsTechnologyUnlocked("fast-travel"))
+	if(FastTravel)
 	{
 		TravelDuration /= 2;
 	}
@@ -437,8 +459,7 @@ int64 UFlareTravel::ComputeTravelDuration(UFlareWorld* World, UFlareSimulatedSec
 
 double UFlareTravel::ComputeSphereOfInfluenceAltitude(UFlareWorld* World, FFlareCelestialBody* CelestialBody)
 {
-	FFlareCelestialBody* ParentCelestialBody = World->GetPlanerarium()->FindParent(CelestialBody);
-	return CelestialBody->OrbitDistance * pow(CelestialBody->Mass / ParentCelestialBody->Mass, 0.4) - CelestialBody->Radius;
+	return World->GetPlanerarium()->GetSphereOfInfluenceAltitude(CelestialBody);
 }
 
 
@@ -541,13 +562,15 @@ bool UFlareTravel::IsPlayerHostile()
 		return false;
 	}
 
-	bool CanBeHostile = Game->GetQuestManager()->IsUnderMilitaryContract(GetDestinationSector(), Fleet->GetFleetCompany(), false);
+	const FFlareHostilityMatrix& HostilityMatrix = Game->GetGameWorld()->GetHostilityMatrix();
+	int32 CompanyIndex = Fleet->GetFleetCompany()->GetWorldIndex();
+	bool CanBeHostile = HostilityMatrix.HasSectorContract(CompanyIndex, GetDestinationSector()->GetWorldIndex(), false);
 
 	if(!CanBeHostile)
 	{
 		for (UFlareSimulatedSpacecraft* Ship :Fleet->GetShips())
 		{
-			if(Game->GetQuestManager()->IsMilitaryTarget(Ship, false))
+			if(HostilityMatrix.IsHuntTarget(CompanyIndex, FFlareHostilityMatrix::GetHuntContractType(Ship->IsMilitary(), Ship->GetSize() == EFlarePartSize::L), false))
 			{
 				CanBeHostile = true;
 				break;
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Object.h"
+
+
+/** Travel durations in days between all sectors, indexed by sector world index, without and with the fast-travel technology.
+ * Sector orbits never change, so the table is built once when the world is loaded. */
+struct FFlareTravelDurationTable
+{
+public:
+
+	FFlareTravelDurationTable()
+		: SectorCount(0)
+	{
+	}
+
+	/** Clear the table for this sector count */
+	inline void Reset(int32 NewSectorCount)
+	{
+		SectorCount = NewSectorCount;
+		Durations[0].Reset(SectorCount * SectorCount);
+		Durations[0].SetNumZeroed(SectorCount * SectorCount);
+		Durations[1].Reset(SectorCount * SectorCount);
+		Durations[1].SetNumZeroed(SectorCount * SectorCount);
+	}
+
+	inline bool IsValidSector(int32 Sector) const
+	{
+		return Sector >= 0 && Sector < SectorCount;
+	}
+
+	inline void Set(int32 OriginSector, int32 DestinationSector, bool FastTravel, int64 Duration)
+	{
+		Durations[FastTravel][OriginSector * SectorCount + DestinationSector] = Duration;
+	}
+
+	inline int64 Get(int32 OriginSector, int32 DestinationSector, bool FastTravel) const
+	{
+		return Durations[FastTravel][OriginSector * SectorCount + DestinationSector];
+	}
+
+
+protected:
+
+	int32                              SectorCount;
+	TArray<int32>                      Durations[2];
+
+};
@@ -4,6 +4,8 @@
 
 #include "../Data/FlareSpacecraftCatalog.h"
 #include "../Data/FlareSectorCatalogEntry.h"
+#include "../Data/FlareResourceCatalog.h"
+#include "../Data/FlareSpacecraftComponentsCatalog.h"
 
 #include "../Economy/FlareFactory.h"
 
@@ -14,6 +16,8 @@
 #include "FlareTravel.h"
 #include "FlareFleet.h"
 #include "FlareBattle.h"
+#include "FlareWorldHelper.h"
+#include "AI/FlareAIBehavior.h"
 #include "AI/FlareAITradeHelper.h"
 
 #include "../Quests/FlareQuest.h"
@@ -22,14 +26,64 @@
 #include "../Player/FlarePlayerController.h"
 #include "../Player/FlareMenuManager.h"
 
+#include "Async/ParallelFor.h"
+
 #define LOCTEXT_NAMESPACE "FlareWorld"
 
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate PlayerAutoTrade"), STAT_FlareWorld_Simulate_PlayerAutoTrade, STATGROUP_FlareSimulation);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate Battles"), STAT_FlareWorld_Simulate_Battles, STATGROUP_FlareSimulation);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate AITrading"), STAT_FlareWorld_Simulate_AITrading, STATGROUP_FlareSimulation);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate AIPlanning"), STAT_FlareWorld_Simulate_AIPlanning, STATGROUP_FlareSimulation);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate AICompanies"), STAT_FlareWorld_Simulate_AICompanies, STATGROUP_FlareSimulation);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate Meteorites"), STAT_FlareWorld_Simulate_Meteorites, STATGROUP_FlareSimulation);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate Fleets"), STAT_FlareWorld_Simulate_Fleets, STATGROUP_FlareSimulation);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate Factories"), STAT_FlareWorld_Simulate_Factories, STATGROUP_FlareSimulation);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate People"), STAT_FlareWorld_Simulate_People, STATGROUP_FlareSimulation);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate TradeRoutes"), STAT_FlareWorld_Simulate_TradeRoutes, STATGROUP_FlareSimulation);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate Travels"), STAT_FlareWorld_Simulate_Travels, STATGROUP_FlareSimulation);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate Prices"), STAT_FlareWorld_Simulate_Prices, STATGROUP_FlareSimulation);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate PeopleMigration"), STAT_FlareWorld_Simulate_PeopleMigration, STATGROUP_FlareSimulation);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate EndOfDay"), STAT_FlareWorld_Simulate_EndOfDay, STATGROUP_FlareSimulation);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld UpdateHostilityMatrix"), STAT_FlareWorld_UpdateHostilityMatrix, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld UpdateTravelDurationTable"), STAT_FlareWorld_UpdateTravelDurationTable, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld ComputeIncomingEvents"), STAT_FlareWorld_ComputeIncomingEvents, STATGROUP_Flare);
+
+
+/** Record the wall time, touched objects and memory growth of a simulation phase */
+struct FFlareSimulationPhaseScope
+{
+	FFlareSimulationPhaseScope(FFlareSimulationDayStats& DayStatsParam, EFlareSimulationPhase::Type PhaseParam, int32 ObjectCountParam)
+		: DayStats(DayStatsParam)
+		, Phase(PhaseParam)
+		, ObjectCount(ObjectCountParam)
+		, StartTs(FPlatformTime::Seconds())
+		, StartMemory(FPlatformMemory::GetStats().UsedPhysical)
+	{
+	}
+
+	~FFlareSimulationPhaseScope()
+	{
+		FFlareSimulationPhaseStats& PhaseStats = DayStats.Phases[Phase];
+		PhaseStats.Time = FPlatformTime::Seconds() - StartTs;
+		PhaseStats.ObjectCount = ObjectCount;
+		PhaseStats.MemoryGrowth = (int64) FPlatformMemory::GetStats().UsedPhysical - StartMemory;
+	}
+
+	FFlareSimulationDayStats&    DayStats;
+	EFlareSimulationPhase::Type  Phase;
+	int32                        ObjectCount;
+	double                       StartTs;
+	int64                        StartMemory;
+};
+
 /*----------------------------------------------------
     Constructor
 ----------------------------------------------------*/
 
 UFlareWorld::UFlareWorld(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+	, SimulationStatsHistoryIndex(0)
+	, HasIncomingEventsCache(false)
 {
 }
 
@@ -122,6 +176,9 @@ void UFlareWorld::PostLoad()
 	{
 		Companies[i]->PostLoad();
 	}
+
+	UpdateHostilityMatrix();
+	UpdateTravelDurationTable();
 }
 
 UFlareCompany* UFlareWorld::LoadCompany(const FFlareCompanySave& CompanyData)
@@ -131,7 +188,7 @@ UFlareCompany* UFlareWorld::LoadCompany(const FFlareCompanySave& CompanyData)
     // Create the new company
 	Company = NewObject<UFlareCompany>(this, UFlareCompany::StaticClass(), CompanyData.Identifier);
     Company->Load(CompanyData);
-    Companies.AddUnique(Company);
+    Company->SetWorldIndex(Companies.AddUnique(Company));
 
 	//FLOGV("UFlareWorld::LoadCompany : loaded '%s'", *Company->GetCompanyName().ToString());
 
@@ -146,7 +203,8 @@ UFlareSimulatedSector* UFlareWorld::LoadSector(const FFlareSectorDescription* De
 	// Create the new sector
 	Sector = NewObject<UFlareSimulatedSector>(this, UFlareSimulatedSector::StaticClass(), SectorData.Identifier);
 	Sector->Load(Description, SectorData, OrbitParameters);
-	Sectors.AddUnique(Sector);
+	Sector->SetWorldIndex(Sectors.AddUnique(Sector));
+	SectorsByIdentifier.Add(Sector->GetIdentifier(), Sector);
 
 	//FLOGV("UFlareWorld::LoadSector : loaded '%s'", *Sector->GetSectorName().ToString());
 
@@ -419,463 +477,965 @@ void UFlareWorld::Simulate()
 	double StartTs = FPlatformTime::Seconds();
 	UFlareCompany* PlayerCompany = Game->GetPC()->GetCompany();
 
+	// Phase profiling
+	LastSimulationStats = FFlareSimulationDayStats();
+	LastSimulationStats.Date = WorldData.Date;
+
+	// Start the day with fresh resource stats
+	InvalidateResourceStats();
+
 	/**
 	 *  End previous day
 	 */
 	FLOGV("** Simulate day %d", WorldData.Date);
 
-	FLOG("* Simulate > Player autotrade");
-	AITradeHelper::CompanyAutoTrade(PlayerCompany);
+	{
+		SCOPE_CYCLE_COUNTER(STAT_FlareWorld_Simulate_PlayerAutoTrade);
+		FFlareSimulationPhaseScope PhaseScope(LastSimulationStats, EFlareSimulationPhase::PlayerAutoTrade, PlayerCompany->GetCompanyFleets().Num());
+
+		FLOG("* Simulate > Player autotrade");
+		AITradeHelper::CompanyAutoTrade(PlayerCompany);
+	}
 
-	FLOG("* Simulate > Battles");
-	for (int SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
 	{
-		UFlareSimulatedSector* Sector = Sectors[SectorIndex];
+		SCOPE_CYCLE_COUNTER(STAT_FlareWorld_Simulate_Battles);
+		FFlareSimulationPhaseScope PhaseScope(LastSimulationStats, EFlareSimulationPhase::Battles, Sectors.Num());
+
+		FLOG("* Simulate > Battles");
+		SimulateBattles(FMath::Rand());
+	}
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_FlareWorld_Simulate_AITrading);
+		FFlareSimulationPhaseScope PhaseScope(LastSimulationStats, EFlareSimulationPhase::AITrading, 0);
+
+		FLOG("* Simulate > AI");
+
+		HasTotalWorldCombatPointCache = false;
+
+		// AI. Merged trading
+		AITradeNeeds Needs;
+		AITradeNeeds MaintenanceNeeds;
+		AITradeNeeds StorageNeeds;
+		AITradeSources Sources(this);
+		AITradeSources MaintenanceSources(this);
+		AITradeIdleShips IdleShips(this);
+
+
+		AITradeHelper::GenerateTradingNeeds(Needs, MaintenanceNeeds, StorageNeeds, this);
+		AITradeHelper::GenerateTradingSources(Sources, MaintenanceSources, this);
+		AITradeHelper::GenerateIdleShips(IdleShips, this);
+
+		AICompaniesMoney CompaniesMoney;
+		for(UFlareCompany* Company: GetCompanies())
+		{
+			CompaniesMoney.CompaniesMoney.Add(Company, Company->GetMoney())	;
+		}
+
+		PhaseScope.ObjectCount = Needs.List.Num() + MaintenanceNeeds.List.Num() + StorageNeeds.List.Num()
+			+ Sources.Sources.Num() + MaintenanceSources.Sources.Num() + IdleShips.Ships.Num();
+
+#if DEBUG_NEW_AI_TRADING
+		FLOG("Initial trading stat");
+		Needs.Print();
+		MaintenanceNeeds.Print();
+		StorageNeeds.Print();
+		Sources.Print();
+		MaintenanceSources.Print();
+		IdleShips.Print();
+
+		for(auto& CompanyMoney : CompaniesMoney.CompaniesMoney)
+		{
+			FLOGV("- %s start with %lld", *CompanyMoney.Key->GetCompanyName().ToString(), CompanyMoney.Value);
+		}
+
+#endif
+
+		AITradeHelper::ComputeGlobalTrading(this, MaintenanceNeeds, Sources, MaintenanceSources, IdleShips, CompaniesMoney);
+		AITradeHelper::ComputeGlobalTrading(this, Needs, Sources, MaintenanceSources, IdleShips, CompaniesMoney);
+
+		for(UFlareCompany* Company: Companies)
+		{
+			Company->GetAI()->UpdateIdleShipsStats(IdleShips);
+		}
+
+		AITradeHelper::ComputeGlobalTrading(this, StorageNeeds, Sources, MaintenanceSources, IdleShips, CompaniesMoney);
+
+#if DEBUG_NEW_AI_TRADING
+		FLOG("Final trading stat");
+		Needs.Print();
+		Sources.Print();
+		MaintenanceSources.Print();
+		IdleShips.Print();
+#endif
+	}
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_FlareWorld_Simulate_AIPlanning);
+		FFlareSimulationPhaseScope PhaseScope(LastSimulationStats, EFlareSimulationPhase::AIPlanning, Companies.Num());
+
+		// AI. Analyse the world for all companies from the same state, on worker threads.
+		// This changes the AI : each company plans from the stocks before the other companies played.
+		// Serially, each company analyses the world itself when it plays, after the previous ones.
+		if (UFlareGameTools::ParallelSimulation)
+		{
+			PlanCompanyAI();
+		}
+	}
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_FlareWorld_Simulate_AICompanies);
+		FFlareSimulationPhaseScope PhaseScope(LastSimulationStats, EFlareSimulationPhase::AICompanies, Companies.Num());
+
+		// AI. Play them in random order
+		TArray<UFlareCompany*> CompaniesToSimulateAI = Companies;
+		while(CompaniesToSimulateAI.Num())
+		{
+			int32 Index = FMath::RandRange(0, CompaniesToSimulateAI.Num() - 1);
+			CompaniesToSimulateAI[Index]->SimulateAI();
+			CompaniesToSimulateAI.RemoveAt(Index);
+		}
+	}
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_FlareWorld_Simulate_Meteorites);
+		FFlareSimulationPhaseScope PhaseScope(LastSimulationStats, EFlareSimulationPhase::Meteorites, Sectors.Num());
+
+		// Clear bombs
+		for (int SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
+		{
+			Sectors[SectorIndex]->ClearBombs();
+		}
+
+
+		// Process meteorites
+		for (UFlareSimulatedSector* Sector :Sectors)
+		{
+			Sector->ProcessMeteorites();
+		}
+
+		// GenerateMeteorites : targets are picked per sector, groups and quests are created in sector order
+		TArray<TArray<UFlareSimulatedSpacecraft*>> MeteoriteTargets;
+		MeteoriteTargets.SetNum(Sectors.Num());
+		ForEachSector(FMath::Rand(), [&MeteoriteTargets](UFlareSimulatedSector* Sector, int32 SectorIndex, const FRandomStream& RandomStream)
+		{
+			Sector->PickMeteoriteTargets(RandomStream, MeteoriteTargets[SectorIndex]);
+		});
+
+		for (int SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
+		{
+			Sectors[SectorIndex]->GenerateMeteorites(MeteoriteTargets[SectorIndex]);
+		}
+	}
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_FlareWorld_Simulate_Fleets);
+		FFlareSimulationPhaseScope PhaseScope(LastSimulationStats, EFlareSimulationPhase::Fleets, 0);
+
+		CompanyMutualAssistance();
+		CheckIntegrity();
+
+		/**
+		 *  Begin day
+		 */
+		FLOG("* Simulate > New day");
+
+		WorldData.Date++;
+
+		// Some military contracts are only valid on their attack date
+		UpdateHostilityMatrix();
+
+		// Write FS consumption stats
+		ForEachSector(0, [](UFlareSimulatedSector* Sector, int32 SectorIndex, const FRandomStream& RandomStream)
+		{
+			Sector->UpdateFleetSupplyConsumptionStats();
+		});
+
+		// Count repairing fleet
+		int32 PlayerRepairingFleet = 0;
+		int32 PlayerRefillingFleet = 0;
+		for (UFlareFleet* Fleet : GetGame()->GetPC()->GetCompany()->GetCompanyFleets())
+		{
+			if(Fleet->IsRepairing())
+			{
+				PlayerRepairingFleet++;
+			}
+
+			if(Fleet->IsRefilling())
+			{
+				PlayerRefillingFleet++;
+			}
+		}
+
 
-		// Check if battle
-		bool HasBattle = false;
+		// End trade, intercept, repair and refill, operations
 		for (int CompanyIndex = 0; CompanyIndex < Companies.Num(); CompanyIndex++)
 		{
 			UFlareCompany* Company = Companies[CompanyIndex];
+			PhaseScope.ObjectCount += Company->GetCompanySpacecrafts().Num();
 
-			if (Company == PlayerCompany && Sector == GetGame()->GetPC()->GetPlayerShip()->GetCurrentSector())
+			for (int32 SpacecraftIndex = 0; SpacecraftIndex < Company->GetCompanySpacecrafts().Num(); SpacecraftIndex++)
 			{
-				// Local sector, don't check if the player want fight
-				continue;
+				UFlareSimulatedSpacecraft* Spacecraft = Company->GetCompanySpacecrafts()[SpacecraftIndex];
+				if (!Spacecraft->IsStation())
+				{
+					Spacecraft->SetTrading(false);
+					Spacecraft->SetIntercepted(false);
+				}
+				Spacecraft->Repair();
+				Spacecraft->Refill();
+				Spacecraft->Stabilize();
 			}
+		}
 
-			FFlareSectorBattleState BattleState = Sector->GetSectorBattleState(Company);
 
-			if(!BattleState.WantFight())
+		int32 PlayerRepairingFleetAfter = 0;
+		int32 PlayerRefillingFleetAfter = 0;
+		for (UFlareFleet* Fleet : GetGame()->GetPC()->GetCompany()->GetCompanyFleets())
+		{
+			if(Fleet->IsRepairing())
 			{
-				// Don't want fight
-				continue;
+				PlayerRepairingFleetAfter++;
 			}
 
-			FLOGV("%s want fight in %s", *Company->GetCompanyName().ToString(),
-				  *Sector->GetSectorName().ToString());
+			if(Fleet->IsRefilling())
+			{
+				PlayerRefillingFleetAfter++;
+			}
+		}
 
-			HasBattle = true;
-			break;
+		if (PlayerRepairingFleetAfter < PlayerRepairingFleet)
+		{
+			FText RepairText;
+
+			if (GetGame()->GetPC()->GetCompany()->GetCompanyFleets().Num() == 1)
+			{
+				RepairText = LOCTEXT("YouFleetRepairFinish", "Your fleet repairs are finished");
+			}
+			else if (PlayerRepairingFleet - PlayerRepairingFleetAfter > 1)
+			{
+				RepairText = LOCTEXT("MultipleFleetRepairFinish", "Some fleet repairs are finished");
+			}
+			else
+			{
+				RepairText = LOCTEXT("OneFleetRepairFinish", "One fleet repair is finished");
+			}
+
+			FFlareMenuParameterData MenuData;
+			GetGame()->GetPC()->Notify(LOCTEXT("FeetRepaired", "Repaired"),
+				RepairText,
+				FName("fleet-repaired"),
+				EFlareNotification::NT_Military,
+				false,
+				EFlareMenu::MENU_Orbit,
+				MenuData);
 		}
 
-		if (HasBattle)
+		if (PlayerRefillingFleetAfter < PlayerRefillingFleet)
 		{
-			UFlareBattle* Battle = NewObject<UFlareBattle>(this, UFlareBattle::StaticClass());
-			Battle->Load(Sector);
-			Battle->Simulate();
+			FText RefillText;
+
+			if(GetGame()->GetPC()->GetCompany()->GetCompanyFleets().Num() == 1)
+			{
+				RefillText = LOCTEXT("YouFleetRefill", "Your fleet refillings are finished");
+			}
+			else if (PlayerRefillingFleet - PlayerRefillingFleetAfter > 1)
+			{
+				RefillText = LOCTEXT("MultipleFleetRefillFinish", "Some fleet refillings are finished");
+			}
+			else
+			{
+				RefillText = LOCTEXT("OneFleetRefillFinish", "One fleet refilling is finished");
+			}
+
+			FFlareMenuParameterData MenuData;
+			GetGame()->GetPC()->Notify(LOCTEXT("FeetRefilled", "Refilled"),
+				RefillText,
+				FName("fleet-refilled"),
+				EFlareNotification::NT_Military,
+				false,
+				EFlareMenu::MENU_Orbit,
+				MenuData);
 		}
 
-		// Remove destroyed spacecraft
-		TArray<UFlareSimulatedSpacecraft*> SpacecraftToRemove;
+		// Spacrecraft capture
+		ProcessShipCapture();
+		ProcessStationCapture();
+	}
 
-		for (int32 SpacecraftIndex = 0 ; SpacecraftIndex < Sector->GetSectorSpacecrafts().Num(); SpacecraftIndex++)
-		{
-			UFlareSimulatedSpacecraft* Spacecraft = Sector->GetSectorSpacecrafts()[SpacecraftIndex];
+	{
+		SCOPE_CYCLE_COUNTER(STAT_FlareWorld_Simulate_Factories);
+		FFlareSimulationPhaseScope PhaseScope(LastSimulationStats, EFlareSimulationPhase::Factories, Factories.Num());
 
-			if(!Spacecraft->GetDamageSystem()->IsAlive() && !Spacecraft->GetDescription()->IsSubstation)
+		// Factories
+		FLOG("* Simulate > Factories");
+		for (UFlareFactory* Factory: Factories)
+		{
+			if(Factory->IsShipyard())
 			{
-				SpacecraftToRemove.Add(Spacecraft);
+				Factory->GetParent()->UpdateShipyardProduction();
 			}
 		}
 
-		for (int SpacecraftIndex = 0; SpacecraftIndex < SpacecraftToRemove.Num(); SpacecraftIndex++)
+		for (int FactoryIndex = 0; FactoryIndex < Factories.Num(); FactoryIndex++)
 		{
-			UFlareSimulatedSpacecraft* Spacecraft = SpacecraftToRemove[SpacecraftIndex];
-			Spacecraft->GetCompany()->DestroySpacecraft(Spacecraft);
+			Factories[FactoryIndex]->Simulate();
 		}
 	}
 
-	FLOG("* Simulate > AI");
+	{
+		SCOPE_CYCLE_COUNTER(STAT_FlareWorld_Simulate_People);
+		FFlareSimulationPhaseScope PhaseScope(LastSimulationStats, EFlareSimulationPhase::People, Sectors.Num());
+
+		// Peoples
+		FLOG("* Simulate > Peoples");
+		for (int SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
+		{
+			Sectors[SectorIndex]->GetPeople()->Simulate();
+		}
+	}
 
-	HasTotalWorldCombatPointCache = false;
+	{
+		SCOPE_CYCLE_COUNTER(STAT_FlareWorld_Simulate_TradeRoutes);
+		FFlareSimulationPhaseScope PhaseScope(LastSimulationStats, EFlareSimulationPhase::TradeRoutes, 0);
 
-	// AI. Merged trading
-	AITradeNeeds Needs;
-	AITradeNeeds MaintenanceNeeds;
-	AITradeNeeds StorageNeeds;
-	AITradeSources Sources(this);
-	AITradeSources MaintenanceSources(this);
-	AITradeIdleShips IdleShips(this);
+		FLOG("* Simulate > Trade routes");
 
+		// Trade routes
+		for (int CompanyIndex = 0; CompanyIndex < Companies.Num(); CompanyIndex++)
+		{
+			TArray<UFlareTradeRoute*>& TradeRoutes = Companies[CompanyIndex]->GetCompanyTradeRoutes();
+			PhaseScope.ObjectCount += TradeRoutes.Num();
 
-	AITradeHelper::GenerateTradingNeeds(Needs, MaintenanceNeeds, StorageNeeds, this);
-	AITradeHelper::GenerateTradingSources(Sources, MaintenanceSources, this);
-	AITradeHelper::GenerateIdleShips(IdleShips, this);
+			for (int RouteIndex = 0; RouteIndex < TradeRoutes.Num(); RouteIndex++)
+			{
+				TradeRoutes[RouteIndex]->Simulate();
+			}
+		}
+	}
 
-	AICompaniesMoney CompaniesMoney;
-	for(UFlareCompany* Company: GetCompanies())
 	{
-		CompaniesMoney.CompaniesMoney.Add(Company, Company->GetMoney())	;
+		SCOPE_CYCLE_COUNTER(STAT_FlareWorld_Simulate_Travels);
+		FFlareSimulationPhaseScope PhaseScope(LastSimulationStats, EFlareSimulationPhase::Travels, Travels.Num());
+
+		FLOG("* Simulate > Travels");
+
+		// Undock and make move AI ships
+		for (UFlareSimulatedSector* Sector : Sectors)
+		{
+			for(UFlareSimulatedSpacecraft* Ship : Sector->GetSectorShips())
+			{
+				if(Ship->GetCompany() != PlayerCompany)
+				{
+					// Undock
+					Ship->ForceUndock();
+					Ship->SetSpawnMode(EFlareSpawnMode::Travel);
+				}
+			}
+		}
+
+		// Travels
+		TArray<UFlareTravel*> TravelsToProcess = Travels;
+		for (int TravelIndex = 0; TravelIndex < TravelsToProcess.Num(); TravelIndex++)
+		{
+			TravelsToProcess[TravelIndex]->Simulate();
+		}
 	}
 
-#if DEBUG_NEW_AI_TRADING
-	FLOG("Initial trading stat");
-	Needs.Print();
-	MaintenanceNeeds.Print();
-	StorageNeeds.Print();
-	Sources.Print();
-	MaintenanceSources.Print();
-	IdleShips.Print();
+	{
+		SCOPE_CYCLE_COUNTER(STAT_FlareWorld_Simulate_Prices);
+		FFlareSimulationPhaseScope PhaseScope(LastSimulationStats, EFlareSimulationPhase::Prices, Sectors.Num());
+
+		FLOG("* Simulate > Prices");
+		// Price variation.
+		ForEachSector(0, [](UFlareSimulatedSector* Sector, int32 SectorIndex, const FRandomStream& RandomStream)
+		{
+			Sector->SimulatePriceVariation();
+		});
+	}
 
-	for(auto& CompanyMoney : CompaniesMoney.CompaniesMoney)
 	{
-		FLOGV("- %s start with %lld", *CompanyMoney.Key->GetCompanyName().ToString(), CompanyMoney.Value);
+		SCOPE_CYCLE_COUNTER(STAT_FlareWorld_Simulate_PeopleMigration);
+		FFlareSimulationPhaseScope PhaseScope(LastSimulationStats, EFlareSimulationPhase::PeopleMigration, Sectors.Num());
+
+		// People money migration
+		SimulatePeopleMoneyMigration();
 	}
 
-#endif
+	{
+		SCOPE_CYCLE_COUNTER(STAT_FlareWorld_Simulate_EndOfDay);
+		FFlareSimulationPhaseScope PhaseScope(LastSimulationStats, EFlareSimulationPhase::EndOfDay, Sectors.Num());
+
+		// Process events
+
+		// Swap Prices and update reserve ships
+		SwapPricesAndUpdateReserveShips(FMath::Rand());
+
+		// Update storage station reservation
+		UpdateStorageLocks();
 
-	AITradeHelper::ComputeGlobalTrading(this, MaintenanceNeeds, Sources, MaintenanceSources, IdleShips, CompaniesMoney);
-	AITradeHelper::ComputeGlobalTrading(this, Needs, Sources, MaintenanceSources, IdleShips, CompaniesMoney);
+		// Player being attacked ?
+		ProcessIncomingPlayerEnemy();
 
-	for(UFlareCompany* Company: Companies)
+		// Lets AI check if in battle
+		CheckAIBattleState();
+
+		for (UFlareCompany* Company : Companies)
+		{
+			Company->InvalidateCompanyValueCache();
+		}
+
+		// Population and prices changed
+		InvalidateResourceStats();
+
+		// Travels, productions and battles moved on
+		InvalidateIncomingEvents();
+	}
+
+	double EndTs = FPlatformTime::Seconds();
+	LastSimulationStats.TotalTime = EndTs - StartTs;
+	if (SimulationStatsHistory.Num() < SIMULATION_STATS_HISTORY_SIZE)
+	{
+		SimulationStatsHistory.Add(LastSimulationStats);
+	}
+	else
 	{
-		Company->GetAI()->UpdateIdleShipsStats(IdleShips);
+		SimulationStatsHistory[SimulationStatsHistoryIndex] = LastSimulationStats;
 	}
+	SimulationStatsHistoryIndex = (SimulationStatsHistoryIndex + 1) % SIMULATION_STATS_HISTORY_SIZE;
+	FLOGV("** Simulate day %d done in %.6fs", WorldData.Date-1, EndTs- StartTs);
 
-	AITradeHelper::ComputeGlobalTrading(this, StorageNeeds, Sources, MaintenanceSources, IdleShips, CompaniesMoney);
+	Game->GetQuestManager()->OnNextDay();
 
-#if DEBUG_NEW_AI_TRADING
-	FLOG("Final trading stat");
-	Needs.Print();
-	Sources.Print();
-	MaintenanceSources.Print();
-	IdleShips.Print();
-#endif
+	GameLog::DaySimulated(WorldData.Date);
 
-	// AI. Play them in random order
-	TArray<UFlareCompany*> CompaniesToSimulateAI = Companies;
-	while(CompaniesToSimulateAI.Num())
+	// Check recovery
 	{
-		int32 Index = FMath::RandRange(0, CompaniesToSimulateAI.Num() - 1);
-		CompaniesToSimulateAI[Index]->SimulateAI();
-		CompaniesToSimulateAI.RemoveAt(Index);
+		// Check if it the last ship
+		bool EmptyFleet = true;
+		for(int ShipIndex = 0; ShipIndex < GetGame()->GetPC()->GetPlayerFleet()->GetShips().Num(); ShipIndex++)
+		{
+			UFlareSimulatedSpacecraft* Ship = GetGame()->GetPC()->GetPlayerFleet()->GetShips()[ShipIndex];
+			if(Ship->GetDamageSystem()->IsAlive() && !Ship->GetDamageSystem()->IsUncontrollable())
+			{
+				EmptyFleet = false;
+				break;
+			}
+		}
+
+		// If last, activate recovery
+		if (EmptyFleet)
+		{
+			GetGame()->GetPC()->GetMenuManager()->OpenMenu(EFlareMenu::MENU_GameOver);
+		}
 	}
 
-	// Clear bombs
-	for (int SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
+	// Check player position in leaderboard
+	bool IsFirst = true;
+	bool IsLast = true;
+
+
+	int64 PlayerValue = PlayerCompany->GetCompanyValue().TotalValue;
+
+	for(UFlareCompany* Company: GetCompanies())
 	{
-		Sectors[SectorIndex]->ClearBombs();
-	}
+		if (Company == PlayerCompany)
+		{
+			 continue;
+		}
+		int64 CompanyValue = Company->GetCompanyValue().TotalValue;
 
+		if(CompanyValue > PlayerValue)
+		{
+			IsFirst = false;
+		}
+		else if(CompanyValue < PlayerValue)
+		{
+			IsLast = false;
+		}
+	}
 
-	// Process meteorites
-	for (UFlareSimulatedSector* Sector :Sectors)
+	if(!IsLast)
 	{
-		Sector->ProcessMeteorites();
+		GetGame()->GetPC()->SetAchievementProgression("ACHIEVEMENT_NOT_LAST", 1);
 	}
 
-	// GenerateMeteorites
-	for (UFlareSimulatedSector* Sector :Sectors)
+	if(IsFirst)
 	{
-		Sector->GenerateMeteorites();
+		GetGame()->GetPC()->SetAchievementProgression("ACHIEVEMENT_FIRST", 1);
 	}
 
+	// Check if all ship
+	 int32 ShipTypeCount = GetGame()->GetSpacecraftCatalog()->ShipCatalog.Num();
 
-	CompanyMutualAssistance();
-	CheckIntegrity();
+	 TArray<FFlareSpacecraftDescription*> Descriptions;
 
-	/**
-	 *  Begin day
-	 */
-	FLOG("* Simulate > New day");
+	 for(UFlareSimulatedSpacecraft* Ship : GetGame()->GetPC()->GetCompany()->GetCompanyShips())
+	 {
+		 if(Ship->GetDamageSystem()->IsAlive())
+		 {
+			 Descriptions.AddUnique(Ship->GetDescription());
+		 }
+	 }
 
-	WorldData.Date++;
+	 if(Descriptions.Num() == ShipTypeCount)
+	 {
+		 GetGame()->GetPC()->SetAchievementProgression("ACHIEVEMENT_ALL_SHIPS", 1);
+	 }
+}
 
-	// Write FS consumption stats
-	for (UFlareSimulatedSector* Sector :Sectors)
+void UFlareWorld::GetSimulationStatsHistory(TArray<FFlareSimulationDayStats>& OutStats) const
+{
+	OutStats.Empty(SimulationStatsHistory.Num());
+
+	// The oldest entry is the next one to be overwritten once the buffer is full
+	int32 FirstIndex = (SimulationStatsHistory.Num() < SIMULATION_STATS_HISTORY_SIZE) ? 0 : SimulationStatsHistoryIndex;
+	for (int32 Index = 0; Index < SimulationStatsHistory.Num(); Index++)
 	{
-		Sector->UpdateFleetSupplyConsumptionStats();
+		OutStats.Add(SimulationStatsHistory[(FirstIndex + Index) % SimulationStatsHistory.Num()]);
 	}
+}
 
-	// Count repairing fleet
-	int32 PlayerRepairingFleet = 0;
-	int32 PlayerRefillingFleet = 0;
-	for (UFlareFleet* Fleet : GetGame()->GetPC()->GetCompany()->GetCompanyFleets())
+const TCHAR* UFlareWorld::GetSimulationPhaseName(EFlareSimulationPhase::Type Phase)
+{
+	switch (Phase)
+	{
+		case EFlareSimulationPhase::PlayerAutoTrade:  return TEXT("PlayerAutoTrade");
+		case EFlareSimulationPhase::Battles:          return TEXT("Battles");
+		case EFlareSimulationPhase::AITrading:        return TEXT("AITrading");
+		case EFlareSimulationPhase::AIPlanning:       return TEXT("AIPlanning");
+		case EFlareSimulationPhase::AICompanies:      return TEXT("AICompanies");
+		case EFlareSimulationPhase::Meteorites:       return TEXT("Meteorites");
+		case EFlareSimulationPhase::Fleets:           return TEXT("Fleets");
+		case EFlareSimulationPhase::Factories:        return TEXT("Factories");
+		case EFlareSimulationPhase::People:           return TEXT("People");
+		case EFlareSimulationPhase::TradeRoutes:      return TEXT("TradeRoutes");
+		case EFlareSimulationPhase::Travels:          return TEXT("Travels");
+		case EFlareSimulationPhase::Prices:           return TEXT("Prices");
+		case EFlareSimulationPhase::PeopleMigration:  return TEXT("PeopleMigration");
+		case EFlareSimulationPhase::EndOfDay:         return TEXT("EndOfDay");
+		default:                                      return TEXT("Unknown");
+	}
+}
+
+void UFlareWorld::ForEachSector(int32 Seed, TFunctionRef<void(UFlareSimulatedSector*, int32, const FRandomStream&)> Function)
+{
+	ParallelFor(Sectors.Num(), [this, Seed, &Function](int32 SectorIndex)
 	{
-		if(Fleet->IsRepairing())
-		{
-			PlayerRepairingFleet++;
-		}
+		// The stream only depends on the seed and the sector, so the result is the same whatever the thread and order
+		FRandomStream RandomStream(HashCombine(Seed, SectorIndex));
+		Function(Sectors[SectorIndex], SectorIndex, RandomStream);
+	}, !UFlareGameTools::ParallelSimulation);
+}
 
-		if(Fleet->IsRefilling())
-		{
-			PlayerRefillingFleet++;
-		}
-	}
+void UFlareWorld::SwapPricesAndUpdateReserveShips(int32 Seed)
+{
+	// The settings and the player are read on the game thread
+	FFlareReserveShipsInputs Inputs;
+	Inputs.MaxShipsInSector = Cast<UFlareGameUserSettings>(GEngine->GetGameUserSettings())->MaxShipsInSector;
+	Inputs.PlayerShip = GetGame()->GetPC()->GetPlayerShip();
+	Inputs.PlayerFleet = GetGame()->GetPC()->GetPlayerFleet();
 
+	// The battle state of the player depends on the active sector, compute it before going wide
+	TArray<bool> PlayerInBattle;
+	PlayerInBattle.SetNum(Sectors.Num());
+	for (int32 SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
+	{
+		PlayerInBattle[SectorIndex] = Sectors[SectorIndex]->GetSectorBattleState(GetGame()->GetPC()->GetCompany()).InBattle;
+	}
 
-	// End trade, intercept, repair and refill, operations
-	for (int CompanyIndex = 0; CompanyIndex < Companies.Num(); CompanyIndex++)
+	ForEachSector(Seed, [&Inputs, &PlayerInBattle](UFlareSimulatedSector* Sector, int32 SectorIndex, const FRandomStream& RandomStream)
 	{
-		UFlareCompany* Company = Companies[CompanyIndex];
+		Sector->SwapPrices();
+		Sector->UpdateReserveShips(RandomStream, Inputs, PlayerInBattle[SectorIndex]);
+	});
+}
 
-		for (int32 SpacecraftIndex = 0; SpacecraftIndex < Company->GetCompanySpacecrafts().Num(); SpacecraftIndex++)
+void UFlareWorld::SimulateBattles(int32 Seed)
+{
+	// Take the hostility snapshot of the day, the parallel battles only read it
+	UpdateHostilityMatrix();
+
+	// Serial simulation : each battle sees the effects of the previous sectors, and applies its own as they happen
+	if (!UFlareGameTools::ParallelSimulation)
+	{
+		for (int32 SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
 		{
-			UFlareSimulatedSpacecraft* Spacecraft = Company->GetCompanySpacecrafts()[SpacecraftIndex];
-			if (!Spacecraft->IsStation())
+			UFlareSimulatedSector* Sector = Sectors[SectorIndex];
+
+			if (IsBattleSector(Sector))
 			{
-				Spacecraft->SetTrading(false);
-				Spacecraft->SetIntercepted(false);
+				UFlareBattle* Battle = NewObject<UFlareBattle>(this, UFlareBattle::StaticClass());
+				Battle->Load(Sector, HashCombine(Seed, SectorIndex), false);
+				Battle->Simulate();
 			}
-			Spacecraft->Repair();
-			Spacecraft->Refill();
-			Spacecraft->Stabilize();
+
+			RemoveDestroyedSpacecrafts(Sector);
 		}
+		return;
 	}
 
+	TArray<UFlareBattle*> Battles;
+	CreateBattles(Seed, Battles);
+	RunBattles(Battles);
 
-	int32 PlayerRepairingFleetAfter = 0;
-	int32 PlayerRefillingFleetAfter = 0;
-	for (UFlareFleet* Fleet : GetGame()->GetPC()->GetCompany()->GetCompanyFleets())
+	// Effects outside the battle sectors are applied in sector order, whatever the order the battles ended in
+	for (UFlareBattle* Battle : Battles)
 	{
-		if(Fleet->IsRepairing())
-		{
-			PlayerRepairingFleetAfter++;
-		}
+		Battle->ApplyDeferredEffects();
+	}
 
-		if(Fleet->IsRefilling())
-		{
-			PlayerRefillingFleetAfter++;
-		}
+	for (UFlareSimulatedSector* Sector : Sectors)
+	{
+		RemoveDestroyedSpacecrafts(Sector);
 	}
+}
+
+void UFlareWorld::RemoveDestroyedSpacecrafts(UFlareSimulatedSector* Sector)
+{
+	TArray<UFlareSimulatedSpacecraft*> SpacecraftToRemove;
 
-	if (PlayerRepairingFleetAfter < PlayerRepairingFleet)
+	for (int32 SpacecraftIndex = 0 ; SpacecraftIndex < Sector->GetSectorSpacecrafts().Num(); SpacecraftIndex++)
 	{
-		FText RepairText;
+		UFlareSimulatedSpacecraft* Spacecraft = Sector->GetSectorSpacecrafts()[SpacecraftIndex];
 
-		if (GetGame()->GetPC()->GetCompany()->GetCompanyFleets().Num() == 1)
+		if(!Spacecraft->GetDamageSystem()->IsAlive() && !Spacecraft->GetDescription()->IsSubstation)
 		{
-			RepairText = LOCTEXT("YouFleetRepairFinish", "Your fleet repairs are finished");
-		}
-		else if (PlayerRepairingFleet - PlayerRepairingFleetAfter > 1)
-		{
-			RepairText = LOCTEXT("MultipleFleetRepairFinish", "Some fleet repairs are finished");
-		}
-		else
-		{
-			RepairText = LOCTEXT("OneFleetRepairFinish", "One fleet repair is finished");
+			SpacecraftToRemove.Add(Spacecraft);
 		}
+	}
 
-		FFlareMenuParameterData MenuData;
-		GetGame()->GetPC()->Notify(LOCTEXT("FeetRepaired", "Repaired"),
-			RepairText,
-			FName("fleet-repaired"),
-			EFlareNotification::NT_Military,
-			false,
-			EFlareMenu::MENU_Orbit,
-			MenuData);
+	for (int SpacecraftIndex = 0; SpacecraftIndex < SpacecraftToRemove.Num(); SpacecraftIndex++)
+	{
+		UFlareSimulatedSpacecraft* Spacecraft = SpacecraftToRemove[SpacecraftIndex];
+		Spacecraft->GetCompany()->DestroySpacecraft(Spacecraft);
 	}
+}
+
+bool UFlareWorld::IsBattleSector(UFlareSimulatedSector* Sector)
+{
+	UFlareCompany* PlayerCompany = GetGame()->GetPC()->GetCompany();
 
-	if (PlayerRefillingFleetAfter < PlayerRefillingFleet)
+	for (int CompanyIndex = 0; CompanyIndex < Companies.Num(); CompanyIndex++)
 	{
-		FText RefillText;
+		UFlareCompany* Company = Companies[CompanyIndex];
 
-		if(GetGame()->GetPC()->GetCompany()->GetCompanyFleets().Num() == 1)
+		if (Company == PlayerCompany && Sector == GetGame()->GetPC()->GetPlayerShip()->GetCurrentSector())
 		{
-			RefillText = LOCTEXT("YouFleetRefill", "Your fleet refillings are finished");
-		}
-		else if (PlayerRefillingFleet - PlayerRefillingFleetAfter > 1)
-		{
-			RefillText = LOCTEXT("MultipleFleetRefillFinish", "Some fleet refillings are finished");
+			// Local sector, don't check if the player want fight
+			continue;
 		}
-		else
+
+		FFlareSectorBattleState BattleState = Sector->GetSectorBattleState(Company);
+
+		if(!BattleState.WantFight())
 		{
-			RefillText = LOCTEXT("OneFleetRefillFinish", "One fleet refilling is finished");
+			// Don't want fight
+			continue;
 		}
 
-		FFlareMenuParameterData MenuData;
-		GetGame()->GetPC()->Notify(LOCTEXT("FeetRefilled", "Refilled"),
-			RefillText,
-			FName("fleet-refilled"),
-			EFlareNotification::NT_Military,
-			false,
-			EFlareMenu::MENU_Orbit,
-			MenuData);
+		FLOGV("%s want fight in %s", *Company->GetCompanyName().ToString(),
+			  *Sector->GetSectorName().ToString());
+
+		return true;
 	}
 
-	// Spacrecraft capture
-	ProcessShipCapture();
-	ProcessStationCapture();
+	return false;
+}
+
+void UFlareWorld::CreateBattles(int32 Seed, TArray<UFlareBattle*>& OutBattles)
+{
+	OutBattles.Reset();
 
-	// Factories
-	FLOG("* Simulate > Factories");
-	for (UFlareFactory* Factory: Factories)
+	for (int SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
 	{
-		if(Factory->IsShipyard())
+		UFlareSimulatedSector* Sector = Sectors[SectorIndex];
+
+		if (IsBattleSector(Sector))
 		{
-			Factory->GetParent()->UpdateShipyardProduction();
+			// UObjects are created on the game thread, before the battles go wide
+			UFlareBattle* Battle = NewObject<UFlareBattle>(this, UFlareBattle::StaticClass());
+			Battle->Load(Sector, HashCombine(Seed, SectorIndex), true);
+			OutBattles.Add(Battle);
 		}
 	}
+}
 
-	for (int FactoryIndex = 0; FactoryIndex < Factories.Num(); FactoryIndex++)
+void UFlareWorld::RunBattles(const TArray<UFlareBattle*>& Battles)
+{
+	// Each battle only touches the spacecrafts of its sector, and reads the hostility matrix without a lock :
+	// nothing may update the matrix until the battles are done, the effects that do are deferred
+	ParallelFor(Battles.Num(), [&Battles](int32 BattleIndex)
 	{
-		Factories[FactoryIndex]->Simulate();
-	}
+		Battles[BattleIndex]->Simulate();
+	}, !UFlareGameTools::ParallelSimulation);
+}
 
+/** Sector state written by the per-sector steps of a day */
+struct FFlareSectorSimulationState
+{
+	TArray<FFFlareResourcePrice> ResourcePrices;
+	FFlareFloatBuffer FleetSupplyConsumptionStats;
+	int32 DailyFleetSupplyConsumption;
+	TArray<bool> ShipReserve;
+	TArray<UFlareSimulatedSpacecraft*> MeteoriteTargets;
 
-	// Peoples
-	FLOG("* Simulate > Peoples");
-	for (int SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
+	void Capture(UFlareSimulatedSector* Sector)
 	{
-		Sectors[SectorIndex]->GetPeople()->Simulate();
-	}
-
+		Sector->SaveResourcePrices();
+		ResourcePrices = Sector->GetData()->ResourcePrices;
+		FleetSupplyConsumptionStats = Sector->GetData()->FleetSupplyConsumptionStats;
+		DailyFleetSupplyConsumption = Sector->GetData()->DailyFleetSupplyConsumption;
 
-	FLOG("* Simulate > Trade routes");
+		ShipReserve.Empty(Sector->GetSectorShips().Num());
+		for (UFlareSimulatedSpacecraft* Ship : Sector->GetSectorShips())
+		{
+			ShipReserve.Add(Ship->IsReserve());
+		}
+	}
 
-	// Trade routes
-	for (int CompanyIndex = 0; CompanyIndex < Companies.Num(); CompanyIndex++)
+	void Restore(UFlareSimulatedSector* Sector) const
 	{
-		TArray<UFlareTradeRoute*>& TradeRoutes = Companies[CompanyIndex]->GetCompanyTradeRoutes();
+		Sector->GetData()->ResourcePrices = ResourcePrices;
+		Sector->LoadResourcePrices();
+		Sector->GetData()->FleetSupplyConsumptionStats = FleetSupplyConsumptionStats;
+		Sector->GetData()->DailyFleetSupplyConsumption = DailyFleetSupplyConsumption;
 
-		for (int RouteIndex = 0; RouteIndex < TradeRoutes.Num(); RouteIndex++)
+		for (int32 ShipIndex = 0; ShipIndex < Sector->GetSectorShips().Num(); ShipIndex++)
 		{
-			TradeRoutes[RouteIndex]->Simulate();
+			Sector->GetSectorShips()[ShipIndex]->SetReserve(ShipReserve[ShipIndex]);
 		}
 	}
-	FLOG("* Simulate > Travels");
 
-	// Undock and make move AI ships
-	for (UFlareSimulatedSector* Sector : Sectors)
+	bool Equals(const FFlareSectorSimulationState& Other) const
 	{
-		for(UFlareSimulatedSpacecraft* Ship : Sector->GetSectorShips())
+		if (ResourcePrices.Num() != Other.ResourcePrices.Num()
+		 || FleetSupplyConsumptionStats.WriteIndex != Other.FleetSupplyConsumptionStats.WriteIndex
+		 || FleetSupplyConsumptionStats.Values != Other.FleetSupplyConsumptionStats.Values
+		 || DailyFleetSupplyConsumption != Other.DailyFleetSupplyConsumption
+		 || ShipReserve != Other.ShipReserve
+		 || MeteoriteTargets != Other.MeteoriteTargets)
+		{
+			return false;
+		}
+
+		for (int32 PriceIndex = 0; PriceIndex < ResourcePrices.Num(); PriceIndex++)
 		{
-			if(Ship->GetCompany() != PlayerCompany)
+			const FFFlareResourcePrice& Price = ResourcePrices[PriceIndex];
+			const FFFlareResourcePrice& OtherPrice = Other.ResourcePrices[PriceIndex];
+
+			if (Price.ResourceIdentifier != OtherPrice.ResourceIdentifier
+			 || Price.Price != OtherPrice.Price
+			 || Price.Prices.WriteIndex != OtherPrice.Prices.WriteIndex
+			 || Price.Prices.Values != OtherPrice.Prices.Values)
 			{
-				// Undock
-				Ship->ForceUndock();
-				Ship->SetSpawnMode(EFlareSpawnMode::Travel);
+				return false;
 			}
 		}
+
+		return true;
 	}
+};
 
-	// Travels
-	TArray<UFlareTravel*> TravelsToProcess = Travels;
-	for (int TravelIndex = 0; TravelIndex < TravelsToProcess.Num(); TravelIndex++)
+bool UFlareWorld::CheckParallelSectorSimulation()
+{
+	bool WasParallel = UFlareGameTools::ParallelSimulation;
+	int32 MeteoriteSeed = FMath::Rand();
+	int32 ReserveSeed = FMath::Rand();
+
+	TArray<FFlareSectorSimulationState> InitialStates;
+	InitialStates.SetNum(Sectors.Num());
+	for (int32 SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
 	{
-		TravelsToProcess[TravelIndex]->Simulate();
+		InitialStates[SectorIndex].Capture(Sectors[SectorIndex]);
 	}
-	
-	FLOG("* Simulate > Prices");
-	// Price variation.
-	for (int SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
+
+	// Same steps as Simulate, in the same order
+	auto SimulateSectors = [&](bool Parallel, TArray<FFlareSectorSimulationState>& States)
 	{
-		Sectors[SectorIndex]->SimulatePriceVariation();
-	}
+		UFlareGameTools::ParallelSimulation = Parallel;
+		States.SetNum(Sectors.Num());
 
-	// People money migration
-	SimulatePeopleMoneyMigration();
+		ForEachSector(MeteoriteSeed, [&States](UFlareSimulatedSector* Sector, int32 SectorIndex, const FRandomStream& RandomStream)
+		{
+			Sector->PickMeteoriteTargets(RandomStream, States[SectorIndex].MeteoriteTargets);
+		});
 
-	// Process events
+		ForEachSector(0, [](UFlareSimulatedSector* Sector, int32 SectorIndex, const FRandomStream& RandomStream)
+		{
+			Sector->UpdateFleetSupplyConsumptionStats();
+		});
 
-	// Swap Prices.
-	for (int SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
-	{
-		Sectors[SectorIndex]->SwapPrices();
-	}
-	
-	// Update reserve ships
-	for (int SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
+		ForEachSector(0, [](UFlareSimulatedSector* Sector, int32 SectorIndex, const FRandomStream& RandomStream)
+		{
+			Sector->SimulatePriceVariation();
+		});
+
+		SwapPricesAndUpdateReserveShips(ReserveSeed);
+
+		for (int32 SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
+		{
+			States[SectorIndex].Capture(Sectors[SectorIndex]);
+			InitialStates[SectorIndex].Restore(Sectors[SectorIndex]);
+		}
+	};
+
+	TArray<FFlareSectorSimulationState> SerialStates;
+	TArray<FFlareSectorSimulationState> ParallelStates;
+	SimulateSectors(false, SerialStates);
+	SimulateSectors(true, ParallelStates);
+	UFlareGameTools::ParallelSimulation = WasParallel;
+
+	bool Deterministic = true;
+	for (int32 SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
 	{
-		Sectors[SectorIndex]->UpdateReserveShips();
+		if (!SerialStates[SectorIndex].Equals(ParallelStates[SectorIndex]))
+		{
+			FLOGV("UFlareWorld::CheckParallelSectorSimulation : parallel result differs in %s", *Sectors[SectorIndex]->GetSectorName().ToString());
+			Deterministic = false;
+		}
 	}
 
-	// Update storage station reservation
-	UpdateStorageLocks();
-
-	// Player being attacked ?
-	ProcessIncomingPlayerEnemy();
+	return Deterministic;
+}
 
-	// Lets AI check if in battle
-	CheckAIBattleState();
+bool UFlareWorld::CheckParallelBattleSimulation(int32 Seed)
+{
+	bool WasParallel = UFlareGameTools::ParallelSimulation;
+	UFlareSpacecraftComponentsCatalog* Catalog = Game->GetShipPartsCatalog();
 
-	for (UFlareCompany* Company : Companies)
+	TArray<UFlareBattle*> Battles;
+	TArray<UFlareSimulatedSector*> BattleSectors;
+	CreateBattles(Seed, Battles);
+	for (UFlareBattle* Battle : Battles)
 	{
-		Company->InvalidateCompanyValueCache();
+		BattleSectors.Add(Battle->GetSector());
 	}
 
-	
-	double EndTs = FPlatformTime::Seconds();
-	FLOGV("** Simulate day %d done in %.6fs", WorldData.Date-1, EndTs- StartTs);
+	FFlareBattleSimulationState InitialState;
+	InitialState.Capture(BattleSectors);
 
-	Game->GetQuestManager()->OnNextDay();
+	// Fight without the deferred effects, the last damage causes are the only state not restored
+	auto FightBattles = [&](bool Parallel, FFlareBattleSimulationState& State)
+	{
+		UFlareGameTools::ParallelSimulation = Parallel;
 
-	GameLog::DaySimulated(WorldData.Date);
+		CreateBattles(Seed, Battles);
+		RunBattles(Battles);
 
-	// Check recovery
-	{
-		// Check if it the last ship
-		bool EmptyFleet = true;
-		for(int ShipIndex = 0; ShipIndex < GetGame()->GetPC()->GetPlayerFleet()->GetShips().Num(); ShipIndex++)
+		State.Capture(BattleSectors);
+		State.Events.Reset();
+		for (UFlareBattle* Battle : Battles)
 		{
-			UFlareSimulatedSpacecraft* Ship = GetGame()->GetPC()->GetPlayerFleet()->GetShips()[ShipIndex];
-			if(Ship->GetDamageSystem()->IsAlive() && !Ship->GetDamageSystem()->IsUncontrollable())
-			{
-				EmptyFleet = false;
-				break;
-			}
+			State.Events.Add(Battle->GetEvents());
 		}
 
-		// If last, activate recovery
-		if (EmptyFleet)
-		{
-			GetGame()->GetPC()->GetMenuManager()->OpenMenu(EFlareMenu::MENU_GameOver);
-		}
-	}
+		InitialState.Restore(Catalog);
+	};
 
-	// Check player position in leaderboard
-	bool IsFirst = true;
-	bool IsLast = true;
+	FFlareBattleSimulationState SerialState;
+	FFlareBattleSimulationState ParallelState;
+	FightBattles(false, SerialState);
+	FightBattles(true, ParallelState);
+	UFlareGameTools::ParallelSimulation = WasParallel;
 
+	FLOGV("UFlareWorld::CheckParallelBattleSimulation : %d battles", BattleSectors.Num());
+	return SerialState.Equals(ParallelState);
+}
 
-	int64 PlayerValue = PlayerCompany->GetCompanyValue().TotalValue;
+void UFlareWorld::PlanCompanyAI()
+{
+	UFlareCompany* PlayerCompany = Game->GetPC()->GetCompany();
 
-	for(UFlareCompany* Company: GetCompanies())
+	// The trading behavior is read by the analysis
+	for (UFlareCompany* Company : Companies)
 	{
-		if (Company == PlayerCompany)
+		if (Company != PlayerCompany)
 		{
-			 continue;
+			Company->GetAI()->GetBehavior()->Load(Company);
 		}
-		int64 CompanyValue = Company->GetCompanyValue().TotalValue;
+	}
 
-		if(CompanyValue > PlayerValue)
+	const TArray<FFlareResourceStats>& Stats = GetResourceStats(true);
+	TArray<TArray<SectorVariation>> Variations;
+	AITradeHelper::ComputeCompaniesResourceVariation(this, Variations);
+
+	// Same known sector order as UFlareCompanyAI::Simulate
+	for (int32 CompanyIndex = 0; CompanyIndex < Companies.Num(); CompanyIndex++)
+	{
+		UFlareCompany* Company = Companies[CompanyIndex];
+		if (Company == PlayerCompany)
 		{
-			IsFirst = false;
+			continue;
 		}
-		else if(CompanyValue < PlayerValue)
+
+		TMap<UFlareSimulatedSector*, SectorVariation> WorldResourceVariation;
+		for (UFlareSimulatedSector* Sector : Company->GetKnownSectors())
 		{
-			IsLast = false;
+			WorldResourceVariation.Add(Sector, MoveTemp(Variations[Sector->GetWorldIndex()][CompanyIndex]));
 		}
+
+		Company->GetAI()->SetPlan(Stats, WorldResourceVariation);
 	}
+}
 
-	if(!IsLast)
+bool UFlareWorld::CheckParallelCompanyAIPlan(int32 Iterations, double& SerialTime, double& ParallelTime)
+{
+	bool WasParallel = UFlareGameTools::ParallelSimulation;
+	UFlareCompany* PlayerCompany = Game->GetPC()->GetCompany();
+
+	for (UFlareCompany* Company : Companies)
 	{
-		GetGame()->GetPC()->SetAchievementProgression("ACHIEVEMENT_NOT_LAST", 1);
+		if (Company != PlayerCompany)
+		{
+			Company->GetAI()->GetBehavior()->Load(Company);
+		}
 	}
 
-	if(IsFirst)
+	auto Plan = [&](bool Parallel, TArray<TArray<SectorVariation>>& Variations)
 	{
-		GetGame()->GetPC()->SetAchievementProgression("ACHIEVEMENT_FIRST", 1);
-	}
+		UFlareGameTools::ParallelSimulation = Parallel;
 
-	// Check if all ship
-	 int32 ShipTypeCount = GetGame()->GetSpacecraftCatalog()->ShipCatalog.Num();
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			AITradeHelper::ComputeCompaniesResourceVariation(this, Variations);
+		}
+		return FPlatformTime::Seconds() - StartTime;
+	};
 
-	 TArray<FFlareSpacecraftDescription*> Descriptions;
+	TArray<TArray<SectorVariation>> SerialVariations;
+	TArray<TArray<SectorVariation>> ParallelVariations;
+	SerialTime = Plan(false, SerialVariations);
+	ParallelTime = Plan(true, ParallelVariations);
+	UFlareGameTools::ParallelSimulation = WasParallel;
 
-	 for(UFlareSimulatedSpacecraft* Ship : GetGame()->GetPC()->GetCompany()->GetCompanyShips())
-	 {
-		 if(Ship->GetDamageSystem()->IsAlive())
-		 {
-			 Descriptions.AddUnique(Ship->GetDescription());
-		 }
-	 }
+	// Compare the variations of the known sectors
+	for (int32 CompanyIndex = 0; CompanyIndex < Companies.Num(); CompanyIndex++)
+	{
+		UFlareCompany* Company = Companies[CompanyIndex];
+		if (Company == PlayerCompany)
+		{
+			continue;
+		}
 
-	 if(Descriptions.Num() == ShipTypeCount)
-	 {
-		 GetGame()->GetPC()->SetAchievementProgression("ACHIEVEMENT_ALL_SHIPS", 1);
-	 }
+		for (UFlareSimulatedSector* Sector : Company->GetKnownSectors())
+		{
+			const SectorVariation& Serial = SerialVariations[Sector->GetWorldIndex()][CompanyIndex];
+			const SectorVariation& Parallel = ParallelVariations[Sector->GetWorldIndex()][CompanyIndex];
+
+			if (Serial.IncomingCapacity != Parallel.IncomingCapacity
+			 || Serial.ResourceVariations.Num() != Parallel.ResourceVariations.Num()
+			 || FMemory::Memcmp(Serial.ResourceVariations.GetData(), Parallel.ResourceVariations.GetData(), Serial.ResourceVariations.Num() * sizeof(ResourceVariation)) != 0)
+			{
+				FLOGV("UFlareWorld::CheckParallelCompanyAIPlan : %s differs in %s",
+					*Company->GetCompanyName().ToString(), *Sector->GetSectorName().ToString());
+				return false;
+			}
+		}
+	}
+
+	return true;
 }
 
 void UFlareWorld::CheckAIBattleState()
@@ -1671,6 +2231,7 @@ UFlareTravel* UFlareWorld::	StartTravel(UFlareFleet* TravelingFleet, UFlareSimul
 
 	if (TravelingFleet->IsTraveling())
 	{
+		InvalidateIncomingEvents();
 		TravelingFleet->GetCurrentTravel()->ChangeDestination(DestinationSector);
 		return TravelingFleet->GetCurrentTravel();
 	}
@@ -1735,6 +2296,7 @@ UFlareTravel* UFlareWorld::	StartTravel(UFlareFleet* TravelingFleet, UFlareSimul
 		TravelData.DepartureDate = GetDate();
 		UFlareTravel::InitTravelSector(TravelData.SectorData);
 		UFlareTravel* Travel = LoadTravel(TravelData);
+		InvalidateIncomingEvents();
 
 		GetGame()->GetQuestManager()->OnTravelStarted(Travel);
 
@@ -1745,6 +2307,7 @@ UFlareTravel* UFlareWorld::	StartTravel(UFlareFleet* TravelingFleet, UFlareSimul
 void UFlareWorld::DeleteTravel(UFlareTravel* Travel)
 {
 	Travels.Remove(Travel);
+	InvalidateIncomingEvents();
 }
 
 /*----------------------------------------------------
@@ -1782,84 +2345,111 @@ UFlareCompany* UFlareWorld::FindCompanyByShortName(FName CompanyShortName) const
 
 UFlareSimulatedSector* UFlareWorld::FindSector(FName Identifier) const
 {
-	for (int i = 0; i < Sectors.Num(); i++)
+	UFlareSimulatedSector* const* Sector = SectorsByIdentifier.Find(Identifier);
+	return Sector ? *Sector : NULL;
+}
+
+UFlareSimulatedSector* UFlareWorld::FindSectorBySpacecraft(FName SpacecraftIdentifier) const
+{
+	UFlareSimulatedSpacecraft* Spacecraft = FindRegisteredSpacecraft(SpacecraftIdentifier, false);
+	return Spacecraft ? Spacecraft->GetCurrentSector() : NULL;
+}
+
+UFlareFleet* UFlareWorld::FindFleet(FName Identifier) const
+{
+	UFlareFleet* const* Fleet = FleetsByIdentifier.Find(Identifier);
+	return Fleet ? *Fleet : NULL;
+}
+
+UFlareTradeRoute* UFlareWorld::FindTradeRoute(FName Identifier) const
+{
+	UFlareTradeRoute* const* TradeRoute = TradeRoutesByIdentifier.Find(Identifier);
+	return TradeRoute ? *TradeRoute : NULL;
+}
+
+UFlareSimulatedSpacecraft* UFlareWorld::FindSpacecraft(FName ShipImmatriculation)
+{
+	UFlareSimulatedSpacecraft* Spacecraft = FindRegisteredSpacecraft(ShipImmatriculation, false);
+	if (Spacecraft)
 	{
-		UFlareSimulatedSector* Sector = Sectors[i];
-		if (Sector->GetIdentifier() == Identifier)
-		{
-			return Sector;
-		}
+		return Spacecraft;
 	}
 
-	return NULL;
+	// Now check destroyed ships
+	return FindRegisteredSpacecraft(ShipImmatriculation, true);
 }
 
-UFlareSimulatedSector* UFlareWorld::FindSectorBySpacecraft(FName SpacecraftIdentifier) const
+UFlareSimulatedSpacecraft* UFlareWorld::FindRegisteredSpacecraft(FName ShipImmatriculation, bool Destroyed) const
 {
-	for (int i = 0; i < Sectors.Num(); i++)
+	const TMap<FName, UFlareSimulatedSpacecraft*>& Registry = Destroyed ? DestroyedSpacecraftsByImmatriculation : SpacecraftsByImmatriculation;
+	UFlareSimulatedSpacecraft* const* Spacecraft = Registry.Find(ShipImmatriculation);
+	return Spacecraft ? *Spacecraft : NULL;
+}
+
+void UFlareWorld::RegisterSpacecraft(UFlareSimulatedSpacecraft* Spacecraft)
+{
+	// Same content as the company spacecraft lists : complex elements are only found once destroyed
+	if (Spacecraft->IsDestroyed())
 	{
-		UFlareSimulatedSector* Sector = Sectors[i];
-		for (int j = 0; j < Sector->GetSectorSpacecrafts().Num(); j++)
+		if (!DestroyedSpacecraftsByImmatriculation.Contains(Spacecraft->GetImmatriculation()))
 		{
-			if (Sector->GetSectorSpacecrafts()[j]->GetDescription()->Identifier == SpacecraftIdentifier)
-			{
-				return Sector;
-			}
+			DestroyedSpacecraftsByImmatriculation.Add(Spacecraft->GetImmatriculation(), Spacecraft);
+		}
+	}
+	else if (!Spacecraft->IsComplexElement())
+	{
+		if (!SpacecraftsByImmatriculation.Contains(Spacecraft->GetImmatriculation()))
+		{
+			SpacecraftsByImmatriculation.Add(Spacecraft->GetImmatriculation(), Spacecraft);
 		}
 	}
-	return NULL;
 }
 
-UFlareFleet* UFlareWorld::FindFleet(FName Identifier) const
+void UFlareWorld::UnregisterSpacecraft(UFlareSimulatedSpacecraft* Spacecraft)
 {
-	for (int i = 0; i < Companies.Num(); i++)
+	FName Immatriculation = Spacecraft->GetImmatriculation();
+
+	if (FindRegisteredSpacecraft(Immatriculation, false) == Spacecraft)
 	{
-		UFlareCompany* Company = Companies[i];
-		UFlareFleet* Fleet = Company->FindFleet(Identifier);
-		if (Fleet)
-		{
-			return Fleet;
-		}
+		SpacecraftsByImmatriculation.Remove(Immatriculation);
+	}
+
+	if (FindRegisteredSpacecraft(Immatriculation, true) == Spacecraft)
+	{
+		DestroyedSpacecraftsByImmatriculation.Remove(Immatriculation);
 	}
-	return NULL;
 }
 
-UFlareTradeRoute* UFlareWorld::FindTradeRoute(FName Identifier) const
+void UFlareWorld::RegisterFleet(UFlareFleet* Fleet)
 {
-	for (int i = 0; i < Companies.Num(); i++)
+	if (!FleetsByIdentifier.Contains(Fleet->GetIdentifier()))
 	{
-		UFlareCompany* Company = Companies[i];
-		UFlareTradeRoute* TradeRoute = Company->FindTradeRoute(Identifier);
-		if (TradeRoute)
-		{
-			return TradeRoute;
-		}
+		FleetsByIdentifier.Add(Fleet->GetIdentifier(), Fleet);
 	}
-	return NULL;
 }
 
-UFlareSimulatedSpacecraft* UFlareWorld::FindSpacecraft(FName ShipImmatriculation)
+void UFlareWorld::UnregisterFleet(UFlareFleet* Fleet)
 {
-	for (UFlareCompany* Company : Companies)
+	if (FindFleet(Fleet->GetIdentifier()) == Fleet)
 	{
-		UFlareSimulatedSpacecraft* Spacecraft = Company->FindSpacecraft(ShipImmatriculation);
-		if (Spacecraft)
-		{
-			return Spacecraft;
-		}
+		FleetsByIdentifier.Remove(Fleet->GetIdentifier());
 	}
+}
 
-	// Now check destroyed ships
-	for (UFlareCompany* Company : Companies)
+void UFlareWorld::RegisterTradeRoute(UFlareTradeRoute* TradeRoute)
+{
+	if (!TradeRoutesByIdentifier.Contains(TradeRoute->GetIdentifier()))
 	{
-		UFlareSimulatedSpacecraft* Spacecraft = Company->FindSpacecraft(ShipImmatriculation, true);
-		if (Spacecraft)
-		{
-			return Spacecraft;
-		}
+		TradeRoutesByIdentifier.Add(TradeRoute->GetIdentifier(), TradeRoute);
 	}
+}
 
-	return NULL;
+void UFlareWorld::UnregisterTradeRoute(UFlareTradeRoute* TradeRoute)
+{
+	if (FindTradeRoute(TradeRoute->GetIdentifier()) == TradeRoute)
+	{
+		TradeRoutesByIdentifier.Remove(TradeRoute->GetIdentifier());
+	}
 }
 
 
@@ -1917,9 +2507,42 @@ uint32 UFlareWorld::GetWorldPopulation()
 
 	return WorldPopulation;
 }
-TArray<FFlareIncomingEvent> UFlareWorld::GetIncomingEvents()
+const TArray<FFlareIncomingEvent>& UFlareWorld::GetIncomingEvents()
+{
+	if (!HasIncomingEventsCache)
+	{
+		IncomingEventsCache.Reset();
+		ComputeIncomingEvents(IncomingEventsCache);
+
+		// Build the text once, the orbital menu reads it every frame
+		FString Result;
+		for (const FFlareIncomingEvent& Event : IncomingEventsCache)
+		{
+			Result += Event.Text.ToString() + "\n";
+		}
+		IncomingEventsTextCache = FText::FromString(Result);
+
+		HasIncomingEventsCache = true;
+	}
+
+	return IncomingEventsCache;
+}
+
+const FText& UFlareWorld::GetIncomingEventsText()
+{
+	GetIncomingEvents();
+	return IncomingEventsTextCache;
+}
+
+void UFlareWorld::InvalidateIncomingEvents()
+{
+	HasIncomingEventsCache = false;
+}
+
+void UFlareWorld::ComputeIncomingEvents(TArray<FFlareIncomingEvent>& IncomingEvents)
 {
-	TArray<FFlareIncomingEvent> IncomingEvents;
+	SCOPE_CYCLE_COUNTER(STAT_FlareWorld_ComputeIncomingEvents);
+
 	UFlareCompany* PlayerCompany = Game->GetPC()->GetCompany();
 	FText SingleShip = LOCTEXT("ShipSingle", "ship");
 	FText MultipleShips = LOCTEXT("ShipPlural", "ships");
@@ -2263,7 +2886,6 @@ TArray<FFlareIncomingEvent> UFlareWorld::GetIncomingEvents()
 	{
 		return (ip1.RemainingDuration < ip2.RemainingDuration);
 	});
-	return IncomingEvents;
 }
 
 int32 UFlareWorld::GetTotalWorldCombatPoint()
@@ -2284,4 +2906,137 @@ int32 UFlareWorld::GetTotalWorldCombatPoint()
 	return TotalWorldCombatPointCache;
 }
 
+const TArray<FFlareResourceStats>& UFlareWorld::GetResourceStats(bool IncludeStorage)
+{
+	const TArray<FFlareResourceStats>* Stats = ResourceStatsCache.Find(IncludeStorage, WorldData.Date);
+	if (Stats)
+	{
+		return *Stats;
+	}
+
+	int32 ResourceCount = Game->GetResourceCatalog()->Resources.Num();
+	TArray<FFlareResourceStats>& NewStats = ResourceStatsCache.Update(IncludeStorage, WorldData.Date, ResourceCount);
+	WorldHelper::ComputeWorldResourceStats(Game, IncludeStorage, NewStats);
+	return NewStats;
+}
+
+void UFlareWorld::InvalidateWorldResourceStats()
+{
+	ResourceStatsCache.Invalidate();
+}
+
+void UFlareWorld::InvalidateResourceStats()
+{
+	for (UFlareSimulatedSector* Sector : Sectors)
+	{
+		Sector->InvalidateResourceStats();
+	}
+
+	ResourceStatsCache.Invalidate();
+}
+
+void UFlareWorld::UpdateHostilityMatrix()
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareWorld_UpdateHostilityMatrix);
+
+	FFlareHostilityMatrix PreviousMatrix = MoveTemp(HostilityMatrix);
+	HostilityMatrix.Reset(Companies.Num(), Sectors.Num(), GetDate());
+
+	for (int32 Index1 = 0; Index1 < Companies.Num(); Index1++)
+	{
+		for (int32 Index2 = Index1 + 1; Index2 < Companies.Num(); Index2++)
+		{
+			if (Companies[Index1]->GetHostility(Companies[Index2]) == EFlareHostility::Hostile
+			 || Companies[Index2]->GetHostility(Companies[Index1]) == EFlareHostility::Hostile)
+			{
+				HostilityMatrix.SetWar(Index1, Index2);
+			}
+		}
+	}
+
+	if (Game->GetQuestManager())
+	{
+		Game->GetQuestManager()->AddMilitaryContracts(HostilityMatrix);
+	}
+
+	// Hunt targets only need to be found for the hunted companies
+	for (UFlareCompany* Company : Companies)
+	{
+		if (HostilityMatrix.GetHuntContracts(Company->GetWorldIndex()) != EFlareHuntContract::None)
+		{
+			for (UFlareSimulatedSector* Sector : Sectors)
+			{
+				UpdateHuntTargets(Sector, Company);
+			}
+		}
+	}
+
+	HostilityMatrix.KeepStickyContracts(PreviousMatrix);
+}
+
+void UFlareWorld::UpdateHuntTargets(UFlareSimulatedSector* Sector, UFlareCompany* Company)
+{
+	int32 CompanyIndex = Company->GetWorldIndex();
+	int32 SectorIndex = Sector->GetWorldIndex();
+
+	if (!HostilityMatrix.IsValidCompany(CompanyIndex) || !HostilityMatrix.IsValidSector(SectorIndex))
+	{
+		return;
+	}
+
+	uint8 HuntContracts = HostilityMatrix.GetHuntContracts(CompanyIndex);
+	bool HasTarget = false;
+
+	if (HuntContracts != EFlareHuntContract::None)
+	{
+		for (UFlareSimulatedSpacecraft* Ship : Sector->GetSectorShips())
+		{
+			if (Ship->GetCompany() == Company && (HuntContracts & FFlareHostilityMatrix::GetHuntContractType(Ship->IsMilitary(), Ship->GetSize() == EFlarePartSize::L)))
+			{
+				HasTarget = true;
+				break;
+			}
+		}
+	}
+
+	HostilityMatrix.SetHuntTarget(CompanyIndex, SectorIndex, HasTarget);
+}
+
+void UFlareWorld::UpdateTravelDurationTable()
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareWorld_UpdateTravelDurationTable);
+
+	TravelDurationTable.Reset(Sectors.Num());
+
+	for (int32 OriginIndex = 0; OriginIndex < Sectors.Num(); OriginIndex++)
+	{
+		for (int32 DestinationIndex = 0; DestinationIndex < Sectors.Num(); DestinationIndex++)
+		{
+			if (OriginIndex == DestinationIndex)
+			{
+				continue;
+			}
+
+			UFlareSimulatedSector* OriginSector = Sectors[OriginIndex];
+			UFlareSimulatedSector* DestinationSector = Sectors[DestinationIndex];
+			TravelDurationTable.Set(OriginIndex, DestinationIndex, false, UFlareTravel::ComputeTravelDurationNoCache(this, OriginSector, DestinationSector, false));
+			TravelDurationTable.Set(OriginIndex, DestinationIndex, true, UFlareTravel::ComputeTravelDurationNoCache(this, OriginSector, DestinationSector, true));
+		}
+	}
+}
+
+bool UFlareWorld::IsAtWar(const UFlareCompany* Company1, const UFlareCompany* Company2) const
+{
+	int32 Index1 = Company1->GetWorldIndex();
+	int32 Index2 = Company2->GetWorldIndex();
+
+	if (HostilityMatrix.IsValidCompany(Index1) && HostilityMatrix.IsValidCompany(Index2))
+	{
+		return HostilityMatrix.IsAtWar(Index1, Index2);
+	}
+
+	// Companies created since the last update
+	return Company1->GetHostility(Company2) == EFlareHostility::Hostile || Company2->GetHostility(Company1) == EFlareHostility::Hostile;
+}
+
 #undef LOCTEXT_NAMESPACE
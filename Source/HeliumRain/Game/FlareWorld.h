@@ -5,6 +5,9 @@
 #include "FlareGameTypes.h"
 #include "FlareTravel.h"
 #include "Planetarium/FlareSimulatedPlanetarium.h"
+#include "FlareResourceStats.h"
+#include "FlareHostilityMatrix.h"
+#include "FlareTravelDurationTable.h"
 #include "FlareWorld.generated.h"
 
 
@@ -15,6 +18,8 @@
 #define MAX_WEAPON_REPAIR_RATIO_BY_DAY 0.1f
 #define MAX_REFILL_RATIO_BY_DAY 0.3f
 
+#define SIMULATION_STATS_HISTORY_SIZE 64
+
 
 struct FFlareSectorSave;
 struct FFlareSectorDescription;
@@ -22,6 +27,7 @@ struct FFlareSectorDescription;
 class UFlareCompany;
 class UFlareFleet;
 class UFlareFactory;
+class UFlareBattle;
 class UFlareSector;
 class UFlareSimulatedSector;
 
@@ -100,6 +106,58 @@ struct IncomingValue
 };
 
 
+/** Phases of a simulated day, for profiling */
+namespace EFlareSimulationPhase
+{
+	enum Type
+	{
+		PlayerAutoTrade,
+		Battles,
+		AITrading,
+		AIPlanning,
+		AICompanies,
+		Meteorites,
+		Fleets,
+		Factories,
+		People,
+		TradeRoutes,
+		Travels,
+		Prices,
+		PeopleMigration,
+		EndOfDay,
+		Count
+	};
+}
+
+/** Profiling data of a simulation phase */
+struct FFlareSimulationPhaseStats
+{
+	/** Wall time in seconds */
+	double Time;
+
+	/** Number of objects processed by the phase */
+	int32 ObjectCount;
+
+	/** Growth of the used physical memory during the phase, in bytes. This is not an allocation count */
+	int64 MemoryGrowth;
+};
+
+/** Profiling data of a simulated day */
+struct FFlareSimulationDayStats
+{
+	FFlareSimulationDayStats()
+		: Date(0)
+		, TotalTime(0)
+	{
+		FMemory::Memzero(Phases);
+	}
+
+	int64 Date;
+	FFlareSimulationPhaseStats Phases[EFlareSimulationPhase::Count];
+	double TotalTime;
+};
+
+
 
 UCLASS()
 class HELIUMRAIN_API UFlareWorld: public UObject
@@ -147,11 +205,61 @@ public:
 
 	void ProcessIncomingPlayerEnemy();
 
+	/** Build the incoming events of the player */
+	void ComputeIncomingEvents(TArray<FFlareIncomingEvent>& IncomingEvents);
+
 	/** Simulate world for a day */
 	void Simulate();
 
 	void SimulatePeopleMoneyMigration();
 
+	/** Get the profiling data of the last simulated day */
+	const FFlareSimulationDayStats& GetLastSimulationStats() const
+	{
+		return LastSimulationStats;
+	}
+
+	/** Get the profiling data of the last simulated days, oldest first */
+	void GetSimulationStatsHistory(TArray<FFlareSimulationDayStats>& OutStats) const;
+
+	/** Get the display name of a simulation phase */
+	static const TCHAR* GetSimulationPhaseName(EFlareSimulationPhase::Type Phase);
+
+	/** Run a function on each sector, on worker threads if UFlareGameTools::ParallelSimulation is set. Each sector gets its own random stream derived from Seed */
+	void ForEachSector(int32 Seed, TFunctionRef<void(UFlareSimulatedSector*, int32, const FRandomStream&)> Function);
+
+	/** Swap the sector prices and choose the reserve ships */
+	void SwapPricesAndUpdateReserveShips(int32 Seed);
+
+	/** Resolve the automatic battles of the day. Serially, sector after sector with the effects applied as they happen ;
+	 * on worker threads if UFlareGameTools::ParallelSimulation is set, with the effects applied afterwards in sector order */
+	void SimulateBattles(int32 Seed);
+
+	/** Check if a company wants to fight in a sector */
+	bool IsBattleSector(UFlareSimulatedSector* Sector);
+
+	/** Remove the spacecrafts destroyed in a sector */
+	void RemoveDestroyedSpacecrafts(UFlareSimulatedSector* Sector);
+
+	/** Find the sectors with a battle, and load a battle for each with its own random stream derived from Seed, with deferred effects */
+	void CreateBattles(int32 Seed, TArray<UFlareBattle*>& OutBattles);
+
+	/** Fight the battles without applying their effects outside the sectors */
+	void RunBattles(const TArray<UFlareBattle*>& Battles);
+
+	/** Run the per-sector steps of a day serially and in parallel from the same state, and compare the results. The world is left unchanged */
+	bool CheckParallelSectorSimulation();
+
+	/** Fight the battles of the day serially and in parallel from the same state, and compare the results. The spacecrafts are restored after each run */
+	bool CheckParallelBattleSimulation(int32 Seed);
+
+	/** Analyse the world for every AI company on worker threads, and give each company AI its plan for the day.
+	 * Only used with UFlareGameTools::ParallelSimulation : all companies then plan from the same stocks */
+	void PlanCompanyAI();
+
+	/** Plan the company AIs serially and in parallel, Iterations times each, and compare the results. The world is left unchanged */
+	bool CheckParallelCompanyAIPlan(int32 Iterations, double& SerialTime, double& ParallelTime);
+
 	/** Simulate world from now to the next event */
 	void FastForward();
 
@@ -198,10 +306,37 @@ protected:
 	UPROPERTY()
 	UFlareSimulatedPlanetarium*			Planetarium;
 
+	/** Identifier lookups. Destroyed spacecrafts are kept apart, live ones are found first */
+	TMap<FName, UFlareSimulatedSector*>     SectorsByIdentifier;
+	TMap<FName, UFlareFleet*>               FleetsByIdentifier;
+	TMap<FName, UFlareTradeRoute*>          TradeRoutesByIdentifier;
+	TMap<FName, UFlareSimulatedSpacecraft*> SpacecraftsByImmatriculation;
+	TMap<FName, UFlareSimulatedSpacecraft*> DestroyedSpacecraftsByImmatriculation;
+
 	AFlareGame*                             Game;
 
 	bool WorldMoneyReferenceInit;
 
+	FFlareSimulationDayStats              LastSimulationStats;
+
+	/** Ring buffer of the last simulated days */
+	TArray<FFlareSimulationDayStats>      SimulationStatsHistory;
+	int32                                 SimulationStatsHistoryIndex;
+
+	/** Resource stats summed over all sectors */
+	FFlareResourceStatsCache              ResourceStatsCache;
+
+	/** War states and military contracts by company and sector world index */
+	FFlareHostilityMatrix                 HostilityMatrix;
+
+	/** Travel durations between sectors by sector world index */
+	FFlareTravelDurationTable             TravelDurationTable;
+
+	/** Incoming events of the player, and their text */
+	TArray<FFlareIncomingEvent>           IncomingEventsCache;
+	FText                                 IncomingEventsTextCache;
+	bool                                  HasIncomingEventsCache;
+
 public:
 	int64 WorldMoneyReference;
 
@@ -259,6 +394,22 @@ public:
 
 	UFlareSimulatedSpacecraft* FindSpacecraft(FName ShipImmatriculation);
 
+	/** Find a spacecraft in the live or destroyed spacecraft lookup only */
+	UFlareSimulatedSpacecraft* FindRegisteredSpacecraft(FName ShipImmatriculation, bool Destroyed) const;
+
+	/** Identifier lookups, kept in sync by companies when they add or remove spacecrafts, fleets and trade routes */
+	void RegisterSpacecraft(UFlareSimulatedSpacecraft* Spacecraft);
+
+	void UnregisterSpacecraft(UFlareSimulatedSpacecraft* Spacecraft);
+
+	void RegisterFleet(UFlareFleet* Fleet);
+
+	void UnregisterFleet(UFlareFleet* Fleet);
+
+	void RegisterTradeRoute(UFlareTradeRoute* TradeRoute);
+
+	void UnregisterTradeRoute(UFlareTradeRoute* TradeRoute);
+
 	inline const TArray<UFlareCompany*>& GetCompanies() const
 	{
 		return Companies;
@@ -268,10 +419,48 @@ public:
 
 	uint32 GetWorldPopulation();
 
-	TArray<FFlareIncomingEvent> GetIncomingEvents();
+	/** Get the events the player should know about, sorted by remaining duration, rebuilt when invalidated */
+	const TArray<FFlareIncomingEvent>& GetIncomingEvents();
+
+	/** Get the incoming events as one line per event, empty if there is none */
+	const FText& GetIncomingEventsText();
+
+	/** Forget the incoming events, a travel or the day changed */
+	void InvalidateIncomingEvents();
 
 	int32 GetTotalWorldCombatPoint();
 
 	TMap<IncomingKey, IncomingValue> GetIncomingPlayerEnemy();
 
+	/** Get the resource stats of the world by resource index, summed from the cached sector stats */
+	const TArray<FFlareResourceStats>& GetResourceStats(bool IncludeStorage);
+
+	/** Forget the world resource stats, a sector changed */
+	void InvalidateWorldResourceStats();
+
+	/** Forget the resource stats of the world and all sectors */
+	void InvalidateResourceStats();
+
+	/** Rebuild the hostility matrix, a war state, a military contract or the date changed */
+	void UpdateHostilityMatrix();
+
+	/** Update the hunt contracts of a company in a sector, its ships in the sector changed */
+	void UpdateHuntTargets(UFlareSimulatedSector* Sector, UFlareCompany* Company);
+
+	inline const FFlareHostilityMatrix& GetHostilityMatrix() const
+	{
+		return HostilityMatrix;
+	}
+
+	/** Build the travel duration table, the sectors changed */
+	void UpdateTravelDurationTable();
+
+	inline const FFlareTravelDurationTable& GetTravelDurationTable() const
+	{
+		return TravelDurationTable;
+	}
+
+	/** Check if two different companies are at war */
+	bool IsAtWar(const UFlareCompany* Company1, const UFlareCompany* Company2) const;
+
 };
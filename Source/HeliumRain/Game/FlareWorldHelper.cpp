@@ -15,68 +15,36 @@
 DECLARE_CYCLE_STAT(TEXT("WorldHelper ComputeWorldResourceStats"), STAT_WorldHelper_ComputeWorldResourceStats, STATGROUP_Flare);
 
 
-TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> WorldHelper::ComputeWorldResourceStats(AFlareGame* Game, bool IncludeStorage)
+void WorldHelper::ComputeWorldResourceStats(AFlareGame* Game, bool IncludeStorage, TArray<FlareResourceStats>& OutStats)
 {
 	SCOPE_CYCLE_COUNTER(STAT_WorldHelper_ComputeWorldResourceStats);
 
-
-	TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> WorldStats;
+	int32 ResourceCount = Game->GetResourceCatalog()->Resources.Num();
 
 	// Init
-	for(int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
-	{
-		FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-		WorldHelper::FlareResourceStats ResourceStats;
-		ResourceStats.Production = 0;
-		ResourceStats.Consumption = 0;
-		ResourceStats.Balance = 0;
-		ResourceStats.Stock = 0;
-		ResourceStats.Capacity = 0;
-
-		WorldStats.Add(Resource, ResourceStats);
-	}
+	OutStats.Reset(ResourceCount);
+	OutStats.SetNum(ResourceCount);
 
 	for (int SectorIndex = 0; SectorIndex < Game->GetGameWorld()->GetSectors().Num(); SectorIndex++)
 	{
 		UFlareSimulatedSector* Sector = Game->GetGameWorld()->GetSectors()[SectorIndex];
+		const TArray<FlareResourceStats>& SectorStats = Sector->GetResourceStats(IncludeStorage);
 
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorStats;
-
-		SectorStats = SectorHelper::ComputeSectorResourceStats(Sector, IncludeStorage);
-
-
-		for(int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
+		for(int32 ResourceIndex = 0; ResourceIndex < ResourceCount; ResourceIndex++)
 		{
-			FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-
-			WorldHelper::FlareResourceStats& SectorResourceStats = SectorStats[Resource];
-			WorldHelper::FlareResourceStats& ResourceStats = WorldStats[Resource];
+			const FlareResourceStats& SectorResourceStats = SectorStats[ResourceIndex];
+			FlareResourceStats& ResourceStats = OutStats[ResourceIndex];
 			ResourceStats.Production += SectorResourceStats.Production;
 			ResourceStats.Consumption += SectorResourceStats.Consumption;
-			ResourceStats.Balance += SectorResourceStats.Balance;
 			ResourceStats.Stock += SectorResourceStats.Stock;
 			ResourceStats.Capacity += SectorResourceStats.Capacity;
-
-			WorldStats.Add(Resource, ResourceStats);
 		}
 	}
 
-
 	// Balance
-	for(int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
+	for(int32 ResourceIndex = 0; ResourceIndex < ResourceCount; ResourceIndex++)
 	{
-		FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-		WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Resource];
-
-		ResourceStats->Balance = ResourceStats->Production - ResourceStats->Consumption;
-
-		/*FLOGV("World stats for %s: Production=%f Consumption=%f Balance=%f Stock=%d",
-			  *Resource->Name.ToString(),
-			  ResourceStats->Production,
-			  ResourceStats->Consumption,
-			  ResourceStats->Balance,
-			  ResourceStats->Stock);*/
+		FlareResourceStats& ResourceStats = OutStats[ResourceIndex];
+		ResourceStats.Balance = ResourceStats.Production - ResourceStats.Consumption;
 	}
-
-	return WorldStats;
 }
@@ -1,19 +1,14 @@
 #pragma once
 #include "../Economy/FlareResource.h"
 #include "FlareWorld.h"
+#include "FlareResourceStats.h"
 
 struct WorldHelper
 {
-	struct FlareResourceStats
-	{
-		float Production;
-		float Consumption;
-		float Balance;
-		int32 Stock;
-		int32 Capacity;
-	};
+	typedef FFlareResourceStats FlareResourceStats;
 
-	static TMap<FFlareResourceDescription*, FlareResourceStats> ComputeWorldResourceStats(AFlareGame* Game, bool IncludeStorage);
+	/** Sum the resource stats of all sectors, by resource index. Use UFlareWorld::GetResourceStats for the cached result */
+	static void ComputeWorldResourceStats(AFlareGame* Game, bool IncludeStorage, TArray<FlareResourceStats>& OutStats);
 
 
 private:
@@ -2,6 +2,7 @@
 #include "FlareSimulatedPlanetarium.h"
 #include "../../Flare.h"
 #include "../FlareGame.h"
+#include "../FlareSimulatedSector.h"
 
 const FPreciseVector FPreciseVector::ZeroVector = FPreciseVector();
 
@@ -88,12 +89,42 @@ void UFlareSimulatedPlanetarium::Load()
 		Nema.Sattelites.Add(Adena);
 	}
 	Sun.Sattelites.Add(Nema);
+
+	// The tree is final, index it
+	Bodies.Empty();
+	BodyParents.Empty();
+	BodyDepths.Empty();
+	BodySphereOfInfluenceAltitudes.Empty();
+	BodyIndexByIdentifier.Empty();
+	AddToBodyTable(&Sun, INDEX_NONE, 0);
+}
+
+void UFlareSimulatedPlanetarium::AddToBodyTable(FFlareCelestialBody* Body, int32 ParentIndex, int32 Depth)
+{
+	Body->Index = Bodies.Add(Body);
+	BodyParents.Add(ParentIndex);
+	BodyDepths.Add(Depth);
+	BodyIndexByIdentifier.Add(Body->Identifier, Body->Index);
+
+	// Same formula as the travels used, the star has none
+	double SphereOfInfluenceAltitude = 0;
+	if (ParentIndex != INDEX_NONE)
+	{
+		FFlareCelestialBody* ParentBody = Bodies[ParentIndex];
+		SphereOfInfluenceAltitude = Body->OrbitDistance * pow(Body->Mass / ParentBody->Mass, 0.4) - Body->Radius;
+	}
+	BodySphereOfInfluenceAltitudes.Add(SphereOfInfluenceAltitude);
+
+	for (int SatteliteIndex = 0; SatteliteIndex < Body->Sattelites.Num(); SatteliteIndex++)
+	{
+		AddToBodyTable(&Body->Sattelites[SatteliteIndex], Body->Index, Depth + 1);
+	}
 }
 
 
 FFlareCelestialBody* UFlareSimulatedPlanetarium::FindCelestialBody(FName BodyIdentifier)
 {
-	return FindCelestialBody(&Sun, BodyIdentifier);
+	return GetCelestialBody(FindCelestialBodyIndex(BodyIdentifier));
 }
 
 FFlareCelestialBody* UFlareSimulatedPlanetarium::FindCelestialBody(FFlareCelestialBody* Body, FName BodyIdentifier)
@@ -116,6 +147,22 @@ FFlareCelestialBody* UFlareSimulatedPlanetarium::FindCelestialBody(FFlareCelesti
 	return NULL;
 }
 
+int32 UFlareSimulatedPlanetarium::FindCelestialBodyIndex(FName BodyIdentifier) const
+{
+	const int32* BodyIndex = BodyIndexByIdentifier.Find(BodyIdentifier);
+	return BodyIndex ? *BodyIndex : INDEX_NONE;
+}
+
+FFlareCelestialBody* UFlareSimulatedPlanetarium::FindOrbitCelestialBody(const FFlareSectorOrbitParameters* OrbitParameters)
+{
+	if (OrbitParameters->CelestialBodyIndex != INDEX_NONE)
+	{
+		return GetCelestialBody(OrbitParameters->CelestialBodyIndex);
+	}
+
+	return FindCelestialBody(OrbitParameters->CelestialBodyIdentifier);
+}
+
 FFlareCelestialBody* UFlareSimulatedPlanetarium::FindParent(FFlareCelestialBody* Body)
 {
 	if (&Sun == Body)
@@ -123,6 +170,11 @@ FFlareCelestialBody* UFlareSimulatedPlanetarium::FindParent(FFlareCelestialBody*
 		return NULL;
 	}
 
+	if (IsInBodyTable(Body))
+	{
+		return GetCelestialBody(BodyParents[Body->Index]);
+	}
+
 	return FindParent(Body, &Sun);
 }
 
@@ -149,6 +201,11 @@ FFlareCelestialBody* UFlareSimulatedPlanetarium::FindParent(FFlareCelestialBody*
 
 bool UFlareSimulatedPlanetarium::IsSatellite(FFlareCelestialBody* Body, FFlareCelestialBody* Parent)
 {
+	if (IsInBodyTable(Body) && IsInBodyTable(Parent))
+	{
+		return BodyParents[Body->Index] == Parent->Index;
+	}
+
 	for (int SatteliteIndex = 0; SatteliteIndex < Parent->Sattelites.Num(); SatteliteIndex++)
 	{
 		if (&Parent->Sattelites[SatteliteIndex] == Body)
@@ -159,6 +216,17 @@ bool UFlareSimulatedPlanetarium::IsSatellite(FFlareCelestialBody* Body, FFlareCe
 	return false;
 }
 
+double UFlareSimulatedPlanetarium::GetSphereOfInfluenceAltitude(FFlareCelestialBody* Body)
+{
+	if (IsInBodyTable(Body))
+	{
+		return BodySphereOfInfluenceAltitudes[Body->Index];
+	}
+
+	FFlareCelestialBody* ParentBody = FindParent(Body);
+	return Body->OrbitDistance * pow(Body->Mass / ParentBody->Mass, 0.4) - Body->Radius;
+}
+
 float UFlareSimulatedPlanetarium::GetLightRatio(FFlareCelestialBody* Body, double OrbitDistance)
 {
 	return 0.5 + FMath::Acos(Body->Radius / (Body->Radius + OrbitDistance)) / PI;
@@ -204,6 +204,9 @@ struct FFlareCelestialBody
 	/** Sattelites list */
 	TArray<FFlareCelestialBody> Sattelites;
 
+	/** Index in the planetarium body table, stable for a game */
+	int32 Index = INDEX_NONE;
+
 	/*----------------------------------------------------
 		Dynamic parameters
 	----------------------------------------------------*/
@@ -247,6 +250,12 @@ public:
 	/** Return the celestial body with the given identifier in the given body tree */
 	FFlareCelestialBody* FindCelestialBody(FFlareCelestialBody* Body, FName BodyIdentifier);
 
+	/** Return the index of the celestial body with the given identifier, or INDEX_NONE */
+	int32 FindCelestialBodyIndex(FName BodyIdentifier) const;
+
+	/** Return the celestial body an orbit is around, by index when the orbit has one */
+	FFlareCelestialBody* FindOrbitCelestialBody(const struct FFlareSectorOrbitParameters* OrbitParameters);
+
 	/** Return the parent of the given celestial body */
 	FFlareCelestialBody* FindParent(FFlareCelestialBody* Body);
 
@@ -256,12 +265,24 @@ public:
 	/** Return true if the target body is sattelite of the parent body */
 	bool IsSatellite(FFlareCelestialBody* Body, FFlareCelestialBody* Parent);
 
+	/** Return the altitude of the sphere of influence of a body around its parent */
+	double GetSphereOfInfluenceAltitude(FFlareCelestialBody* Body);
+
 	float GetLightRatio(FFlareCelestialBody* Body, double OrbitDistance);
 
 protected:
 
 	void ComputeCelestialBodyLocation(FFlareCelestialBody* ParentBody, FFlareCelestialBody* Body, int64 time, float SmoothTime);
 
+	/** Fill the body table from the body tree */
+	void AddToBodyTable(FFlareCelestialBody* Body, int32 ParentIndex, int32 Depth);
+
+	/** Check that a body is the one of the world tree, not a snapshot copy */
+	inline bool IsInBodyTable(const FFlareCelestialBody* Body) const
+	{
+		return Bodies.IsValidIndex(Body->Index) && Bodies[Body->Index] == Body;
+	}
+
 	/*----------------------------------------------------
 		Protected data
 	----------------------------------------------------*/
@@ -270,6 +291,13 @@ protected:
 
 	FFlareCelestialBody           Sun;
 
+	// Body table, one item per body of the tree, built at load time
+	TArray<FFlareCelestialBody*>  Bodies;
+	TArray<int32>                 BodyParents;
+	TArray<int32>                 BodyDepths;
+	TArray<double>                BodySphereOfInfluenceAltitudes;
+	TMap<FName, int32>            BodyIndexByIdentifier;
+
 public:
 
 	/*----------------------------------------------------
@@ -278,6 +306,17 @@ public:
 
 	AFlareGame* GetGame() const;
 
+	/** Get a celestial body by index */
+	inline FFlareCelestialBody* GetCelestialBody(int32 BodyIndex) const
+	{
+		return Bodies.IsValidIndex(BodyIndex) ? Bodies[BodyIndex] : NULL;
+	}
+
+	/** Get the depth of a celestial body in the tree, the star is 0 */
+	inline int32 GetCelestialBodyDepth(int32 BodyIndex) const
+	{
+		return BodyDepths[BodyIndex];
+	}
 
 
 };
@@ -0,0 +1,588 @@
+
+#include "FlareSaveBinary.h"
+#include "../../Flare.h"
+#include "../FlareSaveGame.h"
+
+
+/*----------------------------------------------------
+	Constructor
+----------------------------------------------------*/
+
+UFlareSaveBinary::UFlareSaveBinary(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+bool UFlareSaveBinary::SaveGame(FArchive& Ar, UFlareSaveGame* Data)
+{
+	check(Ar.IsSaving());
+
+	SerializeHeader(Ar, FLARE_SAVE_BINARY_MAGIC, FLARE_SAVE_BINARY_VERSION);
+	SerializeGame(Ar, Data);
+
+	return !Ar.IsError();
+}
+
+UFlareSaveGame* UFlareSaveBinary::LoadGame(FArchive& Ar)
+{
+	check(Ar.IsLoading());
+
+	if (!SerializeHeader(Ar, FLARE_SAVE_BINARY_MAGIC, FLARE_SAVE_BINARY_VERSION))
+	{
+		return NULL;
+	}
+
+	UFlareSaveGame* SaveGame = NewObject<UFlareSaveGame>(this, UFlareSaveGame::StaticClass());
+	SerializeGame(Ar, SaveGame);
+
+	if (Ar.IsError())
+	{
+		FLOG("WARNING: Fail to read binary save. Save corrupted");
+		return NULL;
+	}
+
+	return SaveGame;
+}
+
+bool UFlareSaveBinary::SaveHeader(FArchive& Ar, FFlareSaveSlotHeader& Data)
+{
+	check(Ar.IsSaving());
+
+	SerializeHeader(Ar, FLARE_SAVE_HEADER_MAGIC, FLARE_SAVE_HEADER_VERSION);
+	SerializeSlotHeader(Ar, Data);
+
+	return !Ar.IsError();
+}
+
+bool UFlareSaveBinary::LoadHeader(FArchive& Ar, FFlareSaveSlotHeader& Data)
+{
+	check(Ar.IsLoading());
+
+	if (!SerializeHeader(Ar, FLARE_SAVE_HEADER_MAGIC, FLARE_SAVE_HEADER_VERSION))
+	{
+		return false;
+	}
+
+	SerializeSlotHeader(Ar, Data);
+
+	return !Ar.IsError();
+}
+
+
+/*----------------------------------------------------
+	Serializers
+----------------------------------------------------*/
+
+bool UFlareSaveBinary::SerializeHeader(FArchive& Ar, uint32 ExpectedMagic, int32 ExpectedVersion)
+{
+	uint32 Magic = ExpectedMagic;
+	int32 Version = ExpectedVersion;
+
+	Ar << Magic;
+	Ar << Version;
+
+	if (Ar.IsError() || Magic != ExpectedMagic)
+	{
+		FLOG("WARNING: Not a binary save");
+		return false;
+	}
+
+	if (Version != ExpectedVersion)
+	{
+		FLOGV("WARNING: Invalid binary save version %d (%d excepted)", Version, ExpectedVersion);
+		return false;
+	}
+
+	return true;
+}
+
+void UFlareSaveBinary::SerializeGame(FArchive& Ar, UFlareSaveGame* Data)
+{
+	Ar << Data->AutoSave;
+
+	SerializePlayer(Ar, Data->PlayerData);
+	SerializeCompanyDescription(Ar, Data->PlayerCompanyDescription);
+	Ar << Data->CurrentImmatriculationIndex;
+	Ar << Data->CurrentIdentifierIndex;
+	SerializeWorld(Ar, Data->WorldData);
+}
+
+void UFlareSaveBinary::SerializeSlotHeader(FArchive& Ar, FFlareSaveSlotHeader& Data)
+{
+	Ar << Data.UUID;
+	Ar << Data.HasPlayerCompany;
+	SerializeText(Ar, Data.CompanyName);
+	Ar << Data.CompanyShipCount;
+	Ar << Data.CompanyValue;
+	Ar << Data.PlayerEmblemIndex;
+	Ar << Data.CustomizationBasePaintColor;
+	Ar << Data.CustomizationPaintColor;
+	Ar << Data.CustomizationOverlayColor;
+	Ar << Data.CustomizationLightColor;
+}
+
+void UFlareSaveBinary::SerializePlayer(FArchive& Ar, FFlarePlayerSave& Data)
+{
+	Ar << Data.UUID;
+	Ar << Data.ScenarioId;
+	Ar << Data.PlayerEmblemIndex;
+	Ar << Data.CompanyIdentifier;
+	Ar << Data.PlayerFleetIdentifier;
+	Ar << Data.LastFlownShipIdentifier;
+	SerializeQuest(Ar, Data.QuestData);
+	Ar << Data.UnlockedScannables;
+}
+
+void UFlareSaveBinary::SerializeQuest(FArchive& Ar, FFlareQuestSave& Data)
+{
+	Ar << Data.SelectedQuest;
+	Ar << Data.PlayTutorial;
+	Ar << Data.NextGeneratedQuestIndex;
+	SerializeArray(Ar, Data.QuestProgresses, &UFlareSaveBinary::SerializeQuestProgress);
+	Ar << Data.SuccessfulQuests;
+	Ar << Data.AbandonedQuests;
+	Ar << Data.FailedQuests;
+	SerializeArray(Ar, Data.GeneratedQuests, &UFlareSaveBinary::SerializeGeneratedQuest);
+}
+
+void UFlareSaveBinary::SerializeQuestProgress(FArchive& Ar, FFlareQuestProgressSave& Data)
+{
+	Ar << Data.QuestIdentifier;
+	SerializeEnum(Ar, Data.Status);
+	Ar << Data.AvailableDate;
+	Ar << Data.AcceptationDate;
+	SerializeBundle(Ar, Data.Data);
+	Ar << Data.SuccessfullSteps;
+	SerializeArray(Ar, Data.CurrentStepProgress, &UFlareSaveBinary::SerializeQuestStepProgress);
+	SerializeArray(Ar, Data.TriggerConditionsSave, &UFlareSaveBinary::SerializeQuestStepProgress);
+	SerializeArray(Ar, Data.ExpirationConditionsSave, &UFlareSaveBinary::SerializeQuestStepProgress);
+}
+
+void UFlareSaveBinary::SerializeGeneratedQuest(FArchive& Ar, FFlareGeneratedQuestSave& Data)
+{
+	Ar << Data.QuestClass;
+	SerializeBundle(Ar, Data.Data);
+}
+
+void UFlareSaveBinary::SerializeQuestStepProgress(FArchive& Ar, FFlareQuestConditionSave& Data)
+{
+	Ar << Data.ConditionIdentifier;
+	SerializeBundle(Ar, Data.Data);
+}
+
+void UFlareSaveBinary::SerializeCompanyDescription(FArchive& Ar, FFlareCompanyDescription& Data)
+{
+	SerializeText(Ar, Data.Name);
+	Ar << Data.ShortName;
+	SerializeText(Ar, Data.Description);
+	Ar << Data.CustomizationBasePaintColor;
+	Ar << Data.CustomizationPaintColor;
+	Ar << Data.CustomizationOverlayColor;
+	Ar << Data.CustomizationLightColor;
+	Ar << Data.CustomizationPatternIndex;
+}
+
+void UFlareSaveBinary::SerializeWorld(FArchive& Ar, FFlareWorldSave& Data)
+{
+	Ar << Data.Date;
+	SerializeArray(Ar, Data.CompanyData, &UFlareSaveBinary::SerializeCompany);
+	SerializeArray(Ar, Data.SectorData, &UFlareSaveBinary::SerializeSector);
+	SerializeArray(Ar, Data.TravelData, &UFlareSaveBinary::SerializeTravel);
+}
+
+void UFlareSaveBinary::SerializeCompany(FArchive& Ar, FFlareCompanySave& Data)
+{
+	Ar << Data.Identifier;
+	Ar << Data.CatalogIdentifier;
+	Ar << Data.Money;
+	Ar << Data.CompanyValue;
+	Ar << Data.PlayerLastPeaceDate;
+	Ar << Data.PlayerLastWarDate;
+	Ar << Data.PlayerLastTributeDate;
+	Ar << Data.FleetImmatriculationIndex;
+	Ar << Data.TradeRouteImmatriculationIndex;
+	Ar << Data.ResearchAmount;
+	Ar << Data.ResearchSpent;
+	SerializeCompanyAI(Ar, Data.AI);
+	Ar << Data.ResearchRatio;
+	Ar << Data.Retaliation;
+	Ar << Data.UnlockedTechnologies;
+	Ar << Data.CaptureOrders;
+	Ar << Data.HostileCompanies;
+	SerializeArray(Ar, Data.ShipData, &UFlareSaveBinary::SerializeSpacecraft);
+	SerializeArray(Ar, Data.ChildStationData, &UFlareSaveBinary::SerializeSpacecraft);
+	SerializeArray(Ar, Data.StationData, &UFlareSaveBinary::SerializeSpacecraft);
+	SerializeArray(Ar, Data.DestroyedSpacecraftData, &UFlareSaveBinary::SerializeSpacecraft);
+	SerializeArray(Ar, Data.Fleets, &UFlareSaveBinary::SerializeFleet);
+	SerializeArray(Ar, Data.TradeRoutes, &UFlareSaveBinary::SerializeTradeRoute);
+	SerializeArray(Ar, Data.SectorsKnowledge, &UFlareSaveBinary::SerializeSectorKnowledge);
+	Ar << Data.PlayerReputation;
+	SerializeArray(Ar, Data.TransactionLog, &UFlareSaveBinary::SerializeTransactionLogEntry);
+}
+
+void UFlareSaveBinary::SerializeSpacecraft(FArchive& Ar, FFlareSpacecraftSave& Data)
+{
+	Ar << Data.IsDestroyed;
+	Ar << Data.IsUnderConstruction;
+	Ar << Data.Immatriculation;
+	SerializeText(Ar, Data.NickName);
+	Ar << Data.Identifier;
+	Ar << Data.CompanyIdentifier;
+	Ar << Data.Location;
+	Ar << Data.Rotation;
+	SerializeEnum(Ar, Data.SpawnMode);
+	Ar << Data.LinearVelocity;
+	Ar << Data.AngularVelocity;
+	Ar << Data.DockedTo;
+	Ar << Data.DockedAt;
+	Ar << Data.DockedAngle;
+	Ar << Data.Heat;
+	Ar << Data.PowerOutageDelay;
+	Ar << Data.PowerOutageAcculumator;
+	Ar << Data.DynamicComponentStateIdentifier;
+	Ar << Data.DynamicComponentStateProgress;
+	Ar << Data.Level;
+	Ar << Data.IsTrading;
+	Ar << Data.IsIntercepted;
+	Ar << Data.RefillStock;
+	Ar << Data.RepairStock;
+	Ar << Data.IsReserve;
+	Ar << Data.AllowExternalOrder;
+	SerializePilot(Ar, Data.Pilot);
+	SerializeAsteroid(Ar, Data.AsteroidData);
+	Ar << Data.HarpoonCompany;
+	Ar << Data.AttachActorName;
+	Ar << Data.AttachComplexStationName;
+	Ar << Data.AttachComplexConnectorName;
+	SerializeArray(Ar, Data.Components, &UFlareSaveBinary::SerializeSpacecraftComponent);
+	SerializeArray(Ar, Data.ConstructionCargoBay, &UFlareSaveBinary::SerializeCargo);
+	SerializeArray(Ar, Data.ProductionCargoBay, &UFlareSaveBinary::SerializeCargo);
+	SerializeArray(Ar, Data.FactoryStates, &UFlareSaveBinary::SerializeFactory);
+	SerializeArray(Ar, Data.ShipyardOrderQueue, &UFlareSaveBinary::SerializeShipyardOrder);
+	Ar << Data.SalesExcludedResources;
+	SerializeArray(Ar, Data.ConnectedStations, &UFlareSaveBinary::SerializeStationConnection);
+	Ar << Data.CapturePoints;
+}
+
+void UFlareSaveBinary::SerializePilot(FArchive& Ar, FFlareShipPilotSave& Data)
+{
+	Ar << Data.Identifier;
+	Ar << Data.Name;
+}
+
+void UFlareSaveBinary::SerializeAsteroid(FArchive& Ar, FFlareAsteroidSave& Data)
+{
+	Ar << Data.Identifier;
+	Ar << Data.Location;
+	Ar << Data.Rotation;
+	Ar << Data.LinearVelocity;
+	Ar << Data.AngularVelocity;
+	Ar << Data.Scale;
+	Ar << Data.AsteroidMeshID;
+}
+
+void UFlareSaveBinary::SerializeMeteorite(FArchive& Ar, FFlareMeteoriteSave& Data)
+{
+	Ar << Data.Location;
+	Ar << Data.TargetOffset;
+	Ar << Data.Rotation;
+	Ar << Data.LinearVelocity;
+	Ar << Data.AngularVelocity;
+	Ar << Data.MeteoriteMeshID;
+	Ar << Data.IsMetal;
+	Ar << Data.Damage;
+	Ar << Data.BrokenDamage;
+	Ar << Data.TargetStation;
+	Ar << Data.HasMissed;
+	Ar << Data.DaysBeforeImpact;
+}
+
+void UFlareSaveBinary::SerializeSpacecraftComponent(FArchive& Ar, FFlareSpacecraftComponentSave& Data)
+{
+	Ar << Data.ComponentIdentifier;
+	Ar << Data.ShipSlotIdentifier;
+	Ar << Data.Damage;
+	Ar << Data.Turret.TurretAngle;
+	Ar << Data.Turret.BarrelsAngle;
+	Ar << Data.Weapon.FiredAmmo;
+	SerializeTurretPilot(Ar, Data.Pilot);
+}
+
+void UFlareSaveBinary::SerializeTurretPilot(FArchive& Ar, FFlareTurretPilotSave& Data)
+{
+	Ar << Data.Identifier;
+	Ar << Data.Name;
+}
+
+void UFlareSaveBinary::SerializeStationConnection(FArchive& Ar, FFlareConnectionSave& Data)
+{
+	Ar << Data.ConnectorName;
+	Ar << Data.StationIdentifier;
+}
+
+void UFlareSaveBinary::SerializeTradeOperation(FArchive& Ar, FFlareTradeRouteSectorOperationSave& Data)
+{
+	Ar << Data.ResourceIdentifier;
+	Ar << Data.MaxQuantity;
+	Ar << Data.InventoryLimit;
+	Ar << Data.MaxWait;
+	SerializeEnum(Ar, Data.Type);
+	Ar << Data.CanTradeWithStorages;
+}
+
+void UFlareSaveBinary::SerializeCargo(FArchive& Ar, FFlareCargoSave& Data)
+{
+	Ar << Data.ResourceIdentifier;
+	Ar << Data.Quantity;
+	SerializeEnum(Ar, Data.Lock);
+	SerializeEnum(Ar, Data.Restriction);
+}
+
+void UFlareSaveBinary::SerializeFactory(FArchive& Ar, FFlareFactorySave& Data)
+{
+	Ar << Data.Active;
+	Ar << Data.CostReserved;
+	Ar << Data.ProductedDuration;
+	Ar << Data.InfiniteCycle;
+	Ar << Data.CycleCount;
+	Ar << Data.TargetShipClass;
+	Ar << Data.TargetShipCompany;
+	SerializeArray(Ar, Data.ResourceReserved, &UFlareSaveBinary::SerializeCargo);
+	SerializeArray(Ar, Data.OutputCargoLimit, &UFlareSaveBinary::SerializeCargo);
+}
+
+void UFlareSaveBinary::SerializeShipyardOrder(FArchive& Ar, FFlareShipyardOrderSave& Data)
+{
+	Ar << Data.Company;
+	Ar << Data.ShipClass;
+	Ar << Data.AdvancePayment;
+}
+
+void UFlareSaveBinary::SerializeFleet(FArchive& Ar, FFlareFleetSave& Data)
+{
+	SerializeText(Ar, Data.Name);
+	Ar << Data.Identifier;
+	Ar << Data.ShipImmatriculations;
+	Ar << Data.FleetColor;
+	Ar << Data.AutoTrade;
+	Ar << Data.AutoTradeStatsDays;
+	Ar << Data.AutoTradeStatsLoadResources;
+	Ar << Data.AutoTradeStatsUnloadResources;
+	Ar << Data.AutoTradeStatsMoneySell;
+	Ar << Data.AutoTradeStatsMoneyBuy;
+}
+
+void UFlareSaveBinary::SerializeTradeRoute(FArchive& Ar, FFlareTradeRouteSave& Data)
+{
+	SerializeText(Ar, Data.Name);
+	Ar << Data.Identifier;
+	Ar << Data.FleetIdentifier;
+	Ar << Data.TargetSectorIdentifier;
+	Ar << Data.CurrentOperationIndex;
+	Ar << Data.CurrentOperationProgress;
+	Ar << Data.CurrentOperationDuration;
+	Ar << Data.IsPaused;
+
+	// Stats
+	Ar << Data.StatsDays;
+	Ar << Data.StatsLoadResources;
+	Ar << Data.StatsUnloadResources;
+	Ar << Data.StatsMoneySell;
+	Ar << Data.StatsMoneyBuy;
+	Ar << Data.StatsOperationSuccessCount;
+	Ar << Data.StatsOperationFailCount;
+
+	SerializeArray(Ar, Data.Sectors, &UFlareSaveBinary::SerializeTradeRouteSector);
+}
+
+void UFlareSaveBinary::SerializeTradeRouteSector(FArchive& Ar, FFlareTradeRouteSectorSave& Data)
+{
+	Ar << Data.SectorIdentifier;
+	SerializeArray(Ar, Data.Operations, &UFlareSaveBinary::SerializeTradeOperation);
+}
+
+void UFlareSaveBinary::SerializeSectorKnowledge(FArchive& Ar, FFlareCompanySectorKnowledge& Data)
+{
+	Ar << Data.SectorIdentifier;
+	SerializeEnum(Ar, Data.Knowledge);
+}
+
+void UFlareSaveBinary::SerializeTransactionLogEntry(FArchive& Ar, FFlareTransactionLogEntry& Data)
+{
+	Ar << Data.Date;
+	Ar << Data.Amount;
+	SerializeEnum(Ar, Data.Type);
+	Ar << Data.Spacecraft;
+	Ar << Data.Sector;
+	Ar << Data.OtherCompany;
+	Ar << Data.OtherSpacecraft;
+	Ar << Data.Resource;
+	Ar << Data.ResourceQuantity;
+	Ar << Data.ExtraIdentifier1;
+	Ar << Data.ExtraIdentifier2;
+}
+
+void UFlareSaveBinary::SerializeCompanyAI(FArchive& Ar, FFlareCompanyAISave& Data)
+{
+	Ar << Data.BudgetMilitary;
+	Ar << Data.BudgetStation;
+	Ar << Data.BudgetTechnology;
+	Ar << Data.BudgetTrade;
+	Ar << Data.Caution;
+	Ar << Data.Pacifism;
+	Ar << Data.ResearchProject;
+}
+
+void UFlareSaveBinary::SerializeCompanyReputation(FArchive& Ar, FFlareCompanyReputationSave& Data)
+{
+	Ar << Data.CompanyIdentifier;
+	Ar << Data.Reputation;
+}
+
+void UFlareSaveBinary::SerializeSector(FArchive& Ar, FFlareSectorSave& Data)
+{
+	SerializeText(Ar, Data.GivenName);
+	Ar << Data.Identifier;
+	Ar << Data.LocalTime;
+	SerializePeople(Ar, Data.PeopleData);
+	SerializeArray(Ar, Data.BombData, &UFlareSaveBinary::SerializeBomb);
+	SerializeArray(Ar, Data.AsteroidData, &UFlareSaveBinary::SerializeAsteroid);
+	SerializeArray(Ar, Data.MeteoriteData, &UFlareSaveBinary::SerializeMeteorite);
+	Ar << Data.FleetIdentifiers;
+	Ar << Data.SpacecraftIdentifiers;
+	SerializeArray(Ar, Data.ResourcePrices, &UFlareSaveBinary::SerializeResourcePrice);
+	Ar << Data.IsTravelSector;
+	SerializeFloatBuffer(Ar, Data.FleetSupplyConsumptionStats);
+	Ar << Data.DailyFleetSupplyConsumption;
+}
+
+void UFlareSaveBinary::SerializePeople(FArchive& Ar, FFlarePeopleSave& Data)
+{
+	Ar << Data.Population;
+	Ar << Data.FoodStock;
+	Ar << Data.FuelStock;
+	Ar << Data.ToolStock;
+	Ar << Data.TechStock;
+	Ar << Data.FoodConsumption;
+	Ar << Data.FuelConsumption;
+	Ar << Data.ToolConsumption;
+	Ar << Data.TechConsumption;
+	Ar << Data.Money;
+	Ar << Data.Dept;
+	Ar << Data.BirthPoint;
+	Ar << Data.DeathPoint;
+	Ar << Data.HungerPoint;
+	Ar << Data.HappinessPoint;
+	SerializeArray(Ar, Data.CompanyReputations, &UFlareSaveBinary::SerializeCompanyReputation);
+}
+
+void UFlareSaveBinary::SerializeBomb(FArchive& Ar, FFlareBombSave& Data)
+{
+	Ar << Data.Identifier;
+	Ar << Data.Location;
+	Ar << Data.Rotation;
+	Ar << Data.LinearVelocity;
+	Ar << Data.AngularVelocity;
+	Ar << Data.WeaponSlotIdentifier;
+	Ar << Data.AimTargetSpacecraft;
+	Ar << Data.ParentSpacecraft;
+	Ar << Data.AttachTarget;
+	Ar << Data.Activated;
+	Ar << Data.Dropped;
+	Ar << Data.Locked;
+	Ar << Data.DropParentDistance;
+	Ar << Data.LifeTime;
+	Ar << Data.BurnDuration;
+}
+
+void UFlareSaveBinary::SerializeResourcePrice(FArchive& Ar, FFFlareResourcePrice& Data)
+{
+	Ar << Data.ResourceIdentifier;
+	Ar << Data.Price;
+	SerializeFloatBuffer(Ar, Data.Prices);
+}
+
+void UFlareSaveBinary::SerializeFloatBuffer(FArchive& Ar, FFlareFloatBuffer& Data)
+{
+	Ar << Data.MaxSize;
+	Ar << Data.WriteIndex;
+	Ar << Data.Values;
+}
+
+void UFlareSaveBinary::SerializeBundle(FArchive& Ar, FFlareBundle& Data)
+{
+	Ar << Data.FloatValues;
+	Ar << Data.Int32Values;
+	Ar << Data.TransformValues;
+	Ar << Data.NameValues;
+	Ar << Data.StringValues;
+	Ar << Data.Tags;
+
+	// Array values are wrapped in structures
+	int32 VectorArrayCount = Data.VectorArrayValues.Num();
+	Ar << VectorArrayCount;
+	if (Ar.IsLoading())
+	{
+		Data.VectorArrayValues.Empty(VectorArrayCount);
+		for (int32 Index = 0; Index < VectorArrayCount && !Ar.IsError(); Index++)
+		{
+			FName Key;
+			FVectorArray Value;
+			Ar << Key;
+			Ar << Value.Entries;
+			Data.VectorArrayValues.Add(Key, Value);
+		}
+	}
+	else
+	{
+		for (auto& Pair : Data.VectorArrayValues)
+		{
+			Ar << Pair.Key;
+			Ar << Pair.Value.Entries;
+		}
+	}
+
+	int32 NameArrayCount = Data.NameArrayValues.Num();
+	Ar << NameArrayCount;
+	if (Ar.IsLoading())
+	{
+		Data.NameArrayValues.Empty(NameArrayCount);
+		for (int32 Index = 0; Index < NameArrayCount && !Ar.IsError(); Index++)
+		{
+			FName Key;
+			FNameArray Value;
+			Ar << Key;
+			Ar << Value.Entries;
+			Data.NameArrayValues.Add(Key, Value);
+		}
+	}
+	else
+	{
+		for (auto& Pair : Data.NameArrayValues)
+		{
+			Ar << Pair.Key;
+			Ar << Pair.Value.Entries;
+		}
+	}
+}
+
+void UFlareSaveBinary::SerializeTravel(FArchive& Ar, FFlareTravelSave& Data)
+{
+	Ar << Data.FleetIdentifier;
+	Ar << Data.OriginSectorIdentifier;
+	Ar << Data.DestinationSectorIdentifier;
+	Ar << Data.DepartureDate;
+	SerializeSector(Ar, Data.SectorData);
+}
+
+void UFlareSaveBinary::SerializeText(FArchive& Ar, FText& Data)
+{
+	// Texts are saved as their display string, like in the JSON saves
+	FString Value = Data.ToString();
+	Ar << Value;
+
+	if (Ar.IsLoading())
+	{
+		Data = FText::FromString(Value);
+	}
+}
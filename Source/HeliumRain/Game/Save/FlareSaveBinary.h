@@ -0,0 +1,160 @@
+
+#pragma once
+
+#include "Object.h"
+#include "../FlareSaveGame.h"
+#include "FlareSaveBinary.generated.h"
+
+
+struct FFlarePlayerSave;
+struct FFlareQuestSave;
+struct FFlareQuestProgressSave;
+struct FFlareGeneratedQuestSave;
+struct FFlareQuestConditionSave;
+
+struct FFlareCompanyDescription;
+struct FFlareWorldSave;
+
+struct FFlareCompanySave;
+
+struct FFlareSpacecraftSave;
+struct FFlareShipPilotSave;
+struct FFlareAsteroidSave;
+struct FFlareSpacecraftComponentSave;
+struct FFlareSpacecraftComponentTurretSave;
+struct FFlareSpacecraftComponentWeaponSave;
+struct FFlareTurretPilotSave;
+
+struct FFlareCargoSave;
+struct FFlareFactorySave;
+
+struct FFlareFleetSave;
+struct FFlareTradeRouteSave;
+struct FFlareTradeRouteSectorSave;
+struct FFlareTradeRouteSectorOperationSave;
+struct FFlareCompanySectorKnowledge;
+struct FFlareCompanyAISave;
+struct FFlareCompanyReputationSave;
+
+struct FFlareSectorSave;
+struct FFlarePeopleSave;
+struct FFlareBombSave;
+struct FFFlareResourcePrice;
+struct FFlareTravelSave;
+struct FFlareFloatBuffer;
+
+
+/** Binary save format identification */
+#define FLARE_SAVE_BINARY_MAGIC 0x48525356
+#define FLARE_SAVE_BINARY_VERSION 1
+#define FLARE_SAVE_HEADER_MAGIC 0x48525348
+#define FLARE_SAVE_HEADER_VERSION 1
+
+
+/** Binary save format. The same code path writes and reads the save data, depending on the archive direction */
+UCLASS()
+class HELIUMRAIN_API UFlareSaveBinary: public UObject
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	/** Write the save to an archive, FNames must be serialized as strings */
+	bool SaveGame(FArchive& Ar, UFlareSaveGame* Data);
+
+	/** Read a save from an archive, return NULL if the archive isn't a valid binary save */
+	UFlareSaveGame* LoadGame(FArchive& Ar);
+
+	/** Write a save summary to an archive */
+	bool SaveHeader(FArchive& Ar, FFlareSaveSlotHeader& Data);
+
+	/** Read a save summary from an archive */
+	bool LoadHeader(FArchive& Ar, FFlareSaveSlotHeader& Data);
+
+protected:
+
+	/*----------------------------------------------------
+	  Serializers
+	----------------------------------------------------*/
+
+	bool SerializeHeader(FArchive& Ar, uint32 ExpectedMagic, int32 ExpectedVersion);
+	void SerializeGame(FArchive& Ar, UFlareSaveGame* Data);
+	void SerializeSlotHeader(FArchive& Ar, FFlareSaveSlotHeader& Data);
+
+	void SerializePlayer(FArchive& Ar, FFlarePlayerSave& Data);
+	void SerializeQuest(FArchive& Ar, FFlareQuestSave& Data);
+	void SerializeQuestProgress(FArchive& Ar, FFlareQuestProgressSave& Data);
+	void SerializeGeneratedQuest(FArchive& Ar, FFlareGeneratedQuestSave& Data);
+	void SerializeQuestStepProgress(FArchive& Ar, FFlareQuestConditionSave& Data);
+
+	void SerializeCompanyDescription(FArchive& Ar, FFlareCompanyDescription& Data);
+	void SerializeWorld(FArchive& Ar, FFlareWorldSave& Data);
+
+	void SerializeCompany(FArchive& Ar, FFlareCompanySave& Data);
+
+	void SerializeSpacecraft(FArchive& Ar, FFlareSpacecraftSave& Data);
+	void SerializePilot(FArchive& Ar, FFlareShipPilotSave& Data);
+	void SerializeAsteroid(FArchive& Ar, FFlareAsteroidSave& Data);
+	void SerializeMeteorite(FArchive& Ar, FFlareMeteoriteSave& Data);
+	void SerializeSpacecraftComponent(FArchive& Ar, FFlareSpacecraftComponentSave& Data);
+	void SerializeTurretPilot(FArchive& Ar, FFlareTurretPilotSave& Data);
+	void SerializeStationConnection(FArchive& Ar, FFlareConnectionSave& Data);
+
+	void SerializeTradeOperation(FArchive& Ar, FFlareTradeRouteSectorOperationSave& Data);
+	void SerializeCargo(FArchive& Ar, FFlareCargoSave& Data);
+	void SerializeFactory(FArchive& Ar, FFlareFactorySave& Data);
+	void SerializeShipyardOrder(FArchive& Ar, FFlareShipyardOrderSave& Data);
+
+	void SerializeFleet(FArchive& Ar, FFlareFleetSave& Data);
+	void SerializeTradeRoute(FArchive& Ar, FFlareTradeRouteSave& Data);
+	void SerializeTradeRouteSector(FArchive& Ar, FFlareTradeRouteSectorSave& Data);
+	void SerializeSectorKnowledge(FArchive& Ar, FFlareCompanySectorKnowledge& Data);
+	void SerializeTransactionLogEntry(FArchive& Ar, FFlareTransactionLogEntry& Data);
+	void SerializeCompanyAI(FArchive& Ar, FFlareCompanyAISave& Data);
+	void SerializeCompanyReputation(FArchive& Ar, FFlareCompanyReputationSave& Data);
+
+	void SerializeSector(FArchive& Ar, FFlareSectorSave& Data);
+	void SerializePeople(FArchive& Ar, FFlarePeopleSave& Data);
+	void SerializeBomb(FArchive& Ar, FFlareBombSave& Data);
+	void SerializeResourcePrice(FArchive& Ar, FFFlareResourcePrice& Data);
+	void SerializeFloatBuffer(FArchive& Ar, FFlareFloatBuffer& Data);
+	void SerializeBundle(FArchive& Ar, FFlareBundle& Data);
+
+	void SerializeTravel(FArchive& Ar, FFlareTravelSave& Data);
+
+	void SerializeText(FArchive& Ar, FText& Data);
+
+	/** Serialize an array of save structures with one of the serializers above */
+	template<typename T>
+	void SerializeArray(FArchive& Ar, TArray<T>& Data, void (UFlareSaveBinary::*SerializeItem)(FArchive&, T&))
+	{
+		int32 Count = Data.Num();
+		Ar << Count;
+
+		if (Ar.IsLoading())
+		{
+			if (Count < 0 || Ar.IsError())
+			{
+				Ar.SetError();
+				return;
+			}
+			Data.Empty(Count);
+			Data.AddDefaulted(Count);
+		}
+
+		for (T& Item : Data)
+		{
+			(this->*SerializeItem)(Ar, Item);
+		}
+	}
+
+	/** Enums are stored as a byte */
+	template<typename TEnum>
+	static void SerializeEnum(FArchive& Ar, TEnum& Data)
+	{
+		uint8 Value = (uint8) Data;
+		Ar << Value;
+		Data = (TEnum) Value;
+	}
+
+};
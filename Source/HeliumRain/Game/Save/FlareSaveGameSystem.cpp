@@ -4,7 +4,18 @@
 
 #include "FlareSaveWriter.h"
 #include "FlareSaveReaderV1.h"
+#include "FlareSaveBinary.h"
 #include "../FlareGame.h"
+#include "../FlareSaveGame.h"
+
+#include "Serialization/ArchiveSaveCompressedProxy.h"
+#include "Serialization/ArchiveLoadCompressedProxy.h"
+#include "Serialization/BufferArchive.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/NameAsStringProxyArchive.h"
+
+
+bool UFlareSaveGameSystem::UseBinaryFormat = true;
 
 
 /*----------------------------------------------------
@@ -23,7 +34,9 @@ UFlareSaveGameSystem::UFlareSaveGameSystem(const FObjectInitializer& ObjectIniti
 
 bool UFlareSaveGameSystem::DoesSaveGameExist(const FString SaveName)
 {
-	return IFileManager::Get().FileSize(*GetSaveGamePath(SaveName, true)) >= 0 || IFileManager::Get().FileSize(*GetSaveGamePath(SaveName, false)) >= 0;
+	return IFileManager::Get().FileSize(*GetBinarySaveGamePath(SaveName)) >= 0
+		|| IFileManager::Get().FileSize(*GetSaveGamePath(SaveName, true)) >= 0
+		|| IFileManager::Get().FileSize(*GetSaveGamePath(SaveName, false)) >= 0;
 }
 
 bool UFlareSaveGameSystem::SaveGame(const FString SaveName, UFlareSaveGame* SaveData)
@@ -32,6 +45,36 @@ bool UFlareSaveGameSystem::SaveGame(const FString SaveName, UFlareSaveGame* Save
 	SaveLock.Lock();
 	FLOGV("UFlareSaveGameSystem::SaveGame SaveName=%s", *SaveName);
 
+	if (UseBinaryFormat)
+	{
+		ret = SaveGameBinary(SaveName, SaveData);
+	}
+	else
+	{
+		ret = SaveGameJson(SaveName, SaveData);
+	}
+
+	// Keep the slot summary in sync
+	if (ret)
+	{
+		FFlareSaveSlotHeader Header;
+		BuildHeader(SaveData, Header);
+		SaveHeader(SaveName, Header);
+	}
+
+	SaveLock.Unlock();
+
+	SaveListLock.Lock();
+	SaveList.Remove(SaveData);
+	SaveListLock.Unlock();
+
+	return ret;
+}
+
+bool UFlareSaveGameSystem::SaveGameJson(const FString SaveName, UFlareSaveGame* SaveData)
+{
+	bool ret = false;
+
 	UFlareSaveWriter* SaveWriter = NewObject<UFlareSaveWriter>(this, UFlareSaveWriter::StaticClass());
 	TSharedRef<FJsonObject> JsonObject = SaveWriter->SaveGame(SaveData);
 
@@ -72,11 +115,43 @@ bool UFlareSaveGameSystem::SaveGame(const FString SaveName, UFlareSaveGame* Save
 		ret = false;
 	}
 
-	SaveLock.Unlock();
+	// Don't let an older binary save shadow this one
+	if (ret)
+	{
+		IFileManager::Get().Delete(*GetBinarySaveGamePath(SaveName), false, false, true);
+	}
 
-	SaveListLock.Lock();
-	SaveList.Remove(SaveData);
-	SaveListLock.Unlock();
+	return ret;
+}
+
+bool UFlareSaveGameSystem::SaveGameBinary(const FString SaveName, UFlareSaveGame* SaveData)
+{
+	// Stream the save through the compressor, names are stored as strings
+	TArray<uint8> CompressedData;
+	FArchiveSaveCompressedProxy Compressor(CompressedData, COMPRESS_ZLIB);
+	FNameAsStringProxyArchive Archive(Compressor);
+
+	UFlareSaveBinary* SaveBinary = NewObject<UFlareSaveBinary>(this, UFlareSaveBinary::StaticClass());
+	bool ret = SaveBinary->SaveGame(Archive, SaveData);
+	Compressor.Flush();
+
+	if (ret && !Compressor.IsError())
+	{
+		ret = FFileHelper::SaveArrayToFile(CompressedData, *GetBinarySaveGamePath(SaveName));
+		FLOGV("UFlareSaveGameSystem::SaveGameBinary : Save done (%d bytes)", CompressedData.Num());
+	}
+	else
+	{
+		FLOGV("Fail to serialize save %s", *SaveName);
+		ret = false;
+	}
+
+	// The JSON saves of this slot are now stale
+	if (ret)
+	{
+		IFileManager::Get().Delete(*GetSaveGamePath(SaveName, true), false, false, true);
+		IFileManager::Get().Delete(*GetSaveGamePath(SaveName, false), false, false, true);
+	}
 
 	return ret;
 }
@@ -85,6 +160,52 @@ UFlareSaveGame* UFlareSaveGameSystem::LoadGame(const FString SaveName)
 {
 	FLOGV("UFlareSaveGameSystem::LoadGame SaveName=%s", *SaveName);
 
+	UFlareSaveGame* SaveGame = LoadGameBinary(SaveName);
+
+	// Legacy JSON saves
+	if (!SaveGame)
+	{
+		SaveGame = LoadGameJson(SaveName);
+	}
+
+	return SaveGame;
+}
+
+UFlareSaveGame* UFlareSaveGameSystem::LoadGameBinary(const FString SaveName)
+{
+	FString Filename = GetBinarySaveGamePath(SaveName);
+	if (IFileManager::Get().FileSize(*Filename) < 0)
+	{
+		return NULL;
+	}
+
+	TArray<uint8> CompressedData;
+	if (!FFileHelper::LoadFileToArray(CompressedData, *Filename))
+	{
+		FLOGV("Fail to read save '%s'", *Filename);
+		return NULL;
+	}
+
+	FArchiveLoadCompressedProxy Decompressor(CompressedData, COMPRESS_ZLIB);
+	FNameAsStringProxyArchive Archive(Decompressor);
+
+	UFlareSaveBinary* SaveBinary = NewObject<UFlareSaveBinary>(this, UFlareSaveBinary::StaticClass());
+	UFlareSaveGame* SaveGame = SaveBinary->LoadGame(Archive);
+
+	if (SaveGame)
+	{
+		FLOGV("Save '%s' read", *Filename);
+	}
+	else
+	{
+		FLOGV("Fail to deserialize save '%s'", *Filename);
+	}
+
+	return SaveGame;
+}
+
+UFlareSaveGame* UFlareSaveGameSystem::LoadGameJson(const FString SaveName)
+{
 	UFlareSaveGame *SaveGame = NULL;
 
 	// Read the saveto a string
@@ -160,10 +281,81 @@ UFlareSaveGame* UFlareSaveGameSystem::LoadGame(const FString SaveName)
 
 bool UFlareSaveGameSystem::DeleteGame(const FString SaveName)
 {
-	bool Result = IFileManager::Get().Delete(*GetSaveGamePath(SaveName, false), true) | IFileManager::Get().Delete(*GetSaveGamePath(SaveName, true), true);
+	bool Result = IFileManager::Get().Delete(*GetSaveGamePath(SaveName, false), true)
+		| IFileManager::Get().Delete(*GetSaveGamePath(SaveName, true), true)
+		| IFileManager::Get().Delete(*GetBinarySaveGamePath(SaveName), true);
+	IFileManager::Get().Delete(*GetSaveHeaderPath(SaveName), false, false, true);
 	return Result;
 }
 
+bool UFlareSaveGameSystem::SaveHeader(const FString SaveName, FFlareSaveSlotHeader& Header)
+{
+	FBufferArchive Buffer;
+	FNameAsStringProxyArchive Archive(Buffer);
+
+	UFlareSaveBinary* SaveBinary = NewObject<UFlareSaveBinary>(this, UFlareSaveBinary::StaticClass());
+	if (!SaveBinary->SaveHeader(Archive, Header))
+	{
+		FLOGV("Fail to serialize save header %s", *SaveName);
+		return false;
+	}
+
+	return FFileHelper::SaveArrayToFile(Buffer, *GetSaveHeaderPath(SaveName));
+}
+
+bool UFlareSaveGameSystem::LoadHeader(const FString SaveName, FFlareSaveSlotHeader& Header)
+{
+	FString Filename = GetSaveHeaderPath(SaveName);
+
+	// The save may have been replaced without its summary
+	IFileManager& FileManager = IFileManager::Get();
+	FDateTime HeaderTime = FileManager.GetTimeStamp(*Filename);
+	FDateTime SaveTime = FMath::Max(FileManager.GetTimeStamp(*GetBinarySaveGamePath(SaveName)),
+		FMath::Max(FileManager.GetTimeStamp(*GetSaveGamePath(SaveName, true)), FileManager.GetTimeStamp(*GetSaveGamePath(SaveName, false))));
+	if (HeaderTime == FDateTime::MinValue() || SaveTime == FDateTime::MinValue() || HeaderTime < SaveTime)
+	{
+		return false;
+	}
+
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *Filename))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Data);
+	FNameAsStringProxyArchive Archive(Reader);
+
+	UFlareSaveBinary* SaveBinary = NewObject<UFlareSaveBinary>(this, UFlareSaveBinary::StaticClass());
+	return SaveBinary->LoadHeader(Archive, Header);
+}
+
+void UFlareSaveGameSystem::BuildHeader(UFlareSaveGame* SaveData, FFlareSaveSlotHeader& Header)
+{
+	const FFlareCompanyDescription& Desc = SaveData->PlayerCompanyDescription;
+
+	Header.UUID = SaveData->PlayerData.UUID;
+	Header.HasPlayerCompany = false;
+	Header.CompanyName = Desc.Name;
+	Header.CompanyShipCount = 0;
+	Header.CompanyValue = 0;
+	Header.PlayerEmblemIndex = SaveData->PlayerData.PlayerEmblemIndex;
+	Header.CustomizationBasePaintColor = Desc.CustomizationBasePaintColor;
+	Header.CustomizationPaintColor = Desc.CustomizationPaintColor;
+	Header.CustomizationOverlayColor = Desc.CustomizationOverlayColor;
+	Header.CustomizationLightColor = Desc.CustomizationLightColor;
+
+	// Find player company and count ships
+	for (const FFlareCompanySave& Company : SaveData->WorldData.CompanyData)
+	{
+		if (Company.Identifier == SaveData->PlayerData.CompanyIdentifier)
+		{
+			Header.HasPlayerCompany = true;
+			Header.CompanyShipCount = Company.ShipData.Num();
+			Header.CompanyValue = Company.CompanyValue;
+		}
+	}
+}
 
 void UFlareSaveGameSystem::PushSaveData(UFlareSaveGame* SaveData)
 {
@@ -189,3 +381,13 @@ FString UFlareSaveGameSystem::GetSaveGamePath(const FString SaveName, bool compr
 		return FString::Printf(TEXT("%s/SaveGames/%s.json"), *FPaths::ProjectSavedDir(), *SaveName);
 	}
 }
+
+FString UFlareSaveGameSystem::GetBinarySaveGamePath(const FString SaveName)
+{
+	return FString::Printf(TEXT("%s/SaveGames/%s.hrsave"), *FPaths::ProjectSavedDir(), *SaveName);
+}
+
+FString UFlareSaveGameSystem::GetSaveHeaderPath(const FString SaveName)
+{
+	return FString::Printf(TEXT("%s/SaveGames/%s.header"), *FPaths::ProjectSavedDir(), *SaveName);
+}
@@ -5,6 +5,7 @@
 #include "FlareSaveGameSystem.generated.h"
 
 class UFlareSaveGame;
+struct FFlareSaveSlotHeader;
 
 UCLASS()
 class HELIUMRAIN_API UFlareSaveGameSystem: public UObject
@@ -23,11 +24,32 @@ public:
 
 	virtual bool SaveGame(const FString SaveName, UFlareSaveGame* SaveData);
 
+	/** Save in the legacy gzipped JSON format */
+	bool SaveGameJson(const FString SaveName, UFlareSaveGame* SaveData);
+
+	/** Save in the compressed binary format */
+	bool SaveGameBinary(const FString SaveName, UFlareSaveGame* SaveData);
+
 	virtual UFlareSaveGame* LoadGame(const FString SaveName);
 
+	/** Load a JSON save, compressed or not */
+	UFlareSaveGame* LoadGameJson(const FString SaveName);
+
+	/** Load a binary save, return NULL if there is none */
+	UFlareSaveGame* LoadGameBinary(const FString SaveName);
+
 
 	virtual bool DeleteGame(const FString SaveName);
 
+	/** Write the summary of a save next to it */
+	bool SaveHeader(const FString SaveName, FFlareSaveSlotHeader& Header);
+
+	/** Read the summary of a save, return false if there is none or if it's older than the save */
+	bool LoadHeader(const FString SaveName, FFlareSaveSlotHeader& Header);
+
+	/** Compute the summary of a save */
+	static void BuildHeader(UFlareSaveGame* SaveData, FFlareSaveSlotHeader& Header);
+
 	/* Keep Save data reference for the async save*/
 	virtual void PushSaveData(UFlareSaveGame* SaveData);
 
@@ -55,4 +77,13 @@ public:
    /** Get the path to save game file for the given name, a platform _may_ be able to simply override this and no other functions above */
    static FString GetSaveGamePath(const FString SaveName, bool compressed);
 
+	/** Get the path to the binary save game file for the given name */
+	static FString GetBinarySaveGamePath(const FString SaveName);
+
+	/** Get the path to the save summary file for the given name */
+	static FString GetSaveHeaderPath(const FString SaveName);
+
+	/** Write new saves in the binary format. JSON saves are still loaded */
+	static bool UseBinaryFormat;
+
 };
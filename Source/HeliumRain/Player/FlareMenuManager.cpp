@@ -60,6 +60,7 @@ AFlareMenuManager::AFlareMenuManager(const class FObjectInitializer& PCIP)
 	, MenuIsOpen(false)
 	, FadeFromBlack(true)
 	, NotifyExitSector(false)
+	, NotificationBatchActive(false)
 	, FadeDuration(0.3)
 	, SkirmishCountdownDuration(11)
 	, SkirmishCountdownTimer(-1)
@@ -479,11 +480,53 @@ bool AFlareMenuManager::Notify(FText Text, FText Info, FName Tag, EFlareNotifica
 		{
 			OrbitMenu->RequestStopFastForward();
 		}
+
+		// Keep the latest notification of each tag until the batch ends
+		if (NotificationBatchActive)
+		{
+			if (Tag != NAME_None)
+			{
+				PendingNotifications.RemoveAll([=](const FFlarePendingNotification& Pending)
+				{
+					return Pending.Tag == Tag;
+				});
+			}
+
+			FFlarePendingNotification Pending;
+			Pending.Text = Text;
+			Pending.Info = Info;
+			Pending.Tag = Tag;
+			Pending.Type = Type;
+			Pending.Pinned = Pinned;
+			Pending.TargetMenu = TargetMenu;
+			Pending.TargetInfo = TargetInfo;
+			PendingNotifications.Add(Pending);
+			return false;
+		}
+
 		return Notifier->Notify(Text, Info, Tag, Type, Pinned, TargetMenu, TargetInfo);
 	}
 	return false;
 }
 
+void AFlareMenuManager::BeginNotificationBatch()
+{
+	NotificationBatchActive = true;
+}
+
+void AFlareMenuManager::EndNotificationBatch()
+{
+	NotificationBatchActive = false;
+
+	TArray<FFlarePendingNotification> Notifications = PendingNotifications;
+	PendingNotifications.Empty();
+
+	for (const FFlarePendingNotification& Pending : Notifications)
+	{
+		GetPC()->Notify(Pending.Text, Pending.Info, Pending.Tag, Pending.Type, Pending.Pinned, Pending.TargetMenu, Pending.TargetInfo);
+	}
+}
+
 void AFlareMenuManager::ClearNotifications(FName Tag)
 {
 	if (MainOverlay.IsValid())
@@ -48,6 +48,18 @@ class AFlareGame;
 // Menu state
 typedef TPair<EFlareMenu::Type, FFlareMenuParameterData> TFlareMenuData;
 
+/** Notification held back while several days are simulated in a row */
+struct FFlarePendingNotification
+{
+	FText                                   Text;
+	FText                                   Info;
+	FName                                   Tag;
+	EFlareNotification::Type                Type;
+	bool                                    Pinned;
+	EFlareMenu::Type                        TargetMenu;
+	FFlareMenuParameterData                 TargetInfo;
+};
+
 
 /*----------------------------------------------------
 	Menu manager code
@@ -113,6 +125,12 @@ public:
 	/** Remove all notifications from the screen */
 	void FlushNotifications();
 
+	/** Hold back notifications, only the latest one of each tag will be shown */
+	void BeginNotificationBatch();
+
+	/** Show the notifications held back since BeginNotificationBatch */
+	void EndNotificationBatch();
+
 	/** Show the confirmation overlay */
 	void Confirm(FText Title, FText Text, FSimpleDelegate OnConfirmed, FSimpleDelegate OnCancel = FSimpleDelegate(), FSimpleDelegate OnIgnore = FSimpleDelegate());
 
@@ -386,6 +404,7 @@ protected:
 	bool                                    FadeFromBlack;
 	bool                                    SkipNextFade;
 	bool                                    NotifyExitSector;
+	bool                                    NotificationBatchActive;
 	float                                   FadeDuration;
 	float                                   FadeTimer;
 	float                                   SkirmishCountdownDuration;
@@ -395,6 +414,7 @@ protected:
 	TArray<TFlareMenuData>                  MenuHistory;
 	SFlareSpacecraftInfo*                   CurrentSpacecraftInfo;
 	FVector2D                               JoystickCursorPosition;
+	TArray<FFlarePendingNotification>       PendingNotifications;
 
 	// Menu tools
 	TSharedPtr<SBorder>                     Fader;
@@ -77,9 +77,8 @@ public:
 
 	virtual FText FormatTags(FText Message);
 
-	virtual int32 GetReservedCapacity(UFlareSimulatedSpacecraft* Station, FFlareResourceDescription* Resource) { return 0; };
-
-	virtual int32 GetReservedQuantity(UFlareSimulatedSpacecraft* Station, FFlareResourceDescription* Resource) { return 0; };
+	/** Add the cargo this quest keeps in stations while it is available or ongoing */
+	virtual void GetReservations(TArray<FFlareQuestReservation>& OutReservations) {};
 
 
 	/*----------------------------------------------------
@@ -274,7 +274,7 @@ void UFlareQuestGenerator::GenerateSectorQuest(UFlareSimulatedSector* Sector)
 	for (int32 SectorIndex = 0; SectorIndex < PlayerCompany->GetKnownSectors().Num(); SectorIndex++)
 	{
 		UFlareSimulatedSector* KnownSector = PlayerCompany->GetKnownSectors()[SectorIndex];
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats1 = SectorHelper::ComputeSectorResourceStats(KnownSector, false);
+		const TArray<WorldHelper::FlareResourceStats>& Stats1 = KnownSector->GetResourceStats(false);
 
 		for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
 		{
@@ -286,11 +286,11 @@ void UFlareQuestGenerator::GenerateSectorQuest(UFlareSimulatedSector* Sector)
 				continue;
 			}
 
-			if(Stats1[Resource].Production > 0)
+			if(Stats1[Resource->Index].Production > 0)
 			{
 				AvailableResources.Add(Resource);
 				//FLOGV("%s is available in %s %d", *Resource->Identifier.ToString(), *KnownSector->GetSectorName().ToString(),
-				//	Stats1[Resource].Production);
+				//	Stats1[Resource->Index].Production);
 			}
 		}
 	}
@@ -1095,22 +1095,15 @@ bool UFlareQuestGeneratedResourceSale::Load(UFlareQuestGenerator* Parent, const
 	return true;
 }
 
-int32 UFlareQuestGeneratedResourceSale::GetReservedQuantity(UFlareSimulatedSpacecraft* TargetStation, FFlareResourceDescription* TargetResource)
+void UFlareQuestGeneratedResourceSale::GetReservations(TArray<FFlareQuestReservation>& OutReservations)
 {
 	UFlareSimulatedSpacecraft* Station = QuestManager->GetGame()->GetGameWorld()->FindSpacecraft(InitData.GetName("station"));
-	// TODO Cache
+	FFlareResourceDescription* Resource = QuestManager->GetGame()->GetResourceCatalog()->Get(InitData.GetName("resource"));
 
-	if (Station == TargetStation)
+	if (Station && Resource)
 	{
-		FFlareResourceDescription* Resource = QuestManager->GetGame()->GetResourceCatalog()->Get(InitData.GetName("resource"));
-		if (Resource == TargetResource)
-		{
-			int32 Quantity = InitData.GetInt32("quantity");
-			return Quantity;
-		}
+		OutReservations.Add(FFlareQuestReservation(Station, Resource, InitData.GetInt32("quantity"), 0));
 	}
-
-	return 0;
 }
 
 /*----------------------------------------------------
@@ -1320,22 +1313,15 @@ bool UFlareQuestGeneratedResourcePurchase::Load(UFlareQuestGenerator* Parent, co
 	return true;
 }
 
-int32 UFlareQuestGeneratedResourcePurchase::GetReservedCapacity(UFlareSimulatedSpacecraft* TargetStation, FFlareResourceDescription* TargetResource)
+void UFlareQuestGeneratedResourcePurchase::GetReservations(TArray<FFlareQuestReservation>& OutReservations)
 {
 	UFlareSimulatedSpacecraft* Station = QuestManager->GetGame()->GetGameWorld()->FindSpacecraft(InitData.GetName("station"));
-	// TODO Cache
+	FFlareResourceDescription* Resource = QuestManager->GetGame()->GetResourceCatalog()->Get(InitData.GetName("resource"));
 
-	if (Station == TargetStation)
+	if (Station && Resource)
 	{
-		FFlareResourceDescription* Resource = QuestManager->GetGame()->GetResourceCatalog()->Get(InitData.GetName("resource"));
-		if (Resource == TargetResource)
-		{
-			int32 Quantity = InitData.GetInt32("quantity");
-			return Quantity;
-		}
+		OutReservations.Add(FFlareQuestReservation(Station, Resource, 0, InitData.GetInt32("quantity")));
 	}
-
-	return 0;
 }
 
 /*----------------------------------------------------
@@ -1601,40 +1587,26 @@ bool UFlareQuestGeneratedResourceTrade::Load(UFlareQuestGenerator* Parent, const
 	return true;
 }
 
-int32 UFlareQuestGeneratedResourceTrade::GetReservedCapacity(UFlareSimulatedSpacecraft* TargetStation, FFlareResourceDescription* TargetResource)
+void UFlareQuestGeneratedResourceTrade::GetReservations(TArray<FFlareQuestReservation>& OutReservations)
 {
+	UFlareSimulatedSpacecraft* Station1 = QuestManager->GetGame()->GetGameWorld()->FindSpacecraft(InitData.GetName("station1"));
 	UFlareSimulatedSpacecraft* Station2 = QuestManager->GetGame()->GetGameWorld()->FindSpacecraft(InitData.GetName("station2"));
-	// TODO Cache
+	FFlareResourceDescription* Resource = QuestManager->GetGame()->GetResourceCatalog()->Get(InitData.GetName("resource"));
+	int32 Quantity = InitData.GetInt32("quantity");
 
-	if (Station2 == TargetStation)
+	if (Resource)
 	{
-		FFlareResourceDescription* Resource = QuestManager->GetGame()->GetResourceCatalog()->Get(InitData.GetName("resource"));
-		if (Resource == TargetResource)
+		// Stock is kept in the source station, space in the destination station
+		if (Station1)
 		{
-			int32 Quantity = InitData.GetInt32("quantity");
-			return Quantity;
+			OutReservations.Add(FFlareQuestReservation(Station1, Resource, Quantity, 0));
 		}
-	}
-
-	return 0;
-}
-
-int32 UFlareQuestGeneratedResourceTrade::GetReservedQuantity(UFlareSimulatedSpacecraft* TargetStation, FFlareResourceDescription* TargetResource)
-{
-	UFlareSimulatedSpacecraft* Station1 = QuestManager->GetGame()->GetGameWorld()->FindSpacecraft(InitData.GetName("station1"));
-	// TODO Cache
 
-	if (Station1 == TargetStation)
-	{
-		FFlareResourceDescription* Resource = QuestManager->GetGame()->GetResourceCatalog()->Get(InitData.GetName("resource"));
-		if (Resource == TargetResource)
+		if (Station2)
 		{
-			int32 Quantity = InitData.GetInt32("quantity");
-			return Quantity;
+			OutReservations.Add(FFlareQuestReservation(Station2, Resource, 0, Quantity));
 		}
 	}
-
-	return 0;
 }
 /*----------------------------------------------------
 	Generated station defense quest
@@ -52,12 +52,16 @@ void UFlareQuestManager::Load(const FFlareQuestSave& Data)
 	LoadDynamicQuests();
 
 
+	RebuildReservations();
+
 	for(UFlareQuest* Quest: Quests)
 	{
 		LoadCallbacks(Quest);
 		Quest->UpdateState();
 	}
 
+	Game->GetGameWorld()->UpdateHostilityMatrix();
+
 	if (!SelectedQuest)
 	{
 		AutoSelectQuest();
@@ -387,6 +391,8 @@ void UFlareQuestManager::OnShipDocked(UFlareSimulatedSpacecraft* Station, UFlare
 
 void UFlareQuestManager::OnWarStateChanged(UFlareCompany* Company1, UFlareCompany* Company2)
 {
+	GetGame()->GetGameWorld()->UpdateHostilityMatrix();
+
 	OnCallbackEvent(EFlareQuestCallback::WAR_STATE_CHANGED);
 }
 
@@ -432,6 +438,9 @@ void UFlareQuestManager::OnSpacecraftCaptured(UFlareSimulatedSpacecraft* Capture
 		}
 	}
 
+	// Reservations are indexed by station
+	RebuildReservations();
+
 	OnCallbackEvent(EFlareQuestCallback::SPACECRAFT_CAPTURED);
 }
 
@@ -523,6 +532,7 @@ void UFlareQuestManager::OnTravelEnded(UFlareFleet* Fleet)
 void UFlareQuestManager::OnQuestStatusChanged(UFlareQuest* Quest)
 {
 	LoadCallbacks(Quest);
+	GetGame()->GetGameWorld()->UpdateHostilityMatrix();
 
 	OnCallbackEvent(EFlareQuestCallback::QUEST_CHANGED);
 }
@@ -530,7 +540,10 @@ void UFlareQuestManager::OnQuestStatusChanged(UFlareQuest* Quest)
 void UFlareQuestManager::OnQuestSuccess(UFlareQuest* Quest)
 {
 	FLOGV("Quest %s is now successful", *Quest->GetIdentifier().ToString())
-	OngoingQuests.Remove(Quest);
+	if (OngoingQuests.Remove(Quest) > 0)
+	{
+		UpdateReservations(Quest, false);
+	}
 	OldQuests.Add(Quest);
 
 	// Quest successful notification
@@ -558,8 +571,10 @@ void UFlareQuestManager::OnQuestSuccess(UFlareQuest* Quest)
 void UFlareQuestManager::OnQuestFail(UFlareQuest* Quest, bool Notify)
 {
 	FLOGV("Quest %s is now failed", *Quest->GetIdentifier().ToString())
-	OngoingQuests.Remove(Quest);
-	AvailableQuests.Remove(Quest);
+	if (OngoingQuests.Remove(Quest) + AvailableQuests.Remove(Quest) > 0)
+	{
+		UpdateReservations(Quest, false);
+	}
 	PendingQuests.Remove(Quest);
 	OldQuests.Add(Quest);
 
@@ -588,6 +603,7 @@ void UFlareQuestManager::OnQuestAvailable(UFlareQuest* Quest)
 	FLOGV("Quest %s is now available", *Quest->GetIdentifier().ToString())
 	PendingQuests.Remove(Quest);
 	AvailableQuests.Add(Quest);
+	UpdateReservations(Quest, true);
 
 	// New quest notification
 	if (Quest->GetQuestCategory() != EFlareQuestCategory::TUTORIAL && Quest->GetQuestCategory() != EFlareQuestCategory::SECONDARY)
@@ -617,38 +633,70 @@ void UFlareQuestManager::OnQuestOngoing(UFlareQuest* Quest)
 	OnQuestStatusChanged(Quest);
 }
 
-int32 UFlareQuestManager::GetReservedCapacity(UFlareSimulatedSpacecraft* Station, FFlareResourceDescription* Resource)
+int32 UFlareQuestManager::GetReservedCapacity(UFlareSimulatedSpacecraft* Station, FFlareResourceDescription* Resource) const
 {
-	int32 ReservedCapacity = 0;
+	const FFlareQuestReservation* Reservation = Reservations.Find(FFlareQuestReservationKey(Station, Resource));
+	return Reservation ? Reservation->Capacity : 0;
+}
 
-	for(UFlareQuest* Quest: OngoingQuests)
-	{
-		ReservedCapacity += Quest->GetReservedCapacity(Station, Resource);
-	}
+int32 UFlareQuestManager::GetReservedQuantity(UFlareSimulatedSpacecraft* Station, FFlareResourceDescription* Resource) const
+{
+	const FFlareQuestReservation* Reservation = Reservations.Find(FFlareQuestReservationKey(Station, Resource));
+	return Reservation ? Reservation->Quantity : 0;
+}
 
-	for(UFlareQuest* Quest: AvailableQuests)
+void UFlareQuestManager::UpdateReservations(UFlareQuest* Quest, bool Reserve)
+{
+	ReservationBuffer.Reset();
+	Quest->GetReservations(ReservationBuffer);
+
+	for (const FFlareQuestReservation& QuestReservation : ReservationBuffer)
 	{
-		ReservedCapacity += Quest->GetReservedCapacity(Station, Resource);
-	}
+		FFlareQuestReservationKey Key(QuestReservation.Station, QuestReservation.Resource);
+
+		if (Reserve)
+		{
+			FFlareQuestReservation* Reservation = Reservations.Find(Key);
+			if (Reservation)
+			{
+				Reservation->Quantity += QuestReservation.Quantity;
+				Reservation->Capacity += QuestReservation.Capacity;
+			}
+			else
+			{
+				Reservations.Add(Key, QuestReservation);
+			}
+		}
+		else
+		{
+			FFlareQuestReservation* Reservation = Reservations.Find(Key);
+			if (Reservation)
+			{
+				Reservation->Quantity -= QuestReservation.Quantity;
+				Reservation->Capacity -= QuestReservation.Capacity;
 
-	return ReservedCapacity;
+				if (Reservation->Quantity == 0 && Reservation->Capacity == 0)
+				{
+					Reservations.Remove(Key);
+				}
+			}
+		}
+	}
 }
 
-int32 UFlareQuestManager::GetReservedQuantity(UFlareSimulatedSpacecraft* Station, FFlareResourceDescription* Resource)
+void UFlareQuestManager::RebuildReservations()
 {
-	int32 ReservedQuantity = 0;
+	Reservations.Empty();
 
-	for(UFlareQuest* Quest: OngoingQuests)
+	for (UFlareQuest* Quest : OngoingQuests)
 	{
-		ReservedQuantity += Quest->GetReservedQuantity(Station, Resource);
+		UpdateReservations(Quest, true);
 	}
 
-	for(UFlareQuest* Quest: AvailableQuests)
+	for (UFlareQuest* Quest : AvailableQuests)
 	{
-		ReservedQuantity += Quest->GetReservedQuantity(Station, Resource);
+		UpdateReservations(Quest, true);
 	}
-
-	return ReservedQuantity;
 }
 
 /*----------------------------------------------------
@@ -852,274 +900,87 @@ bool UFlareQuestManager::IsTradeQuestUseStation(UFlareSimulatedSpacecraft* Stati
 	return false;
 }
 
-bool UFlareQuestManager::IsUnderMilitaryContract(UFlareSimulatedSector* Sector,  UFlareCompany* Company, bool IncludeCache)
+void UFlareQuestManager::AddMilitaryContracts(FFlareHostilityMatrix& Matrix)
 {
-	if(IsUnderMilitaryContractNoCache(Sector, Company))
-	{
-		for(IsUnderMilitaryContractCacheEntry& CacheEntry : IsUnderMilitaryContractCache)
-		{
-			if(CacheEntry.Sector == Sector && CacheEntry.Company == Company)
-			{
-				CacheEntry.ExpireTime = FPlatformTime::Seconds() + 10.f;
-				return true;
-			}
-		}
+	UFlareWorld* World = GetGame()->GetGameWorld();
 
-		IsUnderMilitaryContractCacheEntry NewEntry;
-		NewEntry.ExpireTime = FPlatformTime::Seconds() + 10.f;
-		NewEntry.Sector = Sector;
-		NewEntry.Company = Company;
-		IsUnderMilitaryContractCache.Add(NewEntry);
-
-		return true;
-	}
-	else if(!IncludeCache)
+	auto GetCompanyIndex = [World](FName Identifier)
 	{
-		return false;
-	}
-	else
+		UFlareCompany* Company = World->FindCompany(Identifier);
+		return Company ? Company->GetWorldIndex() : INDEX_NONE;
+	};
+
+	auto AddSectorContract = [&](FName CompanyIdentifier, FName SectorIdentifier)
 	{
-		int Index = 0;
+		int32 CompanyIndex = GetCompanyIndex(CompanyIdentifier);
+		UFlareSimulatedSector* Sector = World->FindSector(SectorIdentifier);
 
-		for(IsUnderMilitaryContractCacheEntry& CacheEntry : IsUnderMilitaryContractCache)
+		if (Sector && Matrix.IsValidCompany(CompanyIndex) && Matrix.IsValidSector(Sector->GetWorldIndex()))
 		{
-			if(CacheEntry.Sector == Sector && CacheEntry.Company == Company)
-			{
-				if(CacheEntry.ExpireTime > FPlatformTime::Seconds())
-				{
-					return true;
-				}
-				else
-				{
-					IsUnderMilitaryContractCache.RemoveAt(Index);
-					break;
-				}
-			}
-			Index++;
+			Matrix.AddSectorContract(CompanyIndex, Sector->GetWorldIndex());
 		}
+	};
 
-
-		return false;
-	}
-}
-
-bool UFlareQuestManager::IsMilitaryTarget(UFlareSimulatedSpacecraft const* Spacecraft, bool IncludeCache)
-{
-	if(IsMilitaryTargetNoCache(Spacecraft))
+	auto AddHuntContract = [&](FName CompanyIdentifier, EFlareHuntContract::Type Contract)
 	{
-		for(IsMilitaryTargetCacheEntry& CacheEntry : IsMilitaryTargetCache)
-		{
-			if(CacheEntry.Spacecraft == Spacecraft)
-			{
-				CacheEntry.ExpireTime = FPlatformTime::Seconds() + 10.f;
-				return true;
-			}
-		}
-
-		IsMilitaryTargetCacheEntry NewEntry;
-		NewEntry.ExpireTime = FPlatformTime::Seconds();
-		NewEntry.Spacecraft = Spacecraft;
-		IsMilitaryTargetCache.Add(NewEntry);
+		int32 CompanyIndex = GetCompanyIndex(CompanyIdentifier);
 
-		return true;
-	}
-	else if(!IncludeCache)
-	{
-		return false;
-	}
-	else
-	{
-		int Index = 0;
-		for(IsMilitaryTargetCacheEntry& CacheEntry : IsMilitaryTargetCache)
+		if (Matrix.IsValidCompany(CompanyIndex))
 		{
-			if(CacheEntry.Spacecraft == Spacecraft)
-			{
-				if(CacheEntry.ExpireTime > FPlatformTime::Seconds())
-				{
-					return true;
-				}
-				else
-				{
-					IsMilitaryTargetCache.RemoveAt(Index);
-					break;
-				}
-			}
-			Index++;
+			Matrix.AddHuntContract(CompanyIndex, Contract);
 		}
-		return false;
-	}
-}
+	};
 
-bool UFlareQuestManager::IsUnderMilitaryContractNoCache(UFlareSimulatedSector* Sector,  UFlareCompany* Company)
-{
 	for(UFlareQuest* OngoingQuest : GetOngoingQuests())
 	{
 		UFlareQuestGeneratedCargoHunt2* CargoHunt = Cast<UFlareQuestGeneratedCargoHunt2>(OngoingQuest);
 		if(CargoHunt)
 		{
-
-			if(CargoHunt->GetInitData()->GetName("hostile-company") != Company->GetIdentifier())
-			{
-				continue;
-			}
-
 			bool TargetLargeCargo = CargoHunt->GetInitData()->GetInt32("large-cargo") > 0;
-
-			for(UFlareSimulatedSpacecraft* Ship : Sector->GetSectorShips())
-			{
-				if(Ship->GetCompany() != Company)
-				{
-					continue;
-				}
-
-				if(Ship->IsMilitary())
-				{
-					continue;
-				}
-
-				if(TargetLargeCargo == (Ship->GetSize() == EFlarePartSize::L))
-				{
-					return true;
-				}
-			}
+			AddHuntContract(CargoHunt->GetInitData()->GetName("hostile-company"),
+				TargetLargeCargo ? EFlareHuntContract::LargeCargo : EFlareHuntContract::SmallCargo);
+			continue;
 		}
 
 		UFlareQuestGeneratedMilitaryHunt2* MilitaryHunt = Cast<UFlareQuestGeneratedMilitaryHunt2>(OngoingQuest);
 		if(MilitaryHunt)
 		{
-			if(MilitaryHunt->GetInitData()->GetName("hostile-company") != Company->GetIdentifier())
-			{
-				continue;
-			}
-
-
-			for(UFlareSimulatedSpacecraft* Ship : Sector->GetSectorShips())
-			{
-				if(Ship->GetCompany() != Company)
-				{
-					continue;
-				}
-
-				if(!Ship->IsMilitary())
-				{
-					continue;
-				}
-
-				return true;
-			}
+			AddHuntContract(MilitaryHunt->GetInitData()->GetName("hostile-company"), EFlareHuntContract::Military);
+			continue;
 		}
 
 		UFlareQuestGeneratedStationDefense2* StationDefense = Cast<UFlareQuestGeneratedStationDefense2>(OngoingQuest);
 		if(StationDefense)
 		{
-			if(StationDefense->GetInitData()->GetName("hostile-company") != Company->GetIdentifier())
-			{
-				continue;
-			}
-
-			if(StationDefense->GetInitData()->GetName("sector") != Sector->GetIdentifier())
-			{
-				continue;
-			}
-
-			return true;
+			AddSectorContract(StationDefense->GetInitData()->GetName("hostile-company"), StationDefense->GetInitData()->GetName("sector"));
+			continue;
 		}
 
+		// Attack contracts only apply on the attack date
 		UFlareQuestGeneratedJoinAttack2* JoinAttack = Cast<UFlareQuestGeneratedJoinAttack2>(OngoingQuest);
 		if(JoinAttack)
 		{
-
-			if(JoinAttack->GetInitData()->GetName("sector") != Sector->GetIdentifier())
-			{
-				continue;
-			}
-
-			int32 AttackDate = JoinAttack->GetInitData()->GetInt32("attack-date");
-			if(GetGame()->GetGameWorld()->GetDate() != AttackDate)
+			if(World->GetDate() == JoinAttack->GetInitData()->GetInt32("attack-date"))
 			{
-				continue;
-			}
-
-			TArray<FName> HostileCompanyNames = JoinAttack->GetInitData()->GetNameArray("hostile-companies");
-			for(FName HostileCompanyName : HostileCompanyNames)
-			{
-				if(HostileCompanyName  == Company->GetIdentifier())
+				TArray<FName> HostileCompanyNames = JoinAttack->GetInitData()->GetNameArray("hostile-companies");
+				for(FName HostileCompanyName : HostileCompanyNames)
 				{
-					return true;
+					AddSectorContract(HostileCompanyName, JoinAttack->GetInitData()->GetName("sector"));
 				}
 			}
-
 			continue;
 		}
 
 		UFlareQuestGeneratedSectorDefense2* SectorDefense = Cast<UFlareQuestGeneratedSectorDefense2>(OngoingQuest);
 		if(SectorDefense)
 		{
-			if(SectorDefense->GetInitData()->GetName("hostile-company") != Company->GetIdentifier())
-			{
-				continue;
-			}
-
-			int32 AttackDate = SectorDefense->GetInitData()->GetInt32("attack-date");
-			if(GetGame()->GetGameWorld()->GetDate() != AttackDate)
-			{
-				continue;
-			}
-
-			if(SectorDefense->GetInitData()->GetName("sector") != Sector->GetIdentifier())
-			{
-				continue;
-			}
-
-			return true;
-		}
-	}
-
-	return false;
-}
-
-bool UFlareQuestManager::IsMilitaryTargetNoCache(UFlareSimulatedSpacecraft const* Spacecraft)
-{
-	for(UFlareQuest* OngoingQuest : GetOngoingQuests())
-	{
-		UFlareQuestGeneratedCargoHunt2* CargoHunt = Cast<UFlareQuestGeneratedCargoHunt2>(OngoingQuest);
-		if(CargoHunt)
-		{
-			if(Spacecraft->IsMilitary())
+			if(World->GetDate() == SectorDefense->GetInitData()->GetInt32("attack-date"))
 			{
-		continue;
-			}
-
-			if(CargoHunt->GetInitData()->GetName("hostile-company") != Spacecraft->GetCompany()->GetIdentifier())
-			{
-				continue;
+				AddSectorContract(SectorDefense->GetInitData()->GetName("hostile-company"), SectorDefense->GetInitData()->GetName("sector"));
 			}
-
-			bool TargetLargeCargo = CargoHunt->GetInitData()->GetInt32("large-cargo") > 0;
-
-			if(TargetLargeCargo == (Spacecraft->GetSize() == EFlarePartSize::L))
-			{
-				return true;
-			}
-		}
-
-		UFlareQuestGeneratedMilitaryHunt2* MilitaryHunt = Cast<UFlareQuestGeneratedMilitaryHunt2>(OngoingQuest);
-		if(MilitaryHunt)
-		{
-			if(!Spacecraft->IsMilitary())
-			{
-				continue;
-			}
-
-			if(MilitaryHunt->GetInitData()->GetName("hostile-company") != Spacecraft->GetCompany()->GetIdentifier())
-			{
-				continue;
-			}
-
-			return true;
+			continue;
 		}
 	}
-	return false;
 }
 
 bool UFlareQuestManager::IsAllowedToDestroy(UFlareSimulatedSpacecraft const* Spacecraft)
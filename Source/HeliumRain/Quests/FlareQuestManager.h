@@ -9,6 +9,8 @@ class AFlareSpacecraft;
 class UFlareQuestGenerator;
 struct FFlareQuestDescription;
 class UFlareSimulatedSpacecraft;
+struct FFlareResourceDescription;
+struct FFlareHostilityMatrix;
 
 /** Quest action type */
 UENUM()
@@ -136,6 +138,47 @@ struct FFlareQuestSave
 };
 
 
+/** Cargo kept in a station for a quest, or space kept free in it */
+struct FFlareQuestReservation
+{
+	UFlareSimulatedSpacecraft*   Station;
+	FFlareResourceDescription*   Resource;
+	int32                        Quantity;
+	int32                        Capacity;
+
+	FFlareQuestReservation(UFlareSimulatedSpacecraft* ReservationStation, FFlareResourceDescription* ReservationResource, int32 ReservedQuantity, int32 ReservedCapacity)
+		: Station(ReservationStation)
+		, Resource(ReservationResource)
+		, Quantity(ReservedQuantity)
+		, Capacity(ReservedCapacity)
+	{
+	}
+};
+
+/** Station and resource of quest reservations */
+struct FFlareQuestReservationKey
+{
+	UFlareSimulatedSpacecraft*   Station;
+	FFlareResourceDescription*   Resource;
+
+	FFlareQuestReservationKey(UFlareSimulatedSpacecraft* KeyStation, FFlareResourceDescription* KeyResource)
+		: Station(KeyStation)
+		, Resource(KeyResource)
+	{
+	}
+
+	bool operator==(const FFlareQuestReservationKey& Other) const
+	{
+		return Station == Other.Station && Resource == Other.Resource;
+	}
+
+	friend uint32 GetTypeHash(const FFlareQuestReservationKey& Key)
+	{
+		return HashCombine(GetTypeHash(Key.Station), GetTypeHash(Key.Resource));
+	}
+};
+
+
 /** Quest system manager */
 UCLASS()
 class HELIUMRAIN_API UFlareQuestManager: public UObject
@@ -180,9 +223,11 @@ public:
 
 	void NotifyNewQuests(TArray<UFlareQuest*>& Quests);
 
-	int32 GetReservedCapacity(UFlareSimulatedSpacecraft* Station, FFlareResourceDescription* Resource);
+	/** Get the free space available and ongoing quests keep in a station */
+	int32 GetReservedCapacity(UFlareSimulatedSpacecraft* Station, FFlareResourceDescription* Resource) const;
 
-	int32 GetReservedQuantity(UFlareSimulatedSpacecraft* Station, FFlareResourceDescription* Resource);
+	/** Get the stock available and ongoing quests keep in a station */
+	int32 GetReservedQuantity(UFlareSimulatedSpacecraft* Station, FFlareResourceDescription* Resource) const;
 
    /*----------------------------------------------------
 	   Callback
@@ -232,6 +277,12 @@ public:
 
 protected:
 
+	/** Add or remove the reservations of a quest from the reservation index */
+	void UpdateReservations(UFlareQuest* Quest, bool Reserve);
+
+	/** Fill the reservation index from the available and ongoing quests */
+	void RebuildReservations();
+
    /*----------------------------------------------------
 	   Protected data
    ----------------------------------------------------*/
@@ -266,21 +317,10 @@ protected:
 
 	TArray<UFlareQuest*>					 NewQuestAccumulator;
 
-	struct IsUnderMilitaryContractCacheEntry
-	{
-		UFlareSimulatedSector const* Sector;
-		UFlareCompany const* Company;
-		float ExpireTime;
-	};
-
-	struct IsMilitaryTargetCacheEntry
-	{
-		UFlareSimulatedSpacecraft const* Spacecraft;
-		float ExpireTime;
-	};
+	/** Reservations of the available and ongoing quests, summed by station and resource */
+	TMap<FFlareQuestReservationKey, FFlareQuestReservation> Reservations;
 
-	TArray<IsUnderMilitaryContractCacheEntry> IsUnderMilitaryContractCache;
-	TArray<IsMilitaryTargetCacheEntry> IsMilitaryTargetCache;
+	TArray<FFlareQuestReservation>           ReservationBuffer;
 
 public:
 
@@ -339,13 +379,8 @@ public:
 
 	bool IsTradeQuestUseStation(UFlareSimulatedSpacecraft* Station);
 
-	bool IsUnderMilitaryContract(UFlareSimulatedSector* Sector,  UFlareCompany* Company, bool IncludeCache);
-
-	bool IsMilitaryTarget(UFlareSimulatedSpacecraft const* Spacecraft, bool IncludeCache);
-
-	bool IsUnderMilitaryContractNoCache(UFlareSimulatedSector* Sector,  UFlareCompany* Company);
-
-	bool IsMilitaryTargetNoCache(UFlareSimulatedSpacecraft const* Spacecraft);
+	/** Add the military contracts of the ongoing quests to the world hostility matrix */
+	void AddMilitaryContracts(FFlareHostilityMatrix& Matrix);
 
 	bool IsAllowedToDestroy(UFlareSimulatedSpacecraft const* Spacecraft);
 
@@ -26,10 +26,17 @@ bool PilotHelper::CheckFriendlyFire(UFlareSector* Sector, UFlareCompany* MyCompa
 {
 	SCOPE_CYCLE_COUNTER(STAT_PilotHelper_CheckFriendlyFire);
 
+	const FFlareSectorSpatialIndex& Index = Sector->GetSpatialIndex();
+
+	// A spacecraft the ammo reaches before MaxDelay can't be farther than the ammo and both spacecrafts travel in that time
+	float SearchRadius = (AmmoVelocity + FireBaseVelocity.Size() + Index.GetMaxSpeed()) * MaxDelay;
+	TArray<int32> Candidates;
+	Index.QueryRadius(FireBaseLocation, SearchRadius, EFlareSpatialEntry::Spacecraft, Candidates);
+
 	//FLOG("CheckFriendlyFire");
-	for (int32 SpacecraftIndex = 0; SpacecraftIndex < Sector->GetSpacecrafts().Num(); SpacecraftIndex++)
+	for (int32 CandidateIndex : Candidates)
 	{
-		AFlareSpacecraft* SpacecraftCandidate = Sector->GetSpacecrafts()[SpacecraftIndex];
+		AFlareSpacecraft* SpacecraftCandidate = Cast<AFlareSpacecraft>(Index.GetEntry(CandidateIndex).Actor);
 
 		if (SpacecraftCandidate)
 		{
@@ -88,58 +95,89 @@ bool PilotHelper::FindMostDangerousCollision(AActor*& MostDangerousCandidateActo
 	typedef TPair<AActor*, FVector> TFlareCollisionCandidate;
 
 	UFlareSector* ActiveSector = Ship->GetGame()->GetActiveSector();
+	const FFlareSectorSpatialIndex& Index = ActiveSector->GetSpatialIndex();
 	TArray<TFlareCollisionCandidate> Candidates;
 	TFlareCollisionCandidate Candidate;
 
-	// Select dangerous ships
-	for (auto SpacecraftCandidate : ActiveSector->GetSpacecrafts())
-	{
-		if (SpacecraftCandidate != Ship
-		 && SpacecraftCandidate != IgnoreConfig.SpacecraftToIgnore
-		 && !(IgnoreConfig.IgnoreAllStations && SpacecraftCandidate->IsStation())
-		 && !Ship->GetDockingSystem()->IsGrantedShip(SpacecraftCandidate)
-		 && !Ship->GetDockingSystem()->IsDockedShip(SpacecraftCandidate)
-		 && !(Ship->GetSize() == EFlarePartSize::L
-			  && SpacecraftCandidate->GetSize() == EFlarePartSize::S
-			  && IsTargetDangerous(PilotTarget(SpacecraftCandidate))
-			  && SpacecraftCandidate->IsHostile(Ship->GetCompany()))
-		&& !(IgnoreConfig.SpacecraftToIgnore && IgnoreConfig.SpacecraftToIgnore->IsStation() && IgnoreConfig.SpacecraftToIgnore->GetParent()->IsComplexElement() && SpacecraftCandidate->GetParent() == IgnoreConfig.SpacecraftToIgnore->GetParent()->GetComplexMaster())
-		&& !(IgnoreConfig.SpacecraftToIgnore && IgnoreConfig.SpacecraftToIgnore->IsStation() && IgnoreConfig.SpacecraftToIgnore->GetParent()->IsComplex() && SpacecraftCandidate->GetParent()->GetComplexMaster() == IgnoreConfig.SpacecraftToIgnore->GetParent())
-		)
-		{
-			Candidate.Key = SpacecraftCandidate;
-			Candidate.Value = SpacecraftCandidate->Airframe->GetPhysicsLinearVelocity();
-			Candidates.Add(Candidate);
-		}
-	}
+	// Input data for danger processing
+	FBox ShipBox = Ship->GetComponentsBoundingBox();
+	FVector CurrentVelocity = Ship->GetLinearVelocity() * 100;
+	FVector CurrentLocation = (ShipBox.Max + ShipBox.Min) / 2.0;
+	float CurrentSize = FMath::Max(ShipBox.GetExtent().Size(), 1.0f);
+	float MaxRelevanceDistance = 200 * CurrentSize;
 
-	// Select dangerous asteroids
-	for (auto AsteroidCandidate : ActiveSector->GetAsteroids())
-	{
-		Candidate.Key = AsteroidCandidate;
-		Candidate.Value = AsteroidCandidate->GetAsteroidComponent()->GetPhysicsLinearVelocity();
-		Candidates.Add(Candidate);
-	}
+	// Only bodies near the ship are relevant
+	TArray<int32> NearbyEntries;
+	Index.QueryRadius(CurrentLocation, MaxRelevanceDistance,
+		EFlareSpatialEntry::Spacecraft | EFlareSpatialEntry::Asteroid | EFlareSpatialEntry::Meteorite | EFlareSpatialEntry::Collider,
+		NearbyEntries);
 
-	// Select dangerous meteorites
-	for (auto MeteoriteCandidate : ActiveSector->GetMeteorites())
+	for (int32 EntryIndex : NearbyEntries)
 	{
-		if(!MeteoriteCandidate->IsBroken())
+		const FFlareSpatialEntry& Entry = Index.GetEntry(EntryIndex);
+
+		switch (Entry.Type)
 		{
-			Candidate.Key = MeteoriteCandidate;
-			Candidate.Value = MeteoriteCandidate->GetMeteoriteComponent()->GetPhysicsLinearVelocity();
-			Candidates.Add(Candidate);
-		}
-	}
+			// Select dangerous ships
+			case EFlareSpatialEntry::Spacecraft:
+			{
+				AFlareSpacecraft* SpacecraftCandidate = Cast<AFlareSpacecraft>(Entry.Actor);
+
+				if (SpacecraftCandidate != Ship
+				 && SpacecraftCandidate != IgnoreConfig.SpacecraftToIgnore
+				 && !(IgnoreConfig.IgnoreAllStations && SpacecraftCandidate->IsStation())
+				 && !Ship->GetDockingSystem()->IsGrantedShip(SpacecraftCandidate)
+				 && !Ship->GetDockingSystem()->IsDockedShip(SpacecraftCandidate)
+				 && !(Ship->GetSize() == EFlarePartSize::L
+					  && SpacecraftCandidate->GetSize() == EFlarePartSize::S
+					  && IsTargetDangerous(PilotTarget(SpacecraftCandidate))
+					  && SpacecraftCandidate->IsHostile(Ship->GetCompany()))
+				&& !(IgnoreConfig.SpacecraftToIgnore && IgnoreConfig.SpacecraftToIgnore->IsStation() && IgnoreConfig.SpacecraftToIgnore->GetParent()->IsComplexElement() && SpacecraftCandidate->GetParent() == IgnoreConfig.SpacecraftToIgnore->GetParent()->GetComplexMaster())
+				&& !(IgnoreConfig.SpacecraftToIgnore && IgnoreConfig.SpacecraftToIgnore->IsStation() && IgnoreConfig.SpacecraftToIgnore->GetParent()->IsComplex() && SpacecraftCandidate->GetParent()->GetComplexMaster() == IgnoreConfig.SpacecraftToIgnore->GetParent())
+				)
+				{
+					Candidate.Key = SpacecraftCandidate;
+					Candidate.Value = SpacecraftCandidate->Airframe->GetPhysicsLinearVelocity();
+					Candidates.Add(Candidate);
+				}
+				break;
+			}
 
-	// Select dangerous colliders
-	TArray<AActor*> ColliderActorList;
-	UGameplayStatics::GetAllActorsOfClass(Ship->GetWorld(), AFlareCollider::StaticClass(), ColliderActorList);
-	for (auto ColliderCandidate : ColliderActorList)
-	{
-		Candidate.Key = Cast<AFlareCollider>(ColliderCandidate);
-		Candidate.Value = FVector::ZeroVector;
-		Candidates.Add(Candidate);
+			// Select dangerous asteroids
+			case EFlareSpatialEntry::Asteroid:
+			{
+				AFlareAsteroid* AsteroidCandidate = Cast<AFlareAsteroid>(Entry.Actor);
+				Candidate.Key = AsteroidCandidate;
+				Candidate.Value = AsteroidCandidate->GetAsteroidComponent()->GetPhysicsLinearVelocity();
+				Candidates.Add(Candidate);
+				break;
+			}
+
+			// Select dangerous meteorites
+			case EFlareSpatialEntry::Meteorite:
+			{
+				AFlareMeteorite* MeteoriteCandidate = Cast<AFlareMeteorite>(Entry.Actor);
+				if (!MeteoriteCandidate->IsBroken())
+				{
+					Candidate.Key = MeteoriteCandidate;
+					Candidate.Value = MeteoriteCandidate->GetMeteoriteComponent()->GetPhysicsLinearVelocity();
+					Candidates.Add(Candidate);
+				}
+				break;
+			}
+
+			// Select dangerous colliders
+			case EFlareSpatialEntry::Collider:
+			{
+				Candidate.Key = Cast<AFlareCollider>(Entry.Actor);
+				Candidate.Value = FVector::ZeroVector;
+				Candidates.Add(Candidate);
+				break;
+			}
+
+			default:
+				break;
+		}
 	}
 
 	// No candidate found, return
@@ -148,13 +186,6 @@ bool PilotHelper::FindMostDangerousCollision(AActor*& MostDangerousCandidateActo
 		return false;
 	}
 
-	// Input data for danger processing
-	FBox ShipBox = Ship->GetComponentsBoundingBox();
-	FVector CurrentVelocity = Ship->GetLinearVelocity() * 100;
-	FVector CurrentLocation = (ShipBox.Max + ShipBox.Min) / 2.0;
-	float CurrentSize = FMath::Max(ShipBox.GetExtent().Size(), 1.0f);
-	float MaxRelevanceDistance = 200 * CurrentSize;
-
 	// Output data
 	MostDangerousCandidateActor = NULL;
 
@@ -341,10 +372,50 @@ PilotHelper::PilotTarget PilotHelper::GetBestTarget(AFlareSpacecraft* Ship, stru
 	PilotTarget BestTarget;
 	float BestScore = 0;
 
+	UFlareSector* ActiveSector = Ship->GetGame()->GetActiveSector();
+	const FFlareSectorSpatialIndex& Index = ActiveSector->GetSpatialIndex();
+
+	// Get the candidates that can score, in the sector order. Far away targets only score on alignement or attack target
+	auto GetCandidates = [&](int32 TypeMask, bool CanScoreOnAttackTarget, TArray<AActor*>& OutCandidates)
+	{
+		TArray<int32> Entries;
+		OutCandidates.Reset();
+
+		float PreferredDirectionSize = Preferences.PreferredDirection.Size();
+		float ConeAlignement = (PreferredDirectionSize > SMALL_NUMBER ? Preferences.MinAlignement / PreferredDirectionSize : Preferences.MinAlignement);
+
+		if (CanScoreOnAttackTarget || ConeAlignement <= -1)
+		{
+			Index.QueryType(TypeMask, Entries);
+		}
+		else
+		{
+			TArray<int32> AlignedEntries;
+			Index.QueryRadius(Preferences.BaseLocation, Preferences.MaxDistance, TypeMask, Entries);
+			Index.QueryCone(Preferences.BaseLocation, Preferences.PreferredDirection, ConeAlignement, TypeMask, AlignedEntries);
+
+			Entries.Append(AlignedEntries);
+			Entries.Sort();
+		}
+
+		for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); EntryIndex++)
+		{
+			if (EntryIndex == 0 || Entries[EntryIndex] != Entries[EntryIndex - 1])
+			{
+				OutCandidates.Add(Index.GetEntry(Entries[EntryIndex]).Actor);
+			}
+		}
+	};
+
 	//FLOGV("GetBestTarget for %s", *Ship->GetImmatriculation().ToString());
 
-	for (AFlareSpacecraft* ShipCandidate :Ship->GetGame()->GetActiveSector()->GetSpacecrafts())
+	TArray<AActor*> Candidates;
+	GetCandidates(EFlareSpatialEntry::Spacecraft, Preferences.AttackTarget && Preferences.AttackTargetWeight > 0, Candidates);
+
+	for (AActor* Candidate : Candidates)
 	{
+		AFlareSpacecraft* ShipCandidate = Cast<AFlareSpacecraft>(Candidate);
+
 		if (Preferences.IgnoreList.Contains(PilotTarget(ShipCandidate)))
 		{
 			continue;
@@ -454,12 +525,10 @@ PilotHelper::PilotTarget PilotHelper::GetBestTarget(AFlareSpacecraft* Ship, stru
 		}
 
 		// Divise by 25 the stateScore per current incoming missile
-		for (AFlareBomb* Bomb : Ship->GetGame()->GetActiveSector()->GetBombs())
+		int32 IncomingBombCount = ActiveSector->GetIncomingBombCount(ShipCandidate);
+		for (int32 BombIndex = 0; BombIndex < IncomingBombCount; BombIndex++)
 		{
-			if (Bomb->GetTargetSpacecraft() == ShipCandidate && Bomb->IsActive())
-			{
-				StateScore /= 25;
-			}
+			StateScore /= 25;
 		}
 
 		if(ShipCandidate->GetParent()->IsHarpooned()) {
@@ -534,8 +603,19 @@ PilotHelper::PilotTarget PilotHelper::GetBestTarget(AFlareSpacecraft* Ship, stru
 		}
 	}
 
-	for (AFlareBomb* BombCandidate :Ship->GetGame()->GetActiveSector()->GetBombs())
+	// Bombs beyond MaxBombDistance are never targeted
+	TArray<int32> BombEntries;
+	Index.QueryRadius(Preferences.BaseLocation, Preferences.MaxBombDistance, EFlareSpatialEntry::Bomb, BombEntries);
+	Candidates.Reset();
+	for (int32 EntryIndex : BombEntries)
+	{
+		Candidates.Add(Index.GetEntry(EntryIndex).Actor);
+	}
+
+	for (AActor* Candidate : Candidates)
 	{
+		AFlareBomb* BombCandidate = Cast<AFlareBomb>(Candidate);
+
 		if (Preferences.IgnoreList.Contains(PilotTarget(BombCandidate)))
 		{
 			continue;
@@ -648,8 +728,12 @@ PilotHelper::PilotTarget PilotHelper::GetBestTarget(AFlareSpacecraft* Ship, stru
 
 	}
 
-	for (AFlareMeteorite* MeteoriteCandidate :Ship->GetGame()->GetActiveSector()->GetMeteorites())
+	GetCandidates(EFlareSpatialEntry::Meteorite, false, Candidates);
+
+	for (AActor* Candidate : Candidates)
 	{
+		AFlareMeteorite* MeteoriteCandidate = Cast<AFlareMeteorite>(Candidate);
+
 		if (Preferences.IgnoreList.Contains(PilotTarget(MeteoriteCandidate)))
 		{
 			continue;
@@ -6,6 +6,7 @@
 
 #include "../Game/FlareGame.h"
 #include "../Game/FlareGameTypes.h"
+#include "../Game/FlareSector.h"
 #include "../Game/FlareSkirmishManager.h"
 
 #include "../Player/FlarePlayerController.h"
@@ -27,9 +28,11 @@ AFlareShell::AFlareShell(const class FObjectInitializer& PCIP) : Super(PCIP)
 
 	// Settings
 	FlightEffects = NULL;
-	PrimaryActorTick.bCanEverTick = true;
-	PrimaryActorTick.TickGroup = TG_PrePhysics;
+	PrimaryActorTick.bCanEverTick = false;
 	ManualTurret = false;
+	InFlight = false;
+	FlightDuration = 0;
+	ShellSystemIndex = INDEX_NONE;
 }
 
 
@@ -80,29 +83,23 @@ void AFlareShell::Initialize(UFlareWeapon* Weapon, const FFlareSpacecraftCompone
 			true);
 	}
 
-	SetLifeSpan(ShellDescription->WeaponCharacteristics.GunCharacteristics.AmmoRange * 100 / ShellVelocity.Size()); // 10km
-	ParentWeapon->GetSpacecraft()->GetGame()->GetActiveSector()->RegisterShell(this);
+	FlightDuration = ShellDescription->WeaponCharacteristics.GunCharacteristics.AmmoRange * 100 / ShellVelocity.Size(); // 10km
 	PC = ParentWeapon->GetSpacecraft()->GetGame()->GetPC();
+	ParentWeapon->GetSpacecraft()->GetGame()->GetActiveSector()->RegisterShell(this);
 
 	ManualTurret = ParentWeapon->GetSpacecraft()->GetWeaponsSystem()->GetActiveWeaponType() == EFlareWeaponGroupType::WG_TURRET;
 }
 
-void AFlareShell::Tick(float DeltaSeconds)
+void AFlareShell::UpdateFlight(FVector Location, FVector Velocity, float LifeRatio)
 {
-	Super::Tick(DeltaSeconds);
-	
-	FVector ActorLocation = GetActorLocation();
-	FVector NextActorLocation = ActorLocation + ShellVelocity * DeltaSeconds;
-	SetActorLocation(NextActorLocation, false);
-	SetActorRotation(ShellVelocity.Rotation());
+	SetActorLocation(Location, false);
+	SetActorRotation(Velocity.Rotation());
 	// 1 at 100m or less
 	float Scale = 1;
 	float BaseDistance = 10000.f;
 	float MinScale = 0.1f;
 	if(PC->GetShipPawn())
 	{
-		float LifeRatio = GetLifeSpan() / InitialLifeSpan;
-
 		float LifeRatioScale = 1.f;
 
 		if(LifeRatio < 0.1f)
@@ -110,7 +107,7 @@ void AFlareShell::Tick(float DeltaSeconds)
 			LifeRatioScale = LifeRatio * 10.f;
 		}
 
-		float Distance = (NextActorLocation - PC->GetShipPawn()->GetActorLocation()).Size();
+		float Distance = (Location - PC->GetShipPawn()->GetActorLocation()).Size();
 		if(Distance > BaseDistance)
 		{
 			Scale = (Distance / BaseDistance) * ((1.f-MinScale) * BaseDistance / Distance +MinScale) * LifeRatioScale;
@@ -118,44 +115,12 @@ void AFlareShell::Tick(float DeltaSeconds)
 	}
 
 	SetActorRelativeScale3D(FVector(0.6 + Scale * 0.4 , Scale, Scale));
-
-	if (ShellDescription)
-	{
-		FHitResult HitResult(ForceInit);
-
-		if (Trace(ActorLocation, NextActorLocation, HitResult))
-		{
-			OnImpact(HitResult, ShellVelocity);
-		}
-		
-		if (ShellDescription->WeaponCharacteristics.FuzeType == EFlareShellFuzeType::Proximity)
-		{
-			//FLOGV("%s SecureTime: %f ActiveTime: %f",*GetName(), SecureTime, ActiveTime);
-
-
-			if (SecureTime > 0)
-			{
-				SecureTime -= DeltaSeconds;
-			}
-			else if (ActiveTime > 0)
-			{
-				CheckFuze(ActorLocation, NextActorLocation);
-				ActiveTime -= DeltaSeconds;
-			}
-		}
-	}
 }
 
-
-
-
-
-
-void AFlareShell::CheckFuze(FVector ActorLocation, FVector NextActorLocation)
+void AFlareShell::CheckFuze(FVector ActorLocation, FVector NextActorLocation, const TArray<PilotHelper::PilotTarget>& Targets)
 {
 	FVector Center = (NextActorLocation + ActorLocation) / 2;
-	float NearThresoldSquared = FMath::Square(100000); // 1km
-	UFlareSector* Sector = ParentWeapon->GetSpacecraft()->GetGame()->GetActiveSector();
+	float NearThresoldSquared = FMath::Square(SHELL_FUZE_CHECK_DISTANCE); // 1km
 
 	auto CheckTarget = [&](PilotHelper::PilotTarget TargetCandidate)
 	{
@@ -267,18 +232,17 @@ void AFlareShell::CheckFuze(FVector ActorLocation, FVector NextActorLocation)
 		}
 	};
 
-	// Check targets against every actor in the level, using index-based, not for-range, because this can affect the container
-	for (int32 Index = 0; Index < Sector->GetSpacecrafts().Num(); Index++)
-	{
-		CheckTarget(PilotHelper::PilotTarget(Sector->GetSpacecrafts()[Index]));
-	}
-	for (int32 Index = 0; Index < Sector->GetBombs().Num(); Index++)
-	{
-		CheckTarget(PilotHelper::PilotTarget(Sector->GetBombs()[Index]));
-	}
-	for (int32 Index = 0; Index < Sector->GetMeteorites().Num(); Index++)
+	// The targets were gathered before, because a detonation can affect the sector lists
+	for (const PilotHelper::PilotTarget& Target : Targets)
 	{
-		CheckTarget(PilotHelper::PilotTarget(Sector->GetMeteorites()[Index]));
+		if (!InFlight)
+		{
+			break;
+		}
+		else if (IsValid(Target.GetActor()))
+		{
+			CheckTarget(Target);
+		}
 	}
 }
 
@@ -377,7 +341,7 @@ void AFlareShell::OnImpact(const FHitResult& HitResult, const FVector& HitVeloci
 
 	if (DestroyProjectile)
 	{
-		Destroy();
+		Recycle();
 	}
 }
 
@@ -531,7 +495,7 @@ void AFlareShell::DetonateAt(FVector DetonatePoint)
 		CheckTarget(PilotHelper::PilotTarget(Sector->GetMeteorites()[Index]));
 	}
 
-	Destroy();
+	Recycle();
 }
 
 float AFlareShell::ApplyDamage(AActor *ActorToDamage, UPrimitiveComponent* HitComponent, FVector ImpactLocation,  FVector ImpactAxis,  FVector ImpactNormal, float ImpactPower, float ImpactRadius, EFlareDamage::Type DamageType)
@@ -720,10 +684,42 @@ void AFlareShell::Destroyed()
 	}
 }
 
+void AFlareShell::Recycle()
+{
+	if (!InFlight)
+	{
+		return;
+	}
+
+	AFlareGame* Game = Cast<AFlareGame>(GetWorld()->GetAuthGameMode());
+	UFlareSector* Sector = (Game ? Game->GetActiveSector() : NULL);
+
+	if (Sector)
+	{
+		Sector->ReleaseShell(this);
+	}
+	else
+	{
+		Destroy();
+	}
+}
+
+void AFlareShell::SetPooled(bool Pooled)
+{
+	InFlight = !Pooled;
+	SetActorHiddenInGame(Pooled);
+	CustomTimeDilation = 1.0;
+
+	if (Pooled && FlightEffects)
+	{
+		FlightEffects->DestroyComponent();
+		FlightEffects = NULL;
+	}
+}
+
 void AFlareShell::SetFuzeTimer(float TargetSecureTime, float TargetActiveTime)
 {
-	SecureTime = TargetSecureTime;
-	ActiveTime = TargetActiveTime;
+	ParentWeapon->GetSpacecraft()->GetGame()->GetActiveSector()->GetShellSystem().SetFuzeTimer(this, TargetSecureTime, TargetActiveTime);
 }
 
 void AFlareShell::SetPause(bool Pause)
@@ -1,8 +1,12 @@
 #pragma once
 
 #include "FlareWeapon.h"
+#include "FlarePilotHelper.h"
 #include "FlareShell.generated.h"
 
+/** Distance below which proximity fuzes check a target, in cm */
+#define SHELL_FUZE_CHECK_DISTANCE 100000
+
 UCLASS(Blueprintable, ClassGroup = (Flare, Ship), meta = (BlueprintSpawnableComponent))
 class AFlareShell : public AActor
 {
@@ -10,6 +14,8 @@ public:
 
 	GENERATED_UCLASS_BODY()
 
+	friend struct FFlareShellSystem;
+
 public:
 
 	/*----------------------------------------------------
@@ -19,7 +25,8 @@ public:
 	/** Properties setup */
 	void Initialize(class UFlareWeapon* Weapon, const FFlareSpacecraftComponentDescription* Description, FVector ShootDirection, FVector ParentVelocity, bool Tracer);
 
-	virtual void Tick(float DeltaSeconds) override;
+	/** Move the shell along its path, LifeRatio is the remaining part of the flight */
+	void UpdateFlight(FVector Location, FVector Velocity, float LifeRatio);
 
 	virtual void SetPause(bool Pause);
 
@@ -35,9 +42,16 @@ public:
 
 	virtual void Destroyed() override;
 
+	/** Stop the shell and give it back to the sector pool */
+	virtual void Recycle();
+
+	/** Stop or restart the shell, for the sector pool */
+	void SetPooled(bool Pooled);
+
 	virtual void SetFuzeTimer(float TargetSecureTime, float TargetActiveTime);
 
-	virtual void CheckFuze(FVector ActorLocation, FVector NextActorLocation);
+	/** Detonate the proximity fuze near one of the targets */
+	virtual void CheckFuze(FVector ActorLocation, FVector NextActorLocation, const TArray<PilotHelper::PilotTarget>& Targets);
 
 protected:
 
@@ -70,6 +84,7 @@ protected:
 	UParticleSystem*                         FlightEffectsTemplate;
 
 	// Flight effects
+	UPROPERTY()
 	UParticleSystemComponent*                FlightEffects;
 
 	/** Burn mark decal */
@@ -87,8 +102,11 @@ protected:
 	bool                                           TracerShell;
 	bool                                           Armed;
 	float                                          MinEffectiveDistance;
-	float                                          SecureTime;
-	float                                          ActiveTime;
+	float                                          FlightDuration;
+	bool                                           InFlight;
+
+	/** Slot in the sector shell system, INDEX_NONE when not flying */
+	int32                                          ShellSystemIndex;
 
 	// References
 	class UFlareWeapon*                            ParentWeapon;
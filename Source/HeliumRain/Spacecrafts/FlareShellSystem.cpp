@@ -0,0 +1,294 @@
+
+#include "FlareShellSystem.h"
+#include "../Flare.h"
+
+#include "FlareShell.h"
+#include "FlareWeapon.h"
+#include "FlareSpacecraft.h"
+
+#include "../Game/FlareSector.h"
+
+
+DECLARE_CYCLE_STAT(TEXT("FlareShellSystem Tick"), STAT_FlareShellSystem_Tick, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareShellSystem Trace"), STAT_FlareShellSystem_Trace, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareShellSystem Fuze"), STAT_FlareShellSystem_Fuze, STATGROUP_Flare);
+
+
+/** Move an item of a shell state array, when compacting */
+template<typename T>
+static inline void MoveShellItem(TArray<T>& Array, int32 From, int32 To)
+{
+	Array[To] = Array[From];
+}
+
+
+/*----------------------------------------------------
+	Constructor
+----------------------------------------------------*/
+
+FFlareShellSystem::FFlareShellSystem()
+	: StoppedCount(0)
+	, Paused(false)
+{
+}
+
+
+/*----------------------------------------------------
+	Shells
+----------------------------------------------------*/
+
+void FFlareShellSystem::Reset()
+{
+	Shells.Empty();
+	Weapons.Empty();
+	Locations.Empty();
+	Velocities.Empty();
+	SecureTimes.Empty();
+	ActiveTimes.Empty();
+	RemainingTimes.Empty();
+	FlightDurations.Empty();
+	ProximityFuzes.Empty();
+	InFlight.Empty();
+
+	StoppedCount = 0;
+	Paused = false;
+}
+
+void FFlareShellSystem::Add(AFlareShell* Shell)
+{
+	if (Shell->ShellSystemIndex != INDEX_NONE)
+	{
+		return;
+	}
+
+	Shell->ShellSystemIndex = Shells.Num();
+
+	Shells.Add(Shell);
+	Weapons.Add(Shell->ParentWeapon);
+	Locations.Add(Shell->GetActorLocation());
+	Velocities.Add(Shell->ShellVelocity);
+	SecureTimes.Add(0);
+	ActiveTimes.Add(0);
+	RemainingTimes.Add(Shell->FlightDuration);
+	FlightDurations.Add(Shell->FlightDuration);
+	ProximityFuzes.Add(Shell->ShellDescription->WeaponCharacteristics.FuzeType == EFlareShellFuzeType::Proximity);
+	InFlight.Add(true);
+}
+
+void FFlareShellSystem::Remove(AFlareShell* Shell)
+{
+	int32 Index = Shell->ShellSystemIndex;
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	// Stopped shells are removed from the arrays at the end of the next tick
+	Shell->ShellSystemIndex = INDEX_NONE;
+	Shells[Index] = NULL;
+	InFlight[Index] = false;
+	StoppedCount++;
+}
+
+void FFlareShellSystem::SetFuzeTimer(AFlareShell* Shell, float SecureTime, float ActiveTime)
+{
+	int32 Index = Shell->ShellSystemIndex;
+	if (Index != INDEX_NONE)
+	{
+		SecureTimes[Index] = SecureTime;
+		ActiveTimes[Index] = ActiveTime;
+	}
+}
+
+void FFlareShellSystem::SetPause(bool Pause)
+{
+	Paused = Pause;
+}
+
+
+/*----------------------------------------------------
+	Simulation
+----------------------------------------------------*/
+
+void FFlareShellSystem::Tick(UFlareSector* Sector, float DeltaSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareShellSystem_Tick);
+
+	if (Paused || Shells.Num() == 0)
+	{
+		return;
+	}
+
+	// Shells fired during the tick start flying on the next one
+	int32 ShellCount = Shells.Num();
+
+	// Advance every shell
+	NextLocations.SetNumUninitialized(ShellCount, false);
+	for (int32 Index = 0; Index < ShellCount; Index++)
+	{
+		NextLocations[Index] = Locations[Index] + Velocities[Index] * DeltaSeconds;
+		RemainingTimes[Index] -= DeltaSeconds;
+	}
+
+	const FFlareSectorSpatialIndex& SpatialIndex = Sector->GetSpatialIndex();
+
+	for (int32 Index = 0; Index < ShellCount; Index++)
+	{
+		if (!InFlight[Index])
+		{
+			continue;
+		}
+
+		AFlareShell* Shell = Shells[Index];
+		AActor* Owner = Weapons[Index]->GetSpacecraft();
+		FVector ActorLocation = Locations[Index];
+		FVector NextActorLocation = NextLocations[Index];
+
+		Locations[Index] = NextActorLocation;
+		Shell->UpdateFlight(NextActorLocation, Velocities[Index], RemainingTimes[Index] / FlightDurations[Index]);
+
+		// Only trace when the path crosses a body, the owner is ignored by the trace anyway
+		SpatialIndex.QuerySegment(ActorLocation, NextActorLocation, EFlareSpatialEntry::All, Entries);
+
+		bool CandidateHit = false;
+		for (int32 EntryIndex : Entries)
+		{
+			if (SpatialIndex.GetEntry(EntryIndex).Actor != Owner)
+			{
+				CandidateHit = true;
+				break;
+			}
+		}
+
+		if (CandidateHit)
+		{
+			SCOPE_CYCLE_COUNTER(STAT_FlareShellSystem_Trace);
+
+			FHitResult HitResult(ForceInit);
+			if (Shell->Trace(ActorLocation, NextActorLocation, HitResult))
+			{
+				Shell->OnImpact(HitResult, Velocities[Index]);
+
+				// Ricochets change the path
+				if (InFlight[Index])
+				{
+					Locations[Index] = Shell->GetActorLocation();
+					Velocities[Index] = Shell->ShellVelocity;
+				}
+			}
+		}
+
+		// Proximity fuze
+		if (InFlight[Index] && ProximityFuzes[Index])
+		{
+			if (SecureTimes[Index] > 0)
+			{
+				SecureTimes[Index] -= DeltaSeconds;
+			}
+			else if (ActiveTimes[Index] > 0)
+			{
+				SCOPE_CYCLE_COUNTER(STAT_FlareShellSystem_Fuze);
+
+				GetFuzeTargets(Sector, (ActorLocation + NextActorLocation) / 2, Owner, FuzeTargets);
+				if (FuzeTargets.Num() > 0)
+				{
+					Shell->CheckFuze(ActorLocation, NextActorLocation, FuzeTargets);
+				}
+				ActiveTimes[Index] -= DeltaSeconds;
+			}
+		}
+
+		// Out of range
+		if (InFlight[Index] && RemainingTimes[Index] <= 0)
+		{
+			Shell->Recycle();
+		}
+	}
+
+	if (StoppedCount > 0)
+	{
+		Compact();
+	}
+}
+
+
+/*----------------------------------------------------
+	Internal
+----------------------------------------------------*/
+
+void FFlareShellSystem::Compact()
+{
+	int32 WriteIndex = 0;
+
+	for (int32 ReadIndex = 0; ReadIndex < Shells.Num(); ReadIndex++)
+	{
+		if (!InFlight[ReadIndex])
+		{
+			continue;
+		}
+
+		if (ReadIndex != WriteIndex)
+		{
+			MoveShellItem(Shells, ReadIndex, WriteIndex);
+			MoveShellItem(Weapons, ReadIndex, WriteIndex);
+			MoveShellItem(Locations, ReadIndex, WriteIndex);
+			MoveShellItem(Velocities, ReadIndex, WriteIndex);
+			MoveShellItem(SecureTimes, ReadIndex, WriteIndex);
+			MoveShellItem(ActiveTimes, ReadIndex, WriteIndex);
+			MoveShellItem(RemainingTimes, ReadIndex, WriteIndex);
+			MoveShellItem(FlightDurations, ReadIndex, WriteIndex);
+			MoveShellItem(ProximityFuzes, ReadIndex, WriteIndex);
+			MoveShellItem(InFlight, ReadIndex, WriteIndex);
+			Shells[WriteIndex]->ShellSystemIndex = WriteIndex;
+		}
+
+		WriteIndex++;
+	}
+
+	Shells.SetNum(WriteIndex, false);
+	Weapons.SetNum(WriteIndex, false);
+	Locations.SetNum(WriteIndex, false);
+	Velocities.SetNum(WriteIndex, false);
+	SecureTimes.SetNum(WriteIndex, false);
+	ActiveTimes.SetNum(WriteIndex, false);
+	RemainingTimes.SetNum(WriteIndex, false);
+	FlightDurations.SetNum(WriteIndex, false);
+	ProximityFuzes.SetNum(WriteIndex, false);
+	InFlight.SetNum(WriteIndex, false);
+
+	StoppedCount = 0;
+}
+
+void FFlareShellSystem::GetFuzeTargets(UFlareSector* Sector, FVector Center, AActor* Owner, TArray<PilotHelper::PilotTarget>& OutTargets)
+{
+	const FFlareSectorSpatialIndex& SpatialIndex = Sector->GetSpatialIndex();
+	OutTargets.Reset();
+
+	SpatialIndex.QueryRadius(Center, SHELL_FUZE_CHECK_DISTANCE, EFlareSpatialEntry::Spacecraft | EFlareSpatialEntry::Bomb | EFlareSpatialEntry::Meteorite, Entries);
+
+	// Targets are listed by type, in the order the fuze used to check them
+	for (EFlareSpatialEntry::Type Type : { EFlareSpatialEntry::Spacecraft, EFlareSpatialEntry::Bomb, EFlareSpatialEntry::Meteorite })
+	{
+		for (int32 EntryIndex : Entries)
+		{
+			const FFlareSpatialEntry& Entry = SpatialIndex.GetEntry(EntryIndex);
+
+			if (Entry.Actor == Owner || Entry.Type != Type)
+			{
+				continue;
+			}
+			else if (Type == EFlareSpatialEntry::Spacecraft)
+			{
+				OutTargets.Add(PilotHelper::PilotTarget(Cast<AFlareSpacecraft>(Entry.Actor)));
+			}
+			else if (Type == EFlareSpatialEntry::Bomb)
+			{
+				OutTargets.Add(PilotHelper::PilotTarget(Cast<AFlareBomb>(Entry.Actor)));
+			}
+			else
+			{
+				OutTargets.Add(PilotHelper::PilotTarget(Cast<AFlareMeteorite>(Entry.Actor)));
+			}
+		}
+	}
+}
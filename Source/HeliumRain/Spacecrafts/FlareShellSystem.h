@@ -0,0 +1,88 @@
+#pragma once
+
+#include "Object.h"
+#include "FlarePilotHelper.h"
+
+
+class AFlareShell;
+class UFlareWeapon;
+class UFlareSector;
+
+
+/** Flight of the shells of the active sector.
+ * The shell state is kept in arrays and every shell is advanced in one pass. Shells only trace against the world
+ * when their path crosses a body of the sector spatial index, and proximity fuzes only check the targets near their path. */
+struct FFlareShellSystem
+{
+public:
+
+	FFlareShellSystem();
+
+	/** Forget all shells */
+	void Reset();
+
+	/** Start the flight of an initialized shell */
+	void Add(AFlareShell* Shell);
+
+	/** Stop the flight of a shell */
+	void Remove(AFlareShell* Shell);
+
+	/** Set the proximity fuze delays of a shell in flight */
+	void SetFuzeTimer(AFlareShell* Shell, float SecureTime, float ActiveTime);
+
+	void SetPause(bool Pause);
+
+	/** Advance all shells */
+	void Tick(UFlareSector* Sector, float DeltaSeconds);
+
+
+protected:
+
+	/*----------------------------------------------------
+		Internal
+	----------------------------------------------------*/
+
+	/** Remove the stopped shells from the arrays */
+	void Compact();
+
+	/** Get the proximity fuze targets near a shell path */
+	void GetFuzeTargets(UFlareSector* Sector, FVector Center, AActor* Owner, TArray<PilotHelper::PilotTarget>& OutTargets);
+
+
+	/*----------------------------------------------------
+		Data
+	----------------------------------------------------*/
+
+	// Shell state, one item per shell
+	TArray<AFlareShell*>                    Shells;
+	TArray<UFlareWeapon*>                   Weapons;
+	TArray<FVector>                         Locations;
+	TArray<FVector>                         Velocities;
+	TArray<float>                           SecureTimes;
+	TArray<float>                           ActiveTimes;
+	TArray<float>                           RemainingTimes;
+	TArray<float>                           FlightDurations;
+	TArray<bool>                            ProximityFuzes;
+	TArray<bool>                            InFlight;
+
+	// Buffers reused between ticks
+	TArray<FVector>                         NextLocations;
+	TArray<int32>                           Entries;
+	TArray<PilotHelper::PilotTarget>        FuzeTargets;
+
+	int32                                   StoppedCount;
+	bool                                    Paused;
+
+
+public:
+
+	/*----------------------------------------------------
+		Getters
+	----------------------------------------------------*/
+
+	inline int32 GetShellCount() const
+	{
+		return Shells.Num() - StoppedCount;
+	}
+
+};
@@ -906,6 +906,11 @@ void UFlareSimulatedSpacecraft::SetIntercepted(bool Intercepted)
 void UFlareSimulatedSpacecraft::SetReserve(bool InReserve)
 {
 	SpacecraftData.IsReserve = InReserve;
+
+	if (GetCurrentSector())
+	{
+		GetCurrentSector()->InvalidateBattleState();
+	}
 }
 
 
@@ -1126,6 +1131,11 @@ void UFlareSimulatedSpacecraft::RemoveCapturePoint(FName CompanyIdentifier, int3
 		{
 			SpacecraftData.CapturePoints[CompanyIdentifier] = CurrentCapturePoint - CapturePoint;
 		}
+
+		if (GetCurrentSector())
+		{
+			GetCurrentSector()->InvalidateBattleState();
+		}
 	}
 }
 
@@ -1176,6 +1186,11 @@ bool UFlareSimulatedSpacecraft::TryCapture(UFlareCompany* OtherCompany, int32 Ca
 		SpacecraftData.CapturePoints.Add(CompanyIdentifier, CurrentCapturePoint);
 	}
 
+	if (GetCurrentSector())
+	{
+		GetCurrentSector()->InvalidateBattleState();
+	}
+
 	if (CurrentCapturePoint > GetCapturePointThreshold())
 	{
 		// Can be captured
@@ -2438,13 +2453,16 @@ bool UFlareSimulatedSpacecraft::IsHostile(UFlareCompany* OtherCompany, bool UseC
 		return false;
 	}
 
+	// Military contracts of the player, sticky for the rest of the day when UseCache is set
+	const FFlareHostilityMatrix& HostilityMatrix = Game->GetGameWorld()->GetHostilityMatrix();
+	int32 SectorIndex = GetCurrentSector() ? GetCurrentSector()->GetWorldIndex() : INDEX_NONE;
 
 	if(GetCompany()->IsPlayerCompany())
 	{
 		// Is player ship hostile ?
 
-		if (IsMilitary() && Game->GetQuestManager()
-				&& Game->GetQuestManager()->IsUnderMilitaryContract(GetCurrentSector(), OtherCompany, UseCache)
+		if (IsMilitary()
+				&& HostilityMatrix.HasSectorContract(OtherCompany->GetWorldIndex(), SectorIndex, UseCache)
 				&& !GetDamageSystem()->IsDisarmed() && !GetDamageSystem()->IsUncontrollable())
 		{
 			return true;
@@ -2453,19 +2471,20 @@ bool UFlareSimulatedSpacecraft::IsHostile(UFlareCompany* OtherCompany, bool UseC
 	else if (OtherCompany->IsPlayerCompany())
 	{
 		// Is non player ship hostile to player ?
-		if(IsMilitary() && Game->GetQuestManager() &&
-			Game->GetQuestManager()->IsUnderMilitaryContract(GetCurrentSector(), GetCompany(), UseCache))
+		int32 CompanyIndex = GetCompany()->GetWorldIndex();
+
+		if(IsMilitary() && HostilityMatrix.HasSectorContract(CompanyIndex, SectorIndex, UseCache))
 		{
 			return true;
 		}
 
-		if(Game->GetQuestManager() && Game->GetQuestManager()->IsMilitaryTarget(this, UseCache))
+		if(HostilityMatrix.IsHuntTarget(CompanyIndex, FFlareHostilityMatrix::GetHuntContractType(IsMilitary(), GetSize() == EFlarePartSize::L), UseCache))
 		{
 			return true;
 		}
 	}
 
-	return GetCompany()->GetWarState(OtherCompany) == EFlareHostility::Hostile;
+	return Game->GetGameWorld()->IsAtWar(GetCompany(), OtherCompany);
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -2193,10 +2193,7 @@ float AFlareSpacecraft::GetTimeToStop() const
 	{
 		FVector CurrentVelocityAxis = CurrentVelocity.GetUnsafeNormal();
 
-		// TODO Cache
-		TArray<UActorComponent*> Engines = GetComponentsByClass(UFlareEngine::StaticClass());
-
-		FVector Acceleration = GetNavigationSystem()->GetTotalMaxThrustInAxis(Engines, CurrentVelocityAxis, false) / GetSpacecraftMass();
+		FVector Acceleration = GetNavigationSystem()->GetTotalMaxThrustInAxis(CurrentVelocityAxis, false) / GetSpacecraftMass();
 		float AccelerationInAngleAxis =  FMath::Abs(FVector::DotProduct(Acceleration, CurrentVelocityAxis));
 
 		TimeToStopCache = (CurrentVelocity.Size() / (AccelerationInAngleAxis));
@@ -315,12 +315,8 @@ bool UFlareWeapon::FireGun(int GunIndex)
 	FVector FiringDirection = FMath::VRandCone(FiringAxis, Imprecision);
 	FVector FiringVelocity = Spacecraft->Airframe->GetPhysicsLinearVelocity();
 
-	// Create a shell
-	AFlareShell* Shell = GetWorld()->SpawnActor<AFlareShell>(
-		AFlareShell::StaticClass(),
-		FiringLocation,
-		FRotator::ZeroRotator,
-		ProjectileSpawnParams);
+	// Get a shell from the sector pool
+	AFlareShell* Shell = Spacecraft->GetGame()->GetActiveSector()->AcquireShell(FiringLocation, ProjectileSpawnParams);
 
 	// Fire it. Tracer ammo every bullets
 	Shell->Initialize(this, ComponentDescription, FiringDirection, FiringVelocity, true);
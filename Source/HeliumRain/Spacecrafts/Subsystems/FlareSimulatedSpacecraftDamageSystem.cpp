@@ -353,13 +353,36 @@ float UFlareSimulatedSpacecraftDamageSystem::Refill(FFlareSpacecraftComponentDes
 float UFlareSimulatedSpacecraftDamageSystem::ApplyDamage(FFlareSpacecraftComponentDescription* ComponentDescription,
 						  FFlareSpacecraftComponentSave* ComponentData,
 						  float Energy, EFlareDamage::Type DamageType, UFlareSimulatedSpacecraft* DamageSource)
+{
+	FFlareComponentDamage Damage;
+	float InflictedDamageRatio = DamageComponent(ComponentDescription, ComponentData, Energy, DamageType, DamageSource, Damage);
+
+	if (Damage.EffectiveEnergy > 0)
+	{
+		ApplyDamageConsequences(Damage);
+	}
+
+	return InflictedDamageRatio;
+}
+
+float UFlareSimulatedSpacecraftDamageSystem::DamageComponent(FFlareSpacecraftComponentDescription* ComponentDescription,
+						  FFlareSpacecraftComponentSave* ComponentData,
+						  float Energy, EFlareDamage::Type DamageType, UFlareSimulatedSpacecraft* DamageSource,
+						  FFlareComponentDamage& OutDamage)
 {
 	SCOPE_CYCLE_COUNTER(STAT_FlareSimulatedDamageSystem_ApplyDamage);
 
-	float InflictedDamageRatio = 0;
+	OutDamage.ComponentDescription = ComponentDescription;
+	OutDamage.ComponentData = ComponentData;
+	OutDamage.DamageSource = DamageSource;
+	OutDamage.DamageType = DamageType;
+	OutDamage.Energy = Energy;
+	OutDamage.EffectiveEnergy = 0;
 
 	// Apply damage
 	float StateBeforeDamage = GetDamageRatio(ComponentDescription, ComponentData);
+	OutDamage.StateBeforeDamage = StateBeforeDamage;
+	OutDamage.StateAfterDamage = StateBeforeDamage;
 
 	if (StateBeforeDamage == 0)
 	{
@@ -393,85 +416,92 @@ float UFlareSimulatedSpacecraftDamageSystem::ApplyDamage(FFlareSpacecraftCompone
 		ComponentData->Damage = MaxHitPoints;
 	}
 	float StateAfterDamage = GetDamageRatio(ComponentDescription, ComponentData);
-	InflictedDamageRatio = StateBeforeDamage - StateAfterDamage;
 	SetDamageDirty(ComponentDescription);
 
-	if (EffectiveEnergy > 0)
+	OutDamage.EffectiveEnergy = EffectiveEnergy;
+	OutDamage.StateAfterDamage = StateAfterDamage;
+
+	LastDamageCause = DamageCause(DamageSource, DamageType);
+
+	return StateBeforeDamage - StateAfterDamage;
+}
+
+void UFlareSimulatedSpacecraftDamageSystem::ApplyDamageConsequences(const FFlareComponentDamage& Damage)
+{
+	UFlareSimulatedSpacecraft* DamageSource = Damage.DamageSource;
+	EFlareDamage::Type DamageType = Damage.DamageType;
+	float EffectiveEnergy = Damage.EffectiveEnergy;
+	float InflictedDamageRatio = Damage.StateBeforeDamage - Damage.StateAfterDamage;
+
+	CombatLog::SpacecraftComponentDamaged(Spacecraft, Damage.ComponentData, Damage.ComponentDescription, Damage.Energy, EffectiveEnergy, DamageType, Damage.StateBeforeDamage, Damage.StateAfterDamage);
+
+	// This ship has been damaged and someone is to blame
+	if (DamageSource != NULL && DamageSource->GetCompany() != Spacecraft->GetCompany())
 	{
-		CombatLog::SpacecraftComponentDamaged(Spacecraft, ComponentData, ComponentDescription, Energy, EffectiveEnergy, DamageType, StateBeforeDamage, StateAfterDamage);
+		UFlareCompany* PlayerCompany = Spacecraft->GetGame()->GetPC()->GetCompany();
+		float ReputationCost = 0.f;
 
-		// This ship has been damaged and someone is to blame
-		if (DamageSource != NULL && DamageSource->GetCompany() != Spacecraft->GetCompany())
+		if (Spacecraft->IsStation())
 		{
-			UFlareCompany* PlayerCompany = Spacecraft->GetGame()->GetPC()->GetCompany();
-			float ReputationCost = 0.f;
-
-			if (Spacecraft->IsStation())
+			if(DamageType != EFlareDamage::DAM_Collision)
 			{
-				if(DamageType != EFlareDamage::DAM_Collision)
-				{
-					ReputationCost = -InflictedDamageRatio * 100;
-				}
-				// Retaliation
-				if(DamageSource->GetCompany() == PlayerCompany)
-				{
-					PlayerCompany->AddRetaliation(EffectiveEnergy);
-				}
-				else if(Spacecraft->GetCompany() == PlayerCompany)
-				{
-					PlayerCompany->RemoveRetaliation(EffectiveEnergy);
-				}
+				ReputationCost = -InflictedDamageRatio * 100;
 			}
-			else
+			// Retaliation
+			if(DamageSource->GetCompany() == PlayerCompany)
 			{
-				ReputationCost = -InflictedDamageRatio * 2;
+				PlayerCompany->AddRetaliation(EffectiveEnergy);
 			}
+			else if(Spacecraft->GetCompany() == PlayerCompany)
+			{
+				PlayerCompany->RemoveRetaliation(EffectiveEnergy);
+			}
+		}
+		else
+		{
+			ReputationCost = -InflictedDamageRatio * 2;
+		}
 
 
-			if (ReputationCost != 0
-				&& DamageSource->IsResponsible(DamageType)
-				&& !Spacecraft->GetGame()->IsSkirmish()
-				&& Spacecraft->GetCompany() != PlayerCompany
-				&& Spacecraft->GetCompany() != Spacecraft->GetGame()->GetScenarioTools()->Pirates)
+		if (ReputationCost != 0
+			&& DamageSource->IsResponsible(DamageType)
+			&& !Spacecraft->GetGame()->IsSkirmish()
+			&& Spacecraft->GetCompany() != PlayerCompany
+			&& Spacecraft->GetCompany() != Spacecraft->GetGame()->GetScenarioTools()->Pirates)
+		{
+			// Being shot by enemies is pretty much expected
+			if (!Spacecraft->IsHostile(DamageSource->GetCompany(), true))
 			{
-				// Being shot by enemies is pretty much expected
-				if (!Spacecraft->IsHostile(DamageSource->GetCompany(), true))
-				{
-					// If it's a betrayal, lower attacker's reputation on everyone, give rep to victim
+				// If it's a betrayal, lower attacker's reputation on everyone, give rep to victim
 
-					// Lower attacker's reputation on victim
-					Spacecraft->GetCompany()->GivePlayerReputationToOthers(ReputationCost/2);
-					Spacecraft->GetCompany()->GivePlayerReputation(ReputationCost);
+				// Lower attacker's reputation on victim
+				Spacecraft->GetCompany()->GivePlayerReputationToOthers(ReputationCost/2);
+				Spacecraft->GetCompany()->GivePlayerReputation(ReputationCost);
 
-					Spacecraft->GetGame()->GetPC()->Notify(LOCTEXT("NeutralAttack", "Neutrality violation"),
-						   FText::Format(LOCTEXT("NeutralAttackDescription", "Attacking neutral properties ({0}) will have diplomatic consequences."), UFlareGameTools::DisplaySpacecraftName(Spacecraft)),
-						   FName("neutrality-violation"),
-						   EFlareNotification::NT_Military);
+				Spacecraft->GetGame()->GetPC()->Notify(LOCTEXT("NeutralAttack", "Neutrality violation"),
+					   FText::Format(LOCTEXT("NeutralAttackDescription", "Attacking neutral properties ({0}) will have diplomatic consequences."), UFlareGameTools::DisplaySpacecraftName(Spacecraft)),
+					   FName("neutrality-violation"),
+					   EFlareNotification::NT_Military);
 
 
-				}
-				else if(Spacecraft->IsActive() && Spacecraft->GetActive()->GetTimeSinceUncontrollable() > 5.f && !Spacecraft->GetGame()->GetQuestManager()->IsAllowedToDestroy(Spacecraft))
-				{
-					// If an attack on a prisoner, lower attacker's reputation on everyone, give rep to victim
+			}
+			else if(Spacecraft->IsActive() && Spacecraft->GetActive()->GetTimeSinceUncontrollable() > 5.f && !Spacecraft->GetGame()->GetQuestManager()->IsAllowedToDestroy(Spacecraft))
+			{
+				// If an attack on a prisoner, lower attacker's reputation on everyone, give rep to victim
 
-					// Lower attacker's reputation on victim
-					Spacecraft->GetCompany()->GivePlayerReputationToOthers(ReputationCost/5);
-					Spacecraft->GetCompany()->GivePlayerReputation(ReputationCost/5);
+				// Lower attacker's reputation on victim
+				Spacecraft->GetCompany()->GivePlayerReputationToOthers(ReputationCost/5);
+				Spacecraft->GetCompany()->GivePlayerReputation(ReputationCost/5);
 
-					Spacecraft->GetGame()->GetPC()->Notify(LOCTEXT("PrisonerAttack", "Attacking prisoners"),
-						   FText::Format(LOCTEXT("PrisonerAttackDescription", "Attacking uncontrollable ships ({0}) will have diplomatic consequences."), UFlareGameTools::DisplaySpacecraftName(Spacecraft)),
-						   FName("prisoner-attack"),
-						   EFlareNotification::NT_Military);
-				}
+				Spacecraft->GetGame()->GetPC()->Notify(LOCTEXT("PrisonerAttack", "Attacking prisoners"),
+					   FText::Format(LOCTEXT("PrisonerAttackDescription", "Attacking uncontrollable ships ({0}) will have diplomatic consequences."), UFlareGameTools::DisplaySpacecraftName(Spacecraft)),
+					   FName("prisoner-attack"),
+					   EFlareNotification::NT_Military);
 			}
 		}
-
-		Spacecraft->GetCompany()->InvalidateCompanyValueCache();
 	}
 
-	LastDamageCause = DamageCause(DamageSource, DamageType);
-
-	return InflictedDamageRatio;
+	Spacecraft->GetCompany()->InvalidateCompanyValueCache();
 }
 
 float UFlareSimulatedSpacecraftDamageSystem::GetTemperature() const
@@ -710,11 +740,21 @@ void UFlareSimulatedSpacecraftDamageSystem::SetDamageDirty(FFlareSpacecraftCompo
 	{
 		SetPowerDirty();
 	}
+
+	if (Spacecraft->GetCurrentSector())
+	{
+		Spacecraft->GetCurrentSector()->InvalidateBattleState();
+	}
 }
 
 void UFlareSimulatedSpacecraftDamageSystem::SetAmmoDirty()
 {
 	AmmoDirty = true;
+
+	if (Spacecraft->GetCurrentSector())
+	{
+		Spacecraft->GetCurrentSector()->InvalidateBattleState();
+	}
 }
 
 bool UFlareSimulatedSpacecraftDamageSystem::IsPowered(FFlareSpacecraftComponentSave* ComponentToPowerData) const
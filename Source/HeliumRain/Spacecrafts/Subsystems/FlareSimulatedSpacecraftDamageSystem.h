@@ -32,6 +32,20 @@ class UFlareCompany;
 class UFlareSimulatedSpacecraft;
 
 
+/** Damage done to a component, kept to apply its consequences on the companies later */
+struct FFlareComponentDamage
+{
+	FFlareSpacecraftComponentDescription* ComponentDescription;
+	FFlareSpacecraftComponentSave* ComponentData;
+	UFlareSimulatedSpacecraft* DamageSource;
+	EFlareDamage::Type DamageType;
+	float Energy;
+	float EffectiveEnergy;
+	float StateBeforeDamage;
+	float StateAfterDamage;
+};
+
+
 /** Spacecraft damage system class */
 UCLASS()
 class HELIUMRAIN_API UFlareSimulatedSpacecraftDamageSystem : public UObject
@@ -113,6 +127,15 @@ public:
 	virtual float ApplyDamage(FFlareSpacecraftComponentDescription* ComponentDescription,
 							  FFlareSpacecraftComponentSave* ComponentData,
 							  float Energy, EFlareDamage::Type DamageType, UFlareSimulatedSpacecraft* DamageSource);
+
+	/** Apply damage to this component, without the log, reputation and retaliation changes. Return inflicted damage ratio */
+	float DamageComponent(FFlareSpacecraftComponentDescription* ComponentDescription,
+						  FFlareSpacecraftComponentSave* ComponentData,
+						  float Energy, EFlareDamage::Type DamageType, UFlareSimulatedSpacecraft* DamageSource,
+						  FFlareComponentDamage& OutDamage);
+
+	/** Log a component damage and apply its consequences on the companies */
+	void ApplyDamageConsequences(const FFlareComponentDamage& Damage);
 	
 	bool IsPowered(FFlareSpacecraftComponentSave* ComponentToPowerData) const;
 
@@ -830,6 +830,9 @@ void UFlareSpacecraftDamageSystem::ApplyDamage(float Energy, float Radius, FVect
 	// Update power
 	UpdatePower();
 
+	// Engine thrust changed
+	Spacecraft->GetNavigationSystem()->InvalidateEngineTable();
+
 	// Heat the ship
 	Data->Heat += Energy;
 
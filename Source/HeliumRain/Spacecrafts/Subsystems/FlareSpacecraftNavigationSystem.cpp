@@ -23,6 +23,7 @@ DECLARE_CYCLE_STAT(TEXT("FlareNavigationSystem UpdateAngularAttitudeAuto"), STAT
 DECLARE_CYCLE_STAT(TEXT("FlareNavigationSystem GetAngularVelocityToAlignAxis"), STAT_NavigationSystem_GetAngularVelocityToAlignAxis, STATGROUP_Flare);
 DECLARE_CYCLE_STAT(TEXT("FlareNavigationSystem GetTotalMaxThrustInAxis"), STAT_NavigationSystem_GetTotalMaxThrustInAxis, STATGROUP_Flare);
 DECLARE_CYCLE_STAT(TEXT("FlareNavigationSystem GetTotalMaxTorqueInAxis"), STAT_NavigationSystem_GetTotalMaxTorqueInAxis, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareNavigationSystem UpdateEngineTable"), STAT_NavigationSystem_UpdateEngineTable, STATGROUP_Flare);
 
 #define LOCTEXT_NAMESPACE "FlareSpacecraftNavigationSystem"
 
@@ -43,6 +44,8 @@ UFlareSpacecraftNavigationSystem::UFlareSpacecraftNavigationSystem(const class F
 {
 	AnticollisionAngle = FMath::FRandRange(0, 360);
 	DockConstraint = NULL;
+	EngineTable.Frame = 0;
+	EngineTable.Dirty = true;
 }
 
 
@@ -148,11 +151,15 @@ void UFlareSpacecraftNavigationSystem::Initialize(AFlareSpacecraft* OwnerSpacecr
 	XEngines.Value.Empty();
 	YEngines.Value.Empty();
 	ZEngines.Value.Empty();
+	EngineTable.Engines.Empty();
+	EngineTable.OrbitalEngines.Empty();
 
 	TArray<UActorComponent*> Engines = Spacecraft->GetComponentsByClass(UFlareEngine::StaticClass());
 	for (int32 EngineIndex = 0; EngineIndex < Engines.Num(); EngineIndex++)
 	{
 		UFlareEngine* Engine = Cast<UFlareEngine>(Engines[EngineIndex]);
+		EngineTable.Engines.Add(Engine);
+		EngineTable.OrbitalEngines.Add(Engine->IsA(UFlareOrbitalEngine::StaticClass()));
 
 		FVector LocalThrustAxis = Spacecraft->Airframe->GetComponentToWorld().Inverse().GetRotation().RotateVector(Engine->GetThrustAxis());
 
@@ -197,6 +204,16 @@ void UFlareSpacecraftNavigationSystem::Initialize(AFlareSpacecraft* OwnerSpacecr
 			FLOGV("WARNING: engine #%d for %s as %d axis match", EngineIndex, *Spacecraft->GetImmatriculation().ToString(), MatchCount);
 		}
 	}
+
+	// Per-frame values
+	int32 EngineCount = EngineTable.Engines.Num();
+	EngineTable.InitialMaxThrusts.SetNumZeroed(EngineCount);
+	EngineTable.ThrustAxes.SetNumZeroed(EngineCount);
+	EngineTable.TorqueDirections.SetNumZeroed(EngineCount);
+	EngineTable.TorqueArms.SetNumZeroed(EngineCount);
+	EngineTable.MaxThrusts.SetNumZeroed(EngineCount);
+	EngineTable.Alphas.SetNumZeroed(EngineCount);
+	InvalidateEngineTable();
 }
 
 void UFlareSpacecraftNavigationSystem::Start()
@@ -904,10 +921,8 @@ void UFlareSpacecraftNavigationSystem::ConfirmDock(AFlareSpacecraft* DockStation
 	DockConstraint->SetConstrainedComponents(Spacecraft->Airframe, NAME_None, AttachStation->Airframe,NAME_None);
 
 	// Cut engines
-	TArray<UActorComponent*> Engines = Spacecraft->GetComponentsByClass(UFlareEngine::StaticClass());
-	for (int32 EngineIndex = 0; EngineIndex < Engines.Num(); EngineIndex++)
+	for (UFlareEngine* Engine : EngineTable.Engines)
 	{
-		UFlareEngine* Engine = Cast<UFlareEngine>(Engines[EngineIndex]);
 		Engine->SetAlpha(0.0f);
 	}
 
@@ -1102,8 +1117,6 @@ bool UFlareSpacecraftNavigationSystem::UpdateLinearAttitudeAuto(float DeltaSecon
 {
 	SCOPE_CYCLE_COUNTER(STAT_NavigationSystem_UpdateLinearAttitudeAuto);
 
-	TArray<UActorComponent*> Engines = Spacecraft->GetComponentsByClass(UFlareEngine::StaticClass());
-
 	FVector DeltaPosition = (TargetLocation - Spacecraft->GetActorLocation()) / 100; // Distance in meters
 	FVector DeltaPositionDirection = DeltaPosition;
 	DeltaPositionDirection.Normalize();
@@ -1122,7 +1135,7 @@ bool UFlareSpacecraftNavigationSystem::UpdateLinearAttitudeAuto(float DeltaSecon
 	else
 	{
 
-		FVector Acceleration = GetTotalMaxThrustInAxis(Engines, DeltaVelocityAxis, false) / Spacecraft->GetSpacecraftMass();
+		FVector Acceleration = GetTotalMaxThrustInAxis(DeltaVelocityAxis, false) / Spacecraft->GetSpacecraftMass();
 		float AccelerationInAngleAxis =  FMath::Abs(FVector::DotProduct(Acceleration, DeltaPositionDirection));
 
 		// TODO: Fix security ratio engine flickering
@@ -1191,8 +1204,6 @@ bool UFlareSpacecraftNavigationSystem::UpdateAngularAttitudeAuto(FFlareShipComma
 {
 	SCOPE_CYCLE_COUNTER(STAT_NavigationSystem_UpdateAngularAttitudeAuto);
 
-	TArray<UActorComponent*> Engines = Spacecraft->GetComponentsByClass(UFlareEngine::StaticClass());
-
 	// Rotation data
 	FVector TargetAxis = Command.RotationTarget;
 	FVector LocalShipAxis = Command.LocalShipAxis;
@@ -1226,7 +1237,7 @@ bool UFlareSpacecraftNavigationSystem::UpdateAngularAttitudeAuto(FFlareShipComma
 	else {
 		FVector SimpleAcceleration = DeltaVelocityAxis * AngularAccelerationRate;
 		// Scale with damages
-		float DamageRatio = GetTotalMaxTorqueInAxis(Engines, DeltaVelocityAxis, true) / GetTotalMaxTorqueInAxis(Engines, DeltaVelocityAxis, false);
+		float DamageRatio = GetTotalMaxTorqueInAxis(DeltaVelocityAxis, true) / GetTotalMaxTorqueInAxis(DeltaVelocityAxis, false);
 		FVector DamagedSimpleAcceleration = SimpleAcceleration * DamageRatio;
 
 		FVector Acceleration = DamagedSimpleAcceleration;
@@ -1271,8 +1282,6 @@ FVector UFlareSpacecraftNavigationSystem::GetAngularVelocityToAlignAxis(FVector
 {
 	SCOPE_CYCLE_COUNTER(STAT_NavigationSystem_GetAngularVelocityToAlignAxis);
 
-	TArray<UActorComponent*> Engines = Spacecraft->GetComponentsByClass(UFlareEngine::StaticClass());
-
 	FVector AngularVelocity = Spacecraft->Airframe->GetPhysicsAngularVelocityInDegrees();
 	FVector WorldShipAxis = Spacecraft->Airframe->GetComponentToWorld().GetRotation().RotateVector(LocalShipAxis);
 
@@ -1297,7 +1306,7 @@ FVector UFlareSpacecraftNavigationSystem::GetAngularVelocityToAlignAxis(FVector
 	else {
 		FVector SimpleAcceleration = DeltaVelocityAxis * GetAngularAccelerationRate();
 		// Scale with damages
-		float DamageRatio = GetTotalMaxTorqueInAxis(Engines, DeltaVelocityAxis, true) / GetTotalMaxTorqueInAxis(Engines, DeltaVelocityAxis, false);
+		float DamageRatio = GetTotalMaxTorqueInAxis(DeltaVelocityAxis, true) / GetTotalMaxTorqueInAxis(DeltaVelocityAxis, false);
 		FVector DamagedSimpleAcceleration = SimpleAcceleration * DamageRatio;
 
 		FVector Acceleration = DamagedSimpleAcceleration;
@@ -1351,25 +1360,24 @@ void UFlareSpacecraftNavigationSystem::PhysicSubTick(float DeltaSeconds)
 {
 	SCOPE_CYCLE_COUNTER(STAT_NavigationSystem_Physics);
 
-	TArray<UActorComponent*> Engines = Spacecraft->GetComponentsByClass(UFlareEngine::StaticClass());
+	const FFlareEngineTable& Engines = GetEngineTable();
 
 	if(Spacecraft->GetParent()->GetDamageSystem()->IsUncontrollable())
 	{
 		// Shutdown engines
-		for (int32 EngineIndex = 0; EngineIndex < Engines.Num(); EngineIndex++)
+		for (UFlareEngine* Engine : Engines.Engines)
 		{
-			UFlareEngine* Engine = Cast<UFlareEngine>(Engines[EngineIndex]);
 			Engine->SetAlpha(0);
 		}
 
 		return;
 	}
 
-	TArray<float> EnginesAlpha;
+	TArray<float>& EnginesAlpha = EngineTable.Alphas;
 
-	for(int i = 0 ; i < Engines.Num() ; i++)
+	for (int32 EngineIndex = 0; EngineIndex < EnginesAlpha.Num(); EngineIndex++)
 	{
-		EnginesAlpha.Add(0.f);
+		EnginesAlpha[EngineIndex] = 0.f;
 	}
 
 	bool Log = false;
@@ -1404,7 +1412,7 @@ void UFlareSpacecraftNavigationSystem::PhysicSubTick(float DeltaSeconds)
 
 	float SharableBoostAcceleration = 0.f;
 
-	auto ProcessVelocityEngineAxis = [&](float VelocityTargetInAxis, FVector Axis, TPair<TArray<int>, TArray<int>> AxisEngines)
+	auto ProcessVelocityEngineAxis = [&](float VelocityTargetInAxis, FVector Axis, const TPair<TArray<int>, TArray<int>>& AxisEngines)
 	{
 		float LocalLinearVelocityInAxis = FVector::DotProduct(Axis, LocalLinearVelocity);
 		float DeltaV = VelocityTargetInAxis - LocalLinearVelocityInAxis;
@@ -1413,7 +1421,7 @@ void UFlareSpacecraftNavigationSystem::PhysicSubTick(float DeltaSeconds)
 		FLOGV("    - LocalLinearVelocityInAxis=%f", LocalLinearVelocityInAxis);
 		FLOGV("    - DeltaV=%f", DeltaV);*/
 
-		TArray<int>& UsefulEngines = DeltaV > 0 ? AxisEngines.Key: AxisEngines.Value;
+		const TArray<int>& UsefulEngines = DeltaV > 0 ? AxisEngines.Key: AxisEngines.Value;
 
 		//FLOGV("    - UsefulEngines=%d", UsefulEngines.Num());
 
@@ -1424,7 +1432,7 @@ void UFlareSpacecraftNavigationSystem::PhysicSubTick(float DeltaSeconds)
 		if (!FMath::IsNearlyZero(DeltaV))
 		{
 			// First, try without using the boost
-			float Acceleration = SharableBoostAcceleration + GetTotalMaxThrustWithEngines(Engines, UsefulEngines, false) / Spacecraft->GetSpacecraftMass();
+			float Acceleration = SharableBoostAcceleration + GetTotalMaxThrustWithEngines(UsefulEngines, false) / Spacecraft->GetSpacecraftMass();
 
 			//FLOGV("    - Acceleration=%f", Acceleration);
 
@@ -1436,7 +1444,7 @@ void UFlareSpacecraftNavigationSystem::PhysicSubTick(float DeltaSeconds)
 			// Second, if the not enought trust check with the boost
 			if (UseOrbitalBoost && AccelerationDeltaV < FMath::Abs(DeltaV) )
 			{
-				float AccelerationWithBoost = GetTotalMaxThrustWithEngines(Engines, UsefulEngines, true) / Spacecraft->GetSpacecraftMass();
+				float AccelerationWithBoost = GetTotalMaxThrustWithEngines(UsefulEngines, true) / Spacecraft->GetSpacecraftMass();
 
 				if (AccelerationWithBoost > Acceleration)
 				{
@@ -1461,10 +1469,7 @@ void UFlareSpacecraftNavigationSystem::PhysicSubTick(float DeltaSeconds)
 
 			for(int EngineIndex : UsefulEngines)
 			{
-				UFlareEngine* Engine = Cast<UFlareEngine>(Engines[EngineIndex]);
-
-
-				if (!Engine->IsA(UFlareOrbitalEngine::StaticClass()))
+				if (!Engines.OrbitalEngines[EngineIndex])
 				{
 					EnginesAlpha[EngineIndex] += LinearMasterAlpha;
 				}
@@ -1494,17 +1499,17 @@ void UFlareSpacecraftNavigationSystem::PhysicSubTick(float DeltaSeconds)
 		}
 	};
 
-	auto ProcessAccelerationEngineAxis = [&](float AccelerationTargetInAxis, FVector Axis, TPair<TArray<int>, TArray<int>> AxisEngines)
+	auto ProcessAccelerationEngineAxis = [&](float AccelerationTargetInAxis, FVector Axis, const TPair<TArray<int>, TArray<int>>& AxisEngines)
 	{
 		float ClampedAccelerationTargetInAxis = FMath::Clamp(AccelerationTargetInAxis, -1.f, 1.f);
 
-		TArray<int>& UsefulEngines = ClampedAccelerationTargetInAxis > 0 ? AxisEngines.Key: AxisEngines.Value;
+		const TArray<int>& UsefulEngines = ClampedAccelerationTargetInAxis > 0 ? AxisEngines.Key: AxisEngines.Value;
 
 		if (!FMath::IsNearlyZero(ClampedAccelerationTargetInAxis))
 		{
 			// First, try without using the boost
 			// TODO
-			float MaxAcceleration = SharableBoostAcceleration + GetTotalMaxThrustWithEngines(Engines, UsefulEngines, true) / Spacecraft->GetSpacecraftMass();
+			float MaxAcceleration = SharableBoostAcceleration + GetTotalMaxThrustWithEngines(UsefulEngines, true) / Spacecraft->GetSpacecraftMass();
 
 			if(Axis.X == 1.f)
 			{
@@ -1573,10 +1578,10 @@ void UFlareSpacecraftNavigationSystem::PhysicSubTick(float DeltaSeconds)
 		FVector SimpleAcceleration = DeltaAngularVAxis * AngularAccelerationRate;
 
 		// Scale with damages
-		float TotalMaxTorqueInAxis = GetTotalMaxTorqueInAxis(Engines, DeltaAngularVAxis, false);
+		float TotalMaxTorqueInAxis = GetTotalMaxTorqueInAxis(DeltaAngularVAxis, false);
 		if (!FMath::IsNearlyZero(TotalMaxTorqueInAxis))
 		{
-			float DamageRatio = GetTotalMaxTorqueInAxis(Engines, DeltaAngularVAxis, true) / TotalMaxTorqueInAxis;
+			float DamageRatio = GetTotalMaxTorqueInAxis(DeltaAngularVAxis, true) / TotalMaxTorqueInAxis;
 			FVector DamagedSimpleAcceleration = SimpleAcceleration * DamageRatio;
 			FVector ClampedSimplifiedAcceleration = DamagedSimpleAcceleration.GetClampedToMaxSize(DeltaAngularV.Size() / DeltaSeconds);
 
@@ -1585,10 +1590,9 @@ void UFlareSpacecraftNavigationSystem::PhysicSubTick(float DeltaSeconds)
 	}
 
 	// Update engine alpha
-	for (int32 EngineIndex = 0; EngineIndex < Engines.Num(); EngineIndex++)
+	for (int32 EngineIndex = 0; EngineIndex < Engines.Engines.Num(); EngineIndex++)
 	{
-		UFlareEngine* Engine = Cast<UFlareEngine>(Engines[EngineIndex]);
-		FVector ThrustAxis = Engine->GetThrustAxis();
+		UFlareEngine* Engine = Engines.Engines[EngineIndex];
 		float LinearAlpha = EnginesAlpha[EngineIndex];
 		float AngularAlpha = 0;
 
@@ -1596,13 +1600,9 @@ void UFlareSpacecraftNavigationSystem::PhysicSubTick(float DeltaSeconds)
 		{
 			LinearAlpha = true;
 		}
-		else if (!DeltaAngularV.IsNearlyZero() && !Engine->IsA(UFlareOrbitalEngine::StaticClass()))
+		else if (!DeltaAngularV.IsNearlyZero() && !Engines.OrbitalEngines[EngineIndex])
 		{
-				FVector EngineOffset = (Engine->GetComponentLocation() - COM) / 100;
-				FVector TorqueDirection = FVector::CrossProduct(EngineOffset, ThrustAxis);
-				TorqueDirection.Normalize();
-
-				AngularAlpha = -FVector::DotProduct(TorqueDirection, DeltaAngularVAxis);
+				AngularAlpha = -FVector::DotProduct(Engines.TorqueDirections[EngineIndex], DeltaAngularVAxis);
 		}
 
 		/*if(Log) {
@@ -1619,60 +1619,83 @@ void UFlareSpacecraftNavigationSystem::UpdateCOM()
 	COM = Spacecraft->Airframe->GetBodyInstance()->GetCOMPosition();
 }
 
+const FFlareEngineTable& UFlareSpacecraftNavigationSystem::GetEngineTable() const
+{
+	if (EngineTable.Dirty || EngineTable.Frame != GFrameCounter)
+	{
+		UpdateEngineTable();
+	}
+
+	return EngineTable;
+}
+
+void UFlareSpacecraftNavigationSystem::InvalidateEngineTable()
+{
+	EngineTable.Dirty = true;
+}
+
+void UFlareSpacecraftNavigationSystem::UpdateEngineTable() const
+{
+	SCOPE_CYCLE_COUNTER(STAT_NavigationSystem_UpdateEngineTable);
+
+	// Engines don't move on the ship, but the ship moves and thrust changes with damages and heat
+	FVector CurrentCOM = Spacecraft->Airframe->GetBodyInstance()->GetCOMPosition();
+	for (int32 EngineIndex = 0; EngineIndex < EngineTable.Engines.Num(); EngineIndex++)
+	{
+		UFlareEngine* Engine = EngineTable.Engines[EngineIndex];
+
+		FVector ThrustAxis = Engine->GetThrustAxis();
+		FVector EngineOffset = (Engine->GetComponentLocation() - CurrentCOM) / 100;
+		FVector Torque = FVector::CrossProduct(EngineOffset, ThrustAxis);
+
+		EngineTable.ThrustAxes[EngineIndex] = ThrustAxis;
+		EngineTable.TorqueDirections[EngineIndex] = Torque.GetSafeNormal();
+		EngineTable.TorqueArms[EngineIndex] = Torque.Size();
+		EngineTable.MaxThrusts[EngineIndex] = Engine->GetMaxThrust();
+		EngineTable.InitialMaxThrusts[EngineIndex] = Engine->GetInitialMaxThrust();
+	}
+
+	EngineTable.Frame = GFrameCounter;
+	EngineTable.Dirty = false;
+}
+
 
 /*----------------------------------------------------
 		Getters (Attitude)
 ----------------------------------------------------*/
 
-FVector UFlareSpacecraftNavigationSystem::GetTotalMaxThrustInAxis(TArray<UActorComponent*>& Engines, FVector Axis, bool WithOrbitalEngines) const
+FVector UFlareSpacecraftNavigationSystem::GetTotalMaxThrustInAxis(FVector Axis, bool WithOrbitalEngines) const
 {
 	SCOPE_CYCLE_COUNTER(STAT_NavigationSystem_GetTotalMaxThrustInAxis);
 
+	const FFlareEngineTable& Engines = GetEngineTable();
+
 	Axis.Normalize();
 	FVector TotalMaxThrust = FVector::ZeroVector;
-	for (int32 i = 0; i < Engines.Num(); i++)
+	for (int32 i = 0; i < Engines.Engines.Num(); i++)
 	{
-		UFlareEngine* Engine = Cast<UFlareEngine>(Engines[i]);
-
-		FVector WorldThrustAxis = Engine->GetThrustAxis();
+		FVector WorldThrustAxis = Engines.ThrustAxes[i];
 		float Ratio = FVector::DotProduct(WorldThrustAxis, Axis);
 
-		/*if (Engine->IsA(UFlareOrbitalEngine::StaticClass()))
+		if (Ratio > 0)
 		{
-			if(WithOrbitalEngines && Ratio + 0.2 > 0)
-			{
-				TotalMaxThrust += WorldThrustAxis * Engine->GetMaxThrust() * (Ratio + 0.2);
-			}
+			TotalMaxThrust += WorldThrustAxis * Engines.MaxThrusts[i] * Ratio;
 		}
-		else
-		{*/
-			if (Ratio > 0)
-			{
-				TotalMaxThrust += WorldThrustAxis * Engine->GetMaxThrust() * Ratio;
-			}
-		/*}*/
 	}
 
 	return TotalMaxThrust;
 }
 
-float UFlareSpacecraftNavigationSystem::GetTotalMaxThrustWithEngines(TArray<UActorComponent*>& Engines, TArray<int>& UsefulEngines, bool WithOrbitalEngines)
+float UFlareSpacecraftNavigationSystem::GetTotalMaxThrustWithEngines(const TArray<int>& UsefulEngines, bool WithOrbitalEngines) const
 {
+	const FFlareEngineTable& Engines = GetEngineTable();
+
 	float TotalMaxThrust = 0.f;
 	for (int i : UsefulEngines)
 	{
-		UFlareEngine* Engine = Cast<UFlareEngine>(Engines[i]);
-
-		if (Engine->IsA(UFlareOrbitalEngine::StaticClass()))
-		{
-			if(WithOrbitalEngines)
-			{
-				TotalMaxThrust += Engine->GetMaxThrust();
-			}
-		}
-		else
+		if (WithOrbitalEngines || !Engines.OrbitalEngines[i])
 		{
-			TotalMaxThrust += Engine->GetMaxThrust();
+			TotalMaxThrust += Engines.MaxThrusts[i];
 		}
 	}
 
@@ -1680,23 +1703,24 @@ float UFlareSpacecraftNavigationSystem::GetTotalMaxThrustWithEngines(TArray<UAct
 }
 
 
-float UFlareSpacecraftNavigationSystem::GetTotalMaxTorqueInAxis(TArray<UActorComponent*>& Engines, FVector TorqueAxis, bool WithDamages) const
+float UFlareSpacecraftNavigationSystem::GetTotalMaxTorqueInAxis(FVector TorqueAxis, bool WithDamages) const
 {
 	SCOPE_CYCLE_COUNTER(STAT_NavigationSystem_GetTotalMaxTorqueInAxis);
 
+	const FFlareEngineTable& Engines = GetEngineTable();
+
 	TorqueAxis.Normalize();
 	float TotalMaxTorque = 0;
 
-	for (int32 i = 0; i < Engines.Num(); i++) {
-		UFlareEngine* Engine = Cast<UFlareEngine>(Engines[i]);
-
+	for (int32 i = 0; i < Engines.Engines.Num(); i++)
+	{
 		// Ignore orbital engines for torque computation
-		if (Engine->IsA(UFlareOrbitalEngine::StaticClass()))
+		if (Engines.OrbitalEngines[i])
 		{
 		  continue;
 		}
 
-		float MaxThrust = (WithDamages ? Engine->GetMaxThrust() : Engine->GetInitialMaxThrust());
+		float MaxThrust = (WithDamages ? Engines.MaxThrusts[i] : Engines.InitialMaxThrusts[i]);
 
 		if (MaxThrust == 0)
 		{
@@ -1704,18 +1728,11 @@ float UFlareSpacecraftNavigationSystem::GetTotalMaxTorqueInAxis(TArray<UActorCom
 			continue;
 		}
 
-		FVector EngineOffset = (Engine->GetComponentLocation() - COM) / 100;
-
-		FVector WorldThrustAxis = Engine->GetThrustAxis();
-		WorldThrustAxis.Normalize();
-		FVector TorqueDirection = FVector::CrossProduct(EngineOffset, WorldThrustAxis);
-		TorqueDirection.Normalize();
-
-		float Ratio = FVector::DotProduct(TorqueAxis, TorqueDirection);
+		float Ratio = FVector::DotProduct(TorqueAxis, Engines.TorqueDirections[i]);
 
 		if (Ratio > 0)
 		{
-			TotalMaxTorque += FVector::CrossProduct(EngineOffset, WorldThrustAxis).Size() * MaxThrust * Ratio;
+			TotalMaxTorque += Engines.TorqueArms[i] * MaxThrust * Ratio;
 		}
 
 	}
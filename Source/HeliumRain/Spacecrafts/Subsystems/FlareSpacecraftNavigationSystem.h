@@ -4,6 +4,7 @@
 #include "FlareSpacecraftNavigationSystem.generated.h"
 
 class AFlareSpacecraft;
+class UFlareEngine;
 
 class UPhysicsConstraintComponent;
 
@@ -115,6 +116,27 @@ struct FFlareDockingParameters
 	FVector ShipDockSelfRotationInductedLinearVelocity;
 };
 
+/** Engines of a ship, with the values the attitude control reads on every tick */
+struct FFlareEngineTable
+{
+	/** Engines, in the component order of the ship */
+	TArray<UFlareEngine*>                    Engines;
+	TArray<bool>                             OrbitalEngines;
+	TArray<float>                            InitialMaxThrusts;
+
+	// World space values, refreshed once per frame
+	TArray<FVector>                          ThrustAxes;
+	TArray<FVector>                          TorqueDirections;
+	TArray<float>                            TorqueArms;
+	TArray<float>                            MaxThrusts;
+
+	/** Engine alpha, accumulated during a physics tick */
+	TArray<float>                            Alphas;
+
+	uint64                                   Frame;
+	bool                                     Dirty;
+};
+
 /** Spacecraft navigation system class */
 UCLASS()
 class HELIUMRAIN_API UFlareSpacecraftNavigationSystem : public UObject
@@ -256,8 +278,17 @@ public:
 	/** Update the ship's center of mass */
 	void UpdateCOM();
 
+	/** Get the engine table, refreshed on the first call of each frame */
+	const FFlareEngineTable& GetEngineTable() const;
+
+	/** Force the engine table to be refreshed on the next call, after damage */
+	void InvalidateEngineTable();
+
 protected:
 
+	/** Refresh the world space values of the engine table */
+	void UpdateEngineTable() const;
+
 
 	/*----------------------------------------------------
 		Protected data
@@ -300,6 +331,8 @@ protected:
 	TPair<TArray<int>, TArray<int>> YEngines;
 	TPair<TArray<int>, TArray<int>> ZEngines;
 
+	mutable FFlareEngineTable                EngineTable;
+
 public:
 
 	/*----------------------------------------------------
@@ -308,28 +341,25 @@ public:
 
 	/**
 	 * Return the maximum current (with damages) trust the ship can provide in a specific axis.
-	 * Engines : List of engine to use to compute the max thrust
 	 * Axis : Axis of the thurst
 	 * WithObitalEngines : if false, ignore orbitals engines
 	 */
-	FVector GetTotalMaxThrustInAxis(TArray<UActorComponent*>& Engines, FVector Axis, bool WithOrbitalEngines) const;
+	FVector GetTotalMaxThrustInAxis(FVector Axis, bool WithOrbitalEngines) const;
 
 
 	/**
 	 * Return the maximum current (with damages) trust the ship can provide with specifics engines.
-	 * Engines : List of engine to use to compute the max thrust
-	 * UsefulEngines : engine to sum
+	 * UsefulEngines : engine to sum, as indices in the engine table
 	 * WithObitalEngines : if false, ignore orbitals engines
 	 */
-	float GetTotalMaxThrustWithEngines(TArray<UActorComponent*>& Engines, TArray<int>& UsefulEngines, bool WithOrbitalEngines);
+	float GetTotalMaxThrustWithEngines(const TArray<int>& UsefulEngines, bool WithOrbitalEngines) const;
 
 	/**
 	 * Return the maximum torque the ship can provide in a specific axis.
-	 * Engines : List of engine to use to compute the max thrust
 	 * TorqueDirection : Axis of the torque
 	 * WithDamages : if true, use current thrust value and not theorical thrust value
 	 */
-	float GetTotalMaxTorqueInAxis(TArray<UActorComponent*>& Engines, FVector TorqueDirection, bool WithDamages) const;
+	float GetTotalMaxTorqueInAxis(FVector TorqueDirection, bool WithDamages) const;
 
 
 	/*----------------------------------------------------
@@ -28,7 +28,9 @@ void SFlareOrbitalMenu::Construct(const FArguments& InArgs)
 
 	// FF setup
 	FastForwardPeriod = 0.5f;
+	FastForwardBatchPeriod = 0.1f;
 	FastForwardStopRequested = false;
+	FastForwardDayCount = 0;
 
 	// Build structure
 	ChildSlot
@@ -288,6 +290,7 @@ void SFlareOrbitalMenu::Enter()
 
 	// Update stuff
 	StopFastForward();
+	Game->GetGameWorld()->InvalidateIncomingEvents();
 	UpdateMap();
 	TradeRouteInfo->Update();
 
@@ -340,13 +343,14 @@ void SFlareOrbitalMenu::Tick(const FGeometry& AllottedGeometry, const double InC
 			MenuManager->GetPC()->CheckSectorStateChanges(Sector);
 		}
 
-		// Fast forward every FastForwardPeriod
+		// Fast forward every FastForwardPeriod, or batch after batch
 		TimeSinceFastForward += InDeltaTime;
 		if (FastForwardActive)
 		{
-			if (!FastForwardStopRequested && (TimeSinceFastForward > FastForwardPeriod || UFlareGameTools::FastFastForward))
+			bool Batched = UFlareGameTools::FastForwardBatchDays > 1;
+			if (!FastForwardStopRequested && (TimeSinceFastForward > FastForwardPeriod || UFlareGameTools::FastFastForward || Batched))
 			{
-				MenuManager->GetGame()->GetGameWorld()->FastForward();
+				FastForwardBatch();
 				TimeSinceFastForward = 0;
 			}
 
@@ -359,6 +363,33 @@ void SFlareOrbitalMenu::Tick(const FGeometry& AllottedGeometry, const double InC
 	}
 }
 
+void SFlareOrbitalMenu::FastForwardBatch()
+{
+	UFlareWorld* GameWorld = MenuManager->GetGame()->GetGameWorld();
+	double StartTime = FPlatformTime::Seconds();
+
+	// Notifications of the batch are shown once it is over, the first one still stops it
+	MenuManager->BeginNotificationBatch();
+	for (int32 Day = 0; Day < UFlareGameTools::FastForwardBatchDays; Day++)
+	{
+		GameWorld->FastForward();
+		FastForwardDayCount++;
+
+		// Raise the battle and danger notifications of this day, they stop the batch
+		for (UFlareSimulatedSector* Sector : MenuManager->GetPC()->GetCompany()->GetKnownSectors())
+		{
+			MenuManager->GetPC()->CheckSectorStateChanges(Sector);
+		}
+
+		// Keep the menu responsive, the next batch runs on the next frame
+		if (!FastForwardActive || FastForwardStopRequested || FPlatformTime::Seconds() - StartTime > FastForwardBatchPeriod)
+		{
+			break;
+		}
+	}
+	MenuManager->EndNotificationBatch();
+}
+
 void SFlareOrbitalMenu::UpdateMap()
 {
 	TArray<FFlareSectorCelestialBodyDescription>& OrbitalBodies = Game->GetOrbitalBodies()->OrbitalBodies;
@@ -518,6 +549,11 @@ FText SFlareOrbitalMenu::GetFastForwardText() const
 	}
 	else
 	{
+		if (UFlareGameTools::FastForwardBatchDays > 1)
+		{
+			return FText::Format(LOCTEXT("FastForwardingDaysFormat", "Fast forwarding... ({0})"), UFlareGameTools::FormatDate(FastForwardDayCount, 1));
+		}
+
 		return LOCTEXT("FastForwardingText", "Fast forwarding...");
 	}
 }
@@ -574,20 +610,8 @@ FText SFlareOrbitalMenu::GetTravelText() const
 		UFlareWorld* GameWorld = MenuManager->GetGame()->GetGameWorld();
 		if (GameWorld)
 		{
-			TArray<FFlareIncomingEvent> IncomingEvents = GameWorld->GetIncomingEvents();
-
-			// Generate list
-			FString Result;
-			for (FFlareIncomingEvent& Event : IncomingEvents)
-			{
-				Result += Event.Text.ToString() + "\n";
-			}
-			if (Result.Len() == 0)
-			{
-				Result = LOCTEXT("NoTravel", "No event.").ToString();
-			}
-
-			return FText::FromString(Result);
+			const FText& IncomingEventsText = GameWorld->GetIncomingEventsText();
+			return IncomingEventsText.IsEmpty() ? LOCTEXT("NoTravel", "No event.") : IncomingEventsText;
 		}
 	}
 
@@ -667,6 +691,7 @@ void SFlareOrbitalMenu::OnFastForwardConfirmed(bool Automatic)
 		// Mark FF
 		FastForwardActive = true;
 		FastForwardStopRequested = false;
+		FastForwardDayCount = 0;
 
 		// Prepare for FF
 		Game->SaveGame(MenuManager->GetPC(), true);
@@ -58,6 +58,9 @@ public:
 	/** A notification was received, stop */
 	void RequestStopFastForward();
 
+	/** Simulate a batch of days, until a notification, the batch size or the period is reached */
+	void FastForwardBatch();
+
 	/** Get the display mode */
 	EFlareOrbitalMode::Type GetDisplayMode() const;
 
@@ -143,7 +146,9 @@ protected:
 	bool                                        FastForwardActive;
 	bool                                        FastForwardStopRequested;
 	float                                       FastForwardPeriod;
+	float                                       FastForwardBatchPeriod;
 	float                                       TimeSinceFastForward;
+	int32                                       FastForwardDayCount;
 
 	TEnumAsByte<EFlareOrbitalMode::Type>        DisplayMode;
 
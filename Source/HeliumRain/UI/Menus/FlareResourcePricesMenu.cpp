@@ -334,7 +334,7 @@ void SFlareResourcePricesMenu::GenerateResourceList()
 		bool Result = false;
 
 		// Get sorting data
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(this->TargetSector, IncludeTradingHubsButton->IsActive());
+		const TArray<WorldHelper::FlareResourceStats>& Stats = this->TargetSector->GetResourceStats(IncludeTradingHubsButton->IsActive());
 		int64 ResourcePrice1 = this->TargetSector->GetResourcePrice(&R1.Data, EFlareResourcePriceContext::Default);
 		int64 ResourcePrice2 = this->TargetSector->GetResourcePrice(&R2.Data, EFlareResourcePriceContext::Default);
 		int64 LastResourcePrice1 = this->TargetSector->GetResourcePrice(&R1.Data, EFlareResourcePriceContext::Default, 30);
@@ -349,16 +349,16 @@ void SFlareResourcePricesMenu::GenerateResourceList()
 			Result = R1.Data.DisplayIndex > R2.Data.DisplayIndex;
 			break;
 		case EFlareEconomySort::ES_Production:
-			Result = (Stats[&R1.Data].Production > Stats[&R2.Data].Production);
+			Result = (Stats[R1.Data.Index].Production > Stats[R2.Data.Index].Production);
 			break;
 		case EFlareEconomySort::ES_Consumption:
-			Result = (Stats[&R1.Data].Consumption > Stats[&R2.Data].Consumption);
+			Result = (Stats[R1.Data.Index].Consumption > Stats[R2.Data.Index].Consumption);
 			break;
 		case EFlareEconomySort::ES_Stock:
-			Result = (Stats[&R1.Data].Stock > Stats[&R2.Data].Stock);
+			Result = (Stats[R1.Data.Index].Stock > Stats[R2.Data.Index].Stock);
 			break;
 		case EFlareEconomySort::ES_Needs:
-			Result = (Stats[&R1.Data].Capacity > Stats[&R2.Data].Capacity);
+			Result = (Stats[R1.Data.Index].Capacity > Stats[R2.Data.Index].Capacity);
 			break;
 		case EFlareEconomySort::ES_Price:
 			Result = ResourcePrice1 > ResourcePrice2;
@@ -637,9 +637,9 @@ FText SFlareResourcePricesMenu::GetResourceProductionInfo(FFlareResourceDescript
 		FNumberFormattingOptions Format;
 		Format.MaximumFractionalDigits = 1;
 
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(TargetSector, IncludeTradingHubsButton->IsActive());
+		const TArray<WorldHelper::FlareResourceStats>& Stats = TargetSector->GetResourceStats(IncludeTradingHubsButton->IsActive());
 		return FText::Format(LOCTEXT("ResourceMainProductionFormat", "{0}"),
-			FText::AsNumber(Stats[Resource].Production, &Format));
+			FText::AsNumber(Stats[Resource->Index].Production, &Format));
 	}
 
 	return FText();
@@ -652,9 +652,9 @@ FText SFlareResourcePricesMenu::GetResourceConsumptionInfo(FFlareResourceDescrip
 		FNumberFormattingOptions Format;
 		Format.MaximumFractionalDigits = 1;
 
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(TargetSector, IncludeTradingHubsButton->IsActive());
+		const TArray<WorldHelper::FlareResourceStats>& Stats = TargetSector->GetResourceStats(IncludeTradingHubsButton->IsActive());
 		return FText::Format(LOCTEXT("ResourceMainConsumptionFormat", "{0}"),
-			FText::AsNumber(Stats[Resource].Consumption, &Format));
+			FText::AsNumber(Stats[Resource->Index].Consumption, &Format));
 	}
 
 	return FText();
@@ -664,9 +664,9 @@ FText SFlareResourcePricesMenu::GetResourceStockInfo(FFlareResourceDescription*
 {
 	if (TargetSector)
 	{
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(TargetSector, IncludeTradingHubsButton->IsActive());
+		const TArray<WorldHelper::FlareResourceStats>& Stats = TargetSector->GetResourceStats(IncludeTradingHubsButton->IsActive());
 		return FText::Format(LOCTEXT("ResourceMainStockFormat", "{0}"),
-			FText::AsNumber(Stats[Resource].Stock));
+			FText::AsNumber(Stats[Resource->Index].Stock));
 	}
 
 	return FText();
@@ -678,9 +678,9 @@ FText SFlareResourcePricesMenu::GetResourceCapacityInfo(FFlareResourceDescriptio
 	if (TargetSector)
 	{
 
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(TargetSector, IncludeTradingHubsButton->IsActive());
+		const TArray<WorldHelper::FlareResourceStats>& Stats = TargetSector->GetResourceStats(IncludeTradingHubsButton->IsActive());
 		return FText::Format(LOCTEXT("ResourceMainCapacityFormat", "{0}"),
-			FText::AsNumber(Stats[Resource].Capacity));
+			FText::AsNumber(Stats[Resource->Index].Capacity));
 	}
 
 	return FText();
@@ -1103,7 +1103,7 @@ FText SFlareSectorMenu::GetSectorLocation() const
 
 	if (IsEnabled() && TargetSector)
 	{
-		FFlareCelestialBody* Body = TargetSector->GetGame()->GetGameWorld()->GetPlanerarium()->FindCelestialBody(TargetSector->GetOrbitParameters()->CelestialBodyIdentifier);
+		FFlareCelestialBody* Body = TargetSector->GetGame()->GetGameWorld()->GetPlanerarium()->FindOrbitCelestialBody(TargetSector->GetOrbitParameters());
 
 		if (Body)
 		{
@@ -1259,7 +1259,7 @@ TSharedRef<SWidget> SFlareTradeRouteMenu::OnGenerateSectorComboLine(UFlareSimula
 	// Common resources
 	const FFlareStyleCatalog& Theme = FFlareStyleSet::GetDefaultTheme();
 	UFlareSimulatedPlanetarium* Planetarium = MenuManager->GetGame()->GetGameWorld()->GetPlanerarium();
-	FFlareCelestialBody* CelestialBody = Planetarium->FindCelestialBody(TargetSector->GetOrbitParameters()->CelestialBodyIdentifier);
+	FFlareCelestialBody* CelestialBody = Planetarium->FindOrbitCelestialBody(TargetSector->GetOrbitParameters());
 
 	// Count spacecraft
 	FText ShipText, StationText;
@@ -348,7 +348,7 @@ void SFlareWorldEconomyMenu::Enter(FFlareResourceDescription* Resource, UFlareSi
 	{
 		TargetResource = Resource;
 	}
-	WorldStats = WorldHelper::ComputeWorldResourceStats(MenuManager->GetGame(), IncludeTradingHubsButton->IsActive());
+	WorldStats = MenuManager->GetGame()->GetGameWorld()->GetResourceStats(IncludeTradingHubsButton->IsActive());
 
 	// Default state
 	IsCurrentSortDescending = false;
@@ -387,8 +387,8 @@ void SFlareWorldEconomyMenu::GenerateSectorList()
 		bool Result = false;
 
 		// Get sorting data
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats1 = SectorHelper::ComputeSectorResourceStats(&S1, IncludeTradingHubsButton->IsActive());
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats2 = SectorHelper::ComputeSectorResourceStats(&S2, IncludeTradingHubsButton->IsActive());
+		const TArray<WorldHelper::FlareResourceStats>& Stats1 = S1.GetResourceStats(IncludeTradingHubsButton->IsActive());
+		const TArray<WorldHelper::FlareResourceStats>& Stats2 = S2.GetResourceStats(IncludeTradingHubsButton->IsActive());
 		int64 ResourcePrice1 = S1.GetResourcePrice(TargetResource, EFlareResourcePriceContext::Default);
 		int64 ResourcePrice2 = S2.GetResourcePrice(TargetResource, EFlareResourcePriceContext::Default);
 		int64 LastResourcePrice1 = S1.GetResourcePrice(TargetResource, EFlareResourcePriceContext::Default, 30);
@@ -403,16 +403,16 @@ void SFlareWorldEconomyMenu::GenerateSectorList()
 			Result = S1.GetSectorName().ToString() > S2.GetSectorName().ToString();
 			break;
 		case EFlareEconomySort::ES_Production:
-			Result = (Stats1[this->TargetResource].Production > Stats2[this->TargetResource].Production);
+			Result = (Stats1[this->TargetResource->Index].Production > Stats2[this->TargetResource->Index].Production);
 			break;
 		case EFlareEconomySort::ES_Consumption:
-			Result = (Stats1[this->TargetResource].Consumption > Stats2[this->TargetResource].Consumption);
+			Result = (Stats1[this->TargetResource->Index].Consumption > Stats2[this->TargetResource->Index].Consumption);
 			break;
 		case EFlareEconomySort::ES_Stock:
-			Result = (Stats1[this->TargetResource].Stock > Stats2[this->TargetResource].Stock);
+			Result = (Stats1[this->TargetResource->Index].Stock > Stats2[this->TargetResource->Index].Stock);
 			break;
 		case EFlareEconomySort::ES_Needs:
-			Result = (Stats1[this->TargetResource].Capacity > Stats2[this->TargetResource].Capacity);
+			Result = (Stats1[this->TargetResource->Index].Capacity > Stats2[this->TargetResource->Index].Capacity);
 			break;
 		case EFlareEconomySort::ES_Price:
 			Result = ResourcePrice1 > ResourcePrice2;
@@ -686,14 +686,14 @@ FText SFlareWorldEconomyMenu::GetResourceInfo() const
 {
 	if (TargetResource)
 	{
-		if (WorldStats.Contains(TargetResource))
+		if (WorldStats.IsValidIndex(TargetResource->Index))
 		{
 			FNumberFormattingOptions Format;
 			Format.MaximumFractionalDigits = 1;
 
 			// Balance info
 			FText BalanceText;
-			float Balance = WorldStats[TargetResource].Balance;
+			float Balance = WorldStats[TargetResource->Index].Balance;
 			if (Balance > 0)
 			{
 				BalanceText = FText::Format(LOCTEXT("BalanceInfoPlusFormat", "+{0} / day"),
@@ -708,11 +708,11 @@ FText SFlareWorldEconomyMenu::GetResourceInfo() const
 
 			FText Part1 = FText::Format(LOCTEXT("StockInfoFormatPart1", "\u2022Transport fee: {0} credits\n\u2022 Worldwide stock: {1}\n\u2022 Worldwide needs: {2}\n"),
 										UFlareGameTools::DisplayMoney(TargetResource->TransportFee),
-										FText::AsNumber(WorldStats[TargetResource].Stock),
-										FText::AsNumber(WorldStats[TargetResource].Capacity));
+										FText::AsNumber(WorldStats[TargetResource->Index].Stock),
+										FText::AsNumber(WorldStats[TargetResource->Index].Capacity));
 			FText Part2 = FText::Format(LOCTEXT("StockInfoFormatPart2", "\u2022 Worldwide production: {0} / day\n\u2022 Worldwide usage: {1} / day\n"),
-										FText::AsNumber(WorldStats[TargetResource].Production, &Format),
-										FText::AsNumber(WorldStats[TargetResource].Consumption, &Format));
+										FText::AsNumber(WorldStats[TargetResource->Index].Production, &Format),
+										FText::AsNumber(WorldStats[TargetResource->Index].Consumption, &Format));
 
 			// Generate info
 			return FText::Format(LOCTEXT("StockInfoFormat",
@@ -745,9 +745,9 @@ FText SFlareWorldEconomyMenu::GetResourceProductionInfo(UFlareSimulatedSector* S
 		FNumberFormattingOptions Format;
 		Format.MaximumFractionalDigits = 1;
 
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(Sector, IncludeTradingHubsButton->IsActive());
+		const TArray<WorldHelper::FlareResourceStats>& Stats = Sector->GetResourceStats(IncludeTradingHubsButton->IsActive());
 		return FText::Format(LOCTEXT("ResourceMainProductionFormat", "{0}"),
-			FText::AsNumber(Stats[TargetResource].Production, &Format));
+			FText::AsNumber(Stats[TargetResource->Index].Production, &Format));
 	}
 
 	return FText();
@@ -760,9 +760,9 @@ FText SFlareWorldEconomyMenu::GetResourceConsumptionInfo(UFlareSimulatedSector*
 		FNumberFormattingOptions Format;
 		Format.MaximumFractionalDigits = 1;
 
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(Sector, IncludeTradingHubsButton->IsActive());
+		const TArray<WorldHelper::FlareResourceStats>& Stats = Sector->GetResourceStats(IncludeTradingHubsButton->IsActive());
 		return FText::Format(LOCTEXT("ResourceMainConsumptionFormat", "{0}"),
-			FText::AsNumber(Stats[TargetResource].Consumption, &Format));
+			FText::AsNumber(Stats[TargetResource->Index].Consumption, &Format));
 	}
 
 	return FText();
@@ -772,9 +772,9 @@ FText SFlareWorldEconomyMenu::GetResourceStockInfo(UFlareSimulatedSector* Sector
 {
 	if (TargetResource)
 	{
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(Sector, IncludeTradingHubsButton->IsActive());
+		const TArray<WorldHelper::FlareResourceStats>& Stats = Sector->GetResourceStats(IncludeTradingHubsButton->IsActive());
 		return FText::Format(LOCTEXT("ResourceMainStockFormat", "{0}"),
-			FText::AsNumber(Stats[TargetResource].Stock));
+			FText::AsNumber(Stats[TargetResource->Index].Stock));
 	}
 
 	return FText();
@@ -786,9 +786,9 @@ FText SFlareWorldEconomyMenu::GetResourceCapacityInfo(UFlareSimulatedSector* Sec
 	if (TargetResource)
 	{
 
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(Sector, IncludeTradingHubsButton->IsActive());
+		const TArray<WorldHelper::FlareResourceStats>& Stats = Sector->GetResourceStats(IncludeTradingHubsButton->IsActive());
 		return FText::Format(LOCTEXT("ResourceMainCapacityFormat", "{0}"),
-			FText::AsNumber(Stats[TargetResource].Capacity));
+			FText::AsNumber(Stats[TargetResource->Index].Capacity));
 	}
 
 	return FText();
@@ -904,7 +904,7 @@ void SFlareWorldEconomyMenu::OnOpenSectorPrices(UFlareSimulatedSector* Sector)
 void SFlareWorldEconomyMenu::OnIncludeTradingHubsToggle()
 {
 	GenerateSectorList();
-	WorldStats = WorldHelper::ComputeWorldResourceStats(MenuManager->GetGame(), IncludeTradingHubsButton->IsActive());
+	WorldStats = MenuManager->GetGame()->GetGameWorld()->GetResourceStats(IncludeTradingHubsButton->IsActive());
 }
 
 #undef LOCTEXT_NAMESPACE